@@ -0,0 +1,66 @@
+"""Measures the time to import nanoeigenpy and to register its bindings.
+
+Each measurement runs in a new interpreter. The bindings are registered on
+first use, or all on import with NANOEIGENPY_LAZY_BINDINGS=0.
+
+    python benchmarks/import_time.py [--repeat N]
+"""
+
+import argparse
+import os
+import statistics
+import subprocess
+import sys
+
+CASES = {
+    "import": "import nanoeigenpy",
+    "import + Quaternion": "import nanoeigenpy; nanoeigenpy.Quaternion",
+    "import + LLT": "import nanoeigenpy; nanoeigenpy.LLT",
+    "import + SparseLU": "import nanoeigenpy; nanoeigenpy.SparseLU",
+    "import + all": (
+        "import nanoeigenpy\n"
+        "for m in [nanoeigenpy, nanoeigenpy.solvers]:\n"
+        "    [getattr(m, name) for name in dir(m)]"
+    ),
+}
+
+TIMER = """
+import time
+start = time.perf_counter()
+{code}
+print(time.perf_counter() - start)
+"""
+
+
+def measure(code, repeat, lazy):
+    env = {**os.environ, "NANOEIGENPY_LAZY_BINDINGS": "1" if lazy else "0"}
+    times = []
+    for _ in range(repeat):
+        output = subprocess.run(
+            [sys.executable, "-c", TIMER.format(code=code)],
+            check=True,
+            capture_output=True,
+            text=True,
+            env=env,
+        ).stdout
+        times.append(float(output))
+    return statistics.median(times)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--repeat", type=int, default=20)
+    args = parser.parse_args()
+
+    # Warm up the file system cache
+    measure(CASES["import"], 2, True)
+
+    print(f"{'case':<24}{'lazy (ms)':>12}{'eager (ms)':>12}")
+    for name, code in CASES.items():
+        lazy = measure(code, args.repeat, True)
+        eager = measure(code, args.repeat, False)
+        print(f"{name:<24}{1e3 * lazy:>12.2f}{1e3 * eager:>12.2f}")
+
+
+if __name__ == "__main__":
+    main()
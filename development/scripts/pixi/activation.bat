@@ -2,3 +2,7 @@
 if not defined NANOEIGENPY_BUILD_TYPE (set NANOEIGENPY_BUILD_TYPE=Release)
 if not defined NANOEIGENPY_CHOLMOD_SUPPORT (set NANOEIGENPY_CHOLMOD_SUPPORT=OFF)
 if not defined NANOEIGENPY_ACCELERATE_SUPPORT (set NANOEIGENPY_ACCELERATE_SUPPORT=OFF)
+if not defined NANOEIGENPY_BLAS_LAPACK_SUPPORT (set NANOEIGENPY_BLAS_LAPACK_SUPPORT=OFF)
+if not defined NANOEIGENPY_WORKSPACES (set NANOEIGENPY_WORKSPACES=OFF)
+if not defined NANOEIGENPY_ALLOCATION_TRACKING (set NANOEIGENPY_ALLOCATION_TRACKING=OFF)
+if not defined NANOEIGENPY_PERFORMANCE_TESTS (set NANOEIGENPY_PERFORMANCE_TESTS=OFF)
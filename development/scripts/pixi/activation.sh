@@ -31,3 +31,7 @@ export NANOEIGENPY_CXX_FLAGS="$CXXFLAGS $NANOEIGENPY_CXX_FLAGS -isystem $CONDA_P
 export NANOEIGENPY_BUILD_TYPE=${NANOEIGENPY_BUILD_TYPE:=Release}
 export NANOEIGENPY_CHOLMOD_SUPPORT=${NANOEIGENPY_CHOLMOD_SUPPORT:=OFF}
 export NANOEIGENPY_ACCELERATE_SUPPORT=${NANOEIGENPY_ACCELERATE_SUPPORT:=OFF}
+export NANOEIGENPY_BLAS_LAPACK_SUPPORT=${NANOEIGENPY_BLAS_LAPACK_SUPPORT:=OFF}
+export NANOEIGENPY_WORKSPACES=${NANOEIGENPY_WORKSPACES:=OFF}
+export NANOEIGENPY_ALLOCATION_TRACKING=${NANOEIGENPY_ALLOCATION_TRACKING:=OFF}
+export NANOEIGENPY_PERFORMANCE_TESTS=${NANOEIGENPY_PERFORMANCE_TESTS:=OFF}
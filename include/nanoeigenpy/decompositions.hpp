@@ -21,13 +21,20 @@
 #include "nanoeigenpy/decompositions/permutation-matrix.hpp"
 #include "nanoeigenpy/decompositions/full-piv-lu.hpp"
 #include "nanoeigenpy/decompositions/partial-piv-lu.hpp"
+#include "nanoeigenpy/decompositions/mixed-precision.hpp"
 #include "nanoeigenpy/decompositions/bdcsvd.hpp"
 #include "nanoeigenpy/decompositions/jacobi-svd.hpp"
+#include "nanoeigenpy/decompositions/randomized-svd.hpp"
 
+#include "nanoeigenpy/decompositions/sparse/orderings.hpp"
+#include "nanoeigenpy/decompositions/sparse/symbolic-cholesky.hpp"
 #include "nanoeigenpy/decompositions/sparse/simplicial-llt.hpp"
 #include "nanoeigenpy/decompositions/sparse/simplicial-ldlt.hpp"
+#include "nanoeigenpy/decompositions/sparse/supernodal-llt.hpp"
+#include "nanoeigenpy/decompositions/sparse/cholesky-factor-store.hpp"
 #include "nanoeigenpy/decompositions/sparse/sparse-lu.hpp"
 #include "nanoeigenpy/decompositions/sparse/sparse-qr.hpp"
+#include "nanoeigenpy/decompositions/sparse/lanczos-eigen-solver.hpp"
 
 #ifdef NANOEIGENPY_HAS_CHOLMOD
 #include "nanoeigenpy/decompositions/sparse/cholmod/cholmod-simplicial-llt.hpp"
@@ -3,6 +3,10 @@
 #pragma once
 
 #include "nanoeigenpy/fwd.hpp"
+#include "nanoeigenpy/decompositions/dense-solver-base.hpp"
+#include "nanoeigenpy/utils/async.hpp"
+#include "nanoeigenpy/utils/workspace.hpp"
+#include "nanoeigenpy/utils/object-lock.hpp"
 #include "nanoeigenpy/decompositions/svd-base.hpp"
 #include <Eigen/SVD>
 
@@ -10,18 +14,10 @@ namespace nanoeigenpy {
 namespace nb = nanobind;
 using namespace nb::literals;
 
-template <typename MatrixType, typename MatrixOrVector>
-MatrixOrVector solve(const Eigen::BDCSVD<MatrixType> &c,
-                     const MatrixOrVector &vec) {
-  return c.solve(vec);
-}
-
 template <typename _MatrixType>
 void exposeBDCSVD(nb::module_ m, const char *name) {
   using MatrixType = _MatrixType;
   using Solver = Eigen::BDCSVD<MatrixType>;
-  using Scalar = typename MatrixType::Scalar;
-  using VectorType = Eigen::Matrix<Scalar, -1, 1>;
 
   if (check_registration_alias<Solver>(m)) {
     return;
@@ -49,39 +45,22 @@ void exposeBDCSVD(nb::module_ m, const char *name) {
 
       .def(SVDBaseVisitor())
 
-      .def(
-          "compute",
-          [](Solver &c, const MatrixType &matrix) -> Solver & {
-            return c.compute(matrix);
-          },
-          "matrix"_a, "Computes the SVD of given matrix.",
-          nb::rv_policy::reference)
-      .def(
-          "compute",
+      .def(DenseComputeVisitor<MatrixType, true>(
+          "Computes the SVD of given matrix."))
+      .def(computeMethod(
           [](Solver &c, const MatrixType &matrix, unsigned int) -> Solver & {
+            WorkspaceScope workspace;
             return c.compute(matrix);
           },
           "matrix"_a, "computationOptions"_a,
-          "Computes the SVD of given matrix.", nb::rv_policy::reference)
+          "Computes the SVD of given matrix."))
 
-      .def("setSwitchSize", &Solver::setSwitchSize, "s"_a)
+      .def("setSwitchSize", lockExclusive<Solver>(&Solver::setSwitchSize),
+           "s"_a)
 
-      .def(
-          "solve",
-          [](const Solver &c, const VectorType &b) -> VectorType {
-            return solve(c, b);
-          },
-          "b"_a,
-          "Returns the solution x of A x = b using the current "
-          "decomposition of A.")
-      .def(
-          "solve",
-          [](const Solver &c, const MatrixType &B) -> MatrixType {
-            return solve(c, B);
-          },
-          "B"_a,
-          "Returns the solution X of A X = B using the current "
-          "decomposition of A where B is a right hand side matrix.")
+      .def(DenseSolveVisitor<MatrixType>())
+
+      .def(AsyncVisitor<MatrixType>())
 
       .def(IdVisitor());
 }
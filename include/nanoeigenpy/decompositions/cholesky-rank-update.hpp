@@ -0,0 +1,221 @@
+/// Copyright 2025 INRIA
+
+#pragma once
+
+#include <Eigen/Cholesky>
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace nanoeigenpy {
+namespace detail {
+
+/// Width of the panels of the blocked rank-k updates.
+constexpr Eigen::Index kRankUpdateBlockSize = 32;
+
+/// \brief Gives access to the protected members of an Eigen decomposition,
+/// through pointers to members.
+template <typename Decomposition>
+struct DecompositionMembers : Decomposition {
+  static auto matrix() { return &DecompositionMembers::m_matrix; }
+  static auto info() { return &DecompositionMembers::m_info; }
+  static auto isInitialized() {
+    return &DecompositionMembers::m_isInitialized;
+  }
+};
+
+/// \brief Coefficients of a rank-one modification of a column l of the
+/// factor by a column w of the update: l <- ll l + lw w, w <- wl l + ww w.
+template <typename Scalar>
+struct RankUpdateRotation {
+  Scalar ll, lw, wl, ww;
+  /// Whether the modification leaves the columns unchanged.
+  bool skip = false;
+};
+
+template <typename L, typename W, typename Scalar>
+void applyRankUpdateRotation(L l, W w, const RankUpdateRotation<Scalar> &g) {
+  for (Eigen::Index r = 0; r < l.size(); ++r) {
+    const Scalar lr = l.coeff(r), wr = w.coeff(r);
+    l.coeffRef(r) = g.ll * lr + g.lw * wr;
+    w.coeffRef(r) = g.wl * lr + g.ww * wr;
+  }
+}
+
+/// \brief Applies the rank-one modifications of the k columns of \p W to
+/// the lower triangular factor stored in \p L, by panels of columns.
+///
+/// The modification of the column j of L by the column i of W is computed by
+/// step(i, L(j, j), W(j, i), g), which updates the diagonal coefficient
+/// L(j, j) in place, sets the rotation g of the two columns and returns false
+/// to stop. Within a panel, the rotations are applied to the rows of the
+/// panel as they are computed, and accumulated into a (b + k) x (b + k)
+/// matrix T. The rows below the panel are then updated at once by
+/// [L W] <- [L W] T, with matrix products.
+///
+/// The rotations are those of k successive rank-one updates, computed in
+/// another order, so that the result is the same up to rounding.
+///
+/// \returns the column where step() stopped, or -1.
+template <typename Factor, typename Work, typename Step>
+Eigen::Index blockedRankUpdate(Factor &L, Work &W, Step &step) {
+  using Scalar = typename Work::Scalar;
+  using Block = Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>;
+  const Eigen::Index n = L.rows();
+  const Eigen::Index k = W.cols();
+  Block T, panel, work;
+  for (Eigen::Index j0 = 0; j0 < n; j0 += kRankUpdateBlockSize) {
+    const Eigen::Index b = std::min(kRankUpdateBlockSize, n - j0);
+    const Eigen::Index j1 = j0 + b;
+    T.setIdentity(b + k, b + k);
+    for (Eigen::Index j = j0; j < j1; ++j) {
+      for (Eigen::Index i = 0; i < k; ++i) {
+        RankUpdateRotation<Scalar> g;
+        if (!step(i, L.coeffRef(j, j), W.coeff(j, i), g)) return j;
+        if (g.skip) continue;
+        const Eigen::Index rs = j1 - j - 1;
+        applyRankUpdateRotation(L.col(j).segment(j + 1, rs),
+                                W.col(i).segment(j + 1, rs), g);
+        applyRankUpdateRotation(T.col(j - j0), T.col(b + i), g);
+      }
+    }
+    const Eigen::Index m = n - j1;
+    if (m == 0) break;
+    auto trailing = L.block(j1, j0, m, b);
+    auto trailingW = W.bottomRows(m);
+    panel.noalias() = trailing * T.topLeftCorner(b, b);
+    panel.noalias() += trailingW * T.bottomLeftCorner(k, b);
+    work.noalias() = trailing * T.topRightCorner(b, k);
+    work.noalias() += trailingW * T.bottomRightCorner(k, k);
+    trailing = panel;
+    trailingW = work;
+  }
+  return -1;
+}
+
+template <typename WType, typename SigmaType>
+void checkRankUpdate(Eigen::Index rows, const Eigen::MatrixBase<WType> &W,
+                     const Eigen::MatrixBase<SigmaType> &sigmas) {
+  if (W.rows() != rows)
+    throw std::invalid_argument("W must have as many rows as the matrix.");
+  if (W.cols() != sigmas.size())
+    throw std::invalid_argument("W must have one column per sigma.");
+}
+
+}  // namespace detail
+
+/// \brief Updates the decomposition of A to the one of A + W diag(sigmas) W^*.
+///
+/// For real matrices, the k rank-one modifications of Eigen's rankUpdate are
+/// applied by panels of columns, so that most of the work is done by matrix
+/// products. info() is set to NumericalIssue if a downdate makes the matrix
+/// not positive definite; the factor is then left partially updated.
+template <typename MatrixType, int UpLo, typename WType, typename SigmaType>
+Eigen::LLT<MatrixType, UpLo> &rankUpdate(
+    Eigen::LLT<MatrixType, UpLo> &c, const Eigen::MatrixBase<WType> &W,
+    const Eigen::MatrixBase<SigmaType> &sigmas) {
+  using Chol = Eigen::LLT<MatrixType, UpLo>;
+  using Scalar = typename MatrixType::Scalar;
+  using RealScalar = typename MatrixType::RealScalar;
+  using Members = detail::DecompositionMembers<Chol>;
+  detail::checkRankUpdate(c.rows(), W, sigmas);
+  if constexpr (Eigen::NumTraits<Scalar>::IsComplex || UpLo != Eigen::Lower) {
+    for (Eigen::Index j = 0; j < W.cols(); ++j) {
+      c.rankUpdate(W.col(j), sigmas[j]);
+      if (c.info() != Eigen::Success) break;
+    }
+  } else {
+    eigen_assert((c.*Members::isInitialized()) &&
+                 "LLT is not initialized.");
+    if (W.cols() == 0) return c;
+    Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic> work = W;
+    Eigen::Matrix<RealScalar, Eigen::Dynamic, 1> beta =
+        Eigen::Matrix<RealScalar, Eigen::Dynamic, 1>::Ones(W.cols());
+    // Rank-one update of Eigen's llt_rank_update_lower, in the form used for
+    // its downdates.
+    auto step = [&](Eigen::Index i, Scalar &ljj, const Scalar &wj,
+                    detail::RankUpdateRotation<Scalar> &g) {
+      const RealScalar sigma = sigmas[i];
+      const RealScalar dj = ljj * ljj;
+      const RealScalar swj2 = sigma * wj * wj;
+      const RealScalar gamma = dj * beta[i] + swj2;
+      const RealScalar x = dj + swj2 / beta[i];
+      if (!(x > RealScalar(0))) return false;
+      const RealScalar nljj = std::sqrt(x);
+      beta[i] += swj2 / dj;
+      const Scalar h = gamma != RealScalar(0) ? nljj * sigma * wj / gamma
+                                              : Scalar(0);
+      // w <- w - (wj / ljj) l, then l <- (nljj / ljj) l + h w.
+      g.wl = -wj / ljj;
+      g.ww = Scalar(1);
+      g.ll = nljj / ljj + h * g.wl;
+      g.lw = h;
+      ljj = nljj;
+      return true;
+    };
+    const Eigen::Index failed =
+        detail::blockedRankUpdate(c.*Members::matrix(), work, step);
+    c.*Members::info() = failed >= 0 ? Eigen::NumericalIssue : Eigen::Success;
+  }
+  return c;
+}
+
+/// \brief Updates the decomposition of A to the one of A + W diag(sigmas) W^*.
+///
+/// For real matrices, the k rank-one modifications of Eigen's rankUpdate are
+/// applied by panels of columns, so that most of the work is done by matrix
+/// products.
+template <typename MatrixType, int UpLo, typename WType, typename SigmaType>
+Eigen::LDLT<MatrixType, UpLo> &rankUpdate(
+    Eigen::LDLT<MatrixType, UpLo> &c, const Eigen::MatrixBase<WType> &W,
+    const Eigen::MatrixBase<SigmaType> &sigmas) {
+  using Solver = Eigen::LDLT<MatrixType, UpLo>;
+  using Scalar = typename MatrixType::Scalar;
+  using RealScalar = typename MatrixType::RealScalar;
+  using Members = detail::DecompositionMembers<Solver>;
+  detail::checkRankUpdate(c.rows(), W, sigmas);
+  Eigen::Index first = 0;
+  if constexpr (!Eigen::NumTraits<Scalar>::IsComplex && UpLo == Eigen::Lower) {
+    // Eigen initializes the decomposition on the first update.
+    if (W.cols() > 0 && !(c.*Members::isInitialized())) {
+      c.rankUpdate(W.col(0), sigmas[0]);
+      first = 1;
+    }
+    if (first == W.cols()) return c;
+    const Eigen::Index k = W.cols() - first;
+    Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic> work =
+        c.transpositionsP() * W.rightCols(k);
+    Eigen::Matrix<RealScalar, Eigen::Dynamic, 1> alpha =
+        Eigen::Matrix<RealScalar, Eigen::Dynamic, 1>::Ones(k);
+    // Rank-one update of Eigen's ldlt_inplace::updateInPlace.
+    auto step = [&](Eigen::Index i, Scalar &dj, const Scalar &wj,
+                    detail::RankUpdateRotation<Scalar> &g) {
+      // An update stops at the first zero pivot of a low-rank decomposition.
+      if (!std::isfinite(alpha[i])) {
+        g.skip = true;
+        return true;
+      }
+      const RealScalar sigma = sigmas[first + i];
+      const RealScalar d = dj;
+      const RealScalar swj2 = sigma * wj * wj;
+      const RealScalar gamma = d * alpha[i] + swj2;
+      dj += swj2 / alpha[i];
+      alpha[i] += swj2 / d;
+      const Scalar h = gamma != RealScalar(0) ? sigma * wj / gamma : Scalar(0);
+      // w <- w - wj l, then l <- l + h w.
+      g.wl = -wj;
+      g.ww = Scalar(1);
+      g.ll = Scalar(1) - h * wj;
+      g.lw = h;
+      return true;
+    };
+    detail::blockedRankUpdate(c.*Members::matrix(), work, step);
+  } else {
+    for (Eigen::Index j = first; j < W.cols(); ++j)
+      c.rankUpdate(W.col(j), sigmas[j]);
+  }
+  return c;
+}
+
+}  // namespace nanoeigenpy
@@ -3,18 +3,16 @@
 #pragma once
 
 #include "nanoeigenpy/fwd.hpp"
+#include "nanoeigenpy/decompositions/dense-solver-base.hpp"
+#include "nanoeigenpy/utils/views.hpp"
+#include "nanoeigenpy/utils/workspace.hpp"
+#include "nanoeigenpy/utils/object-lock.hpp"
 #include <Eigen/QR>
 
 namespace nanoeigenpy {
 namespace nb = nanobind;
 using namespace nb::literals;
 
-template <typename MatrixType, typename MatrixOrVector>
-MatrixOrVector solve(const Eigen::ColPivHouseholderQR<MatrixType> &c,
-                     const MatrixOrVector &vec) {
-  return c.solve(vec);
-}
-
 template <typename MatrixType>
 MatrixType inverse(const Eigen::ColPivHouseholderQR<MatrixType> &c) {
   return c.inverse();
@@ -24,9 +22,7 @@ template <typename _MatrixType>
 void exposeColPivHouseholderQR(nb::module_ m, const char *name) {
   using MatrixType = _MatrixType;
   using Solver = Eigen::ColPivHouseholderQR<MatrixType>;
-  using Scalar = typename MatrixType::Scalar;
   using RealScalar = typename MatrixType::RealScalar;
-  using VectorType = Eigen::Matrix<Scalar, -1, 1>;
 
   if (check_registration_alias<Solver>(m)) {
     return;
@@ -127,9 +123,9 @@ void exposeColPivHouseholderQR(nb::module_ m, const char *name) {
 
       .def(
           "setThreshold",
-          [](Solver &c, const RealScalar &threshold) {
+          lockExclusive<Solver>([](Solver &c, const RealScalar &threshold) {
             return c.setThreshold(threshold);
-          },
+          }),
           "threshold"_a,
           "Allows to prescribe a threshold to be used by certain methods, "
           "such as rank(), who need to determine when pivots are to be "
@@ -148,7 +144,8 @@ void exposeColPivHouseholderQR(nb::module_ m, const char *name) {
           nb::rv_policy::reference)
       .def(
           "setThreshold",
-          [](Solver &c) { return c.setThreshold(Eigen::Default); },
+          lockExclusive<Solver>(
+              [](Solver &c) { return c.setThreshold(Eigen::Default); }),
           "Allows to come back to the default behavior, letting Eigen use "
           "its default formula for determining the threshold.",
           nb::rv_policy::reference)
@@ -156,43 +153,25 @@ void exposeColPivHouseholderQR(nb::module_ m, const char *name) {
            "Returns the threshold that will be used by certain methods such "
            "as rank().")
 
-      .def("matrixQR", &Solver::matrixQR,
-           "Returns the matrix where the Householder QR decomposition is "
-           "stored in a LAPACK-compatible way.",
-           nb::rv_policy::copy)
-      .def("matrixR", &Solver::matrixR,
-           "Returns the matrix where the result Householder QR is stored.",
-           nb::rv_policy::copy)
+      .def("matrixQR", copyOrViewOf<Solver>(&Solver::matrixQR),
+           "copy"_a = false,
+           "Returns a read-only view of the matrix where the Householder QR "
+           "decomposition is stored in a LAPACK-compatible way. With "
+           "copy=True, returns instead a copy.")
+      .def("matrixR", copyOrViewOf<Solver>(&Solver::matrixR),
+           "copy"_a = false,
+           "Returns a read-only view of the matrix where the result "
+           "Householder QR is stored. With copy=True, returns instead a copy.")
 
-      .def(
-          "compute",
-          [](Solver &c, const MatrixType &matrix) -> Solver & {
-            return c.compute(matrix);
-          },
-          "matrix"_a, "Computes the QR factorization of given matrix.",
-          nb::rv_policy::reference)
+      .def(DenseComputeVisitor<MatrixType, true>(
+          "Computes the QR factorization of given matrix."))
 
       .def(
           "inverse", [](const Solver &c) -> MatrixType { return inverse(c); },
           "Returns the inverse of the matrix associated with the QR "
           "decomposition.")
 
-      .def(
-          "solve",
-          [](const Solver &c, const VectorType &b) -> VectorType {
-            return solve(c, b);
-          },
-          "b"_a,
-          "Returns the solution x of A x = B using the current "
-          "decomposition of A where b is a right hand side vector.")
-      .def(
-          "solve",
-          [](const Solver &c, const MatrixType &B) -> MatrixType {
-            return solve(c, B);
-          },
-          "B"_a,
-          "Returns the solution X of A X = B using the current "
-          "decomposition of A where B is a right hand side matrix.")
+      .def(DenseSolveVisitor<MatrixType>())
 
       .def(IdVisitor());
 }
@@ -3,19 +3,15 @@
 #pragma once
 
 #include "nanoeigenpy/fwd.hpp"
+#include "nanoeigenpy/decompositions/dense-solver-base.hpp"
+#include "nanoeigenpy/utils/views.hpp"
+#include "nanoeigenpy/utils/object-lock.hpp"
 #include <Eigen/QR>
 
 namespace nanoeigenpy {
 namespace nb = nanobind;
 using namespace nb::literals;
 
-template <typename MatrixType, typename MatrixOrVector>
-MatrixOrVector solve(
-    const Eigen::CompleteOrthogonalDecomposition<MatrixType> &c,
-    const MatrixOrVector &vec) {
-  return c.solve(vec);
-}
-
 template <typename MatrixType>
 MatrixType pseudoInverse(
     const Eigen::CompleteOrthogonalDecomposition<MatrixType> &c) {
@@ -26,9 +22,7 @@ template <typename _MatrixType>
 void exposeCompleteOrthogonalDecomposition(nb::module_ m, const char *name) {
   using MatrixType = _MatrixType;
   using Solver = Eigen::CompleteOrthogonalDecomposition<MatrixType>;
-  using Scalar = typename MatrixType::Scalar;
   using RealScalar = typename MatrixType::RealScalar;
-  using VectorType = Eigen::Matrix<Scalar, -1, 1>;
 
   if (check_registration_alias<Solver>(m)) {
     return;
@@ -135,9 +129,9 @@ void exposeCompleteOrthogonalDecomposition(nb::module_ m, const char *name) {
 
       .def(
           "setThreshold",
-          [](Solver &c, const RealScalar &threshold) {
+          lockExclusive<Solver>([](Solver &c, const RealScalar &threshold) {
             return c.setThreshold(threshold);
-          },
+          }),
           "threshold"_a,
           "Allows to prescribe a threshold to be used by certain methods, "
           "such as rank(), who need to determine when pivots are to be "
@@ -158,7 +152,8 @@ void exposeCompleteOrthogonalDecomposition(nb::module_ m, const char *name) {
           nb::rv_policy::reference)
       .def(
           "setThreshold",
-          [](Solver &c) { return c.setThreshold(Eigen::Default); },
+          lockExclusive<Solver>(
+              [](Solver &c) { return c.setThreshold(Eigen::Default); }),
           "Allows to come back to the default behavior, letting Eigen use "
           "its default formula for determining the threshold.",
           nb::rv_policy::reference)
@@ -166,22 +161,20 @@ void exposeCompleteOrthogonalDecomposition(nb::module_ m, const char *name) {
            "Returns the threshold that will be used by certain methods such "
            "as rank().")
 
-      .def("matrixQTZ", &Solver::matrixQTZ,
-           "Returns the matrix where the complete orthogonal decomposition "
-           "is stored.",
-           nb::rv_policy::copy)
-      .def("matrixT", &Solver::matrixT,
-           "Returns the matrix where the complete orthogonal decomposition "
-           "is stored.",
-           nb::rv_policy::copy)
+      .def("matrixQTZ", copyOrViewOf<Solver>(&Solver::matrixQTZ),
+           "copy"_a = false,
+           "Returns a read-only view of the matrix where the complete "
+           "orthogonal decomposition is stored. With copy=True, returns "
+           "instead a copy.")
+      .def("matrixT", copyOrViewOf<Solver>(&Solver::matrixT),
+           "copy"_a = false,
+           "Returns a read-only view of the matrix where the complete "
+           "orthogonal decomposition is stored. With copy=True, returns "
+           "instead a copy.")
       .def("matrixZ", &Solver::matrixZ, "Returns the matrix Z.")
 
-      .def(
-          "compute",
-          [](Solver &c, const MatrixType &matrix) { return c.compute(matrix); },
-          "matrix"_a,
-          "Computes the complete orthogonal factorization of given matrix.",
-          nb::rv_policy::reference)
+      .def(DenseComputeVisitor<MatrixType>(
+          "Computes the complete orthogonal factorization of given matrix."))
 
       .def(
           "pseudoInverse",
@@ -190,22 +183,7 @@ void exposeCompleteOrthogonalDecomposition(nb::module_ m, const char *name) {
           "complete orthogonal "
           "decomposition.")
 
-      .def(
-          "solve",
-          [](const Solver &c, const VectorType &b) -> VectorType {
-            return solve(c, b);
-          },
-          "b"_a,
-          "Returns the solution x of A x = B using the current "
-          "decomposition of A where b is a right hand side vector.")
-      .def(
-          "solve",
-          [](const Solver &c, const MatrixType &B) -> MatrixType {
-            return solve(c, B);
-          },
-          "B"_a,
-          "Returns the solution X of A X = B using the current "
-          "decomposition of A where B is a right hand side matrix.")
+      .def(DenseSolveVisitor<MatrixType>())
 
       .def(IdVisitor());
 }
@@ -3,6 +3,8 @@
 #pragma once
 
 #include "nanoeigenpy/fwd.hpp"
+#include "nanoeigenpy/decompositions/dense-solver-base.hpp"
+#include "nanoeigenpy/utils/object-lock.hpp"
 #include <Eigen/Eigenvalues>
 
 namespace nanoeigenpy {
@@ -33,26 +35,21 @@ void exposeComplexEigenSolver(nb::module_ m, const char *name) {
            "Returns the eigenvectors of given matrix.",
            nb::rv_policy::reference_internal)
 
-      .def(
-          "compute",
-          [](Solver &c, const MatrixType &matrix) -> Solver & {
-            return c.compute(matrix);
+      .def(DenseComputeVisitor<MatrixType>(
+          "Computes the eigendecomposition of given matrix."))
+      .def(computeMethod(
+          [](Solver &c, const MatrixType &matrix,
+             bool computeEigenvectors) -> Solver & {
+            return c.compute(matrix, computeEigenvectors);
           },
-          "matrix"_a, "Computes the eigendecomposition of given matrix.",
-          nb::rv_policy::reference)
-      .def(
-          "compute",
-          [](Solver &c, const MatrixType &matrix, bool computeEigenvectors)
-              -> Solver & { return c.compute(matrix, computeEigenvectors); },
           "matrix"_a, "computeEigenvectors"_a,
-          "Computes the eigendecomposition of given matrix.",
-          nb::rv_policy::reference)
+          "Computes the eigendecomposition of given matrix."))
 
       .def("info", &Solver::info,
            "NumericalIssue if the input contains INF or NaN values or "
            "overflow occured. Returns Success otherwise.")
 
-      .def("setMaxIterations", &Solver::setMaxIterations,
+      .def("setMaxIterations", lockExclusive<Solver>(&Solver::setMaxIterations),
            "Sets the maximum number of iterations allowed.",
            nb::rv_policy::reference)
       .def("getMaxIterations", &Solver::getMaxIterations,
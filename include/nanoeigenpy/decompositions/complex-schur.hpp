@@ -3,6 +3,8 @@
 #pragma once
 
 #include "nanoeigenpy/fwd.hpp"
+#include "nanoeigenpy/decompositions/dense-solver-base.hpp"
+#include "nanoeigenpy/utils/object-lock.hpp"
 #include <Eigen/Eigenvalues>
 
 namespace nanoeigenpy {
@@ -32,28 +34,22 @@ void exposeComplexSchur(nb::module_ m, const char *name) {
            "Returns the triangular matrix in the Schur decomposition. ",
            nb::rv_policy::reference_internal)
 
-      .def(
-          "compute",
-          [](Solver &c, const MatrixType &matrix) -> Solver & {
-            return c.compute(matrix);
-          },
-          "matrix"_a, "Computes Schur decomposition of given matrix. ",
-          nb::rv_policy::reference)
-      .def(
-          "compute",
+      .def(DenseComputeVisitor<MatrixType>(
+          "Computes Schur decomposition of given matrix. "))
+      .def(computeMethod(
           [](Solver &c, const MatrixType &matrix, bool computeU) -> Solver & {
             return c.compute(matrix, computeU);
           },
           "matrix"_a, "computeU"_a,
-          "Computes Schur decomposition of given matrix. ",
-          nb::rv_policy::reference)
+          "Computes Schur decomposition of given matrix. "))
 
       .def(
           "computeFromHessenberg",
-          [](Solver &c, const MatrixType &matrixH, const MatrixType &matrixQ,
-             bool computeU) -> Solver & {
-            return c.computeFromHessenberg(matrixH, matrixQ, computeU);
-          },
+          lockExclusive<Solver>(
+              [](Solver &c, const MatrixType &matrixH,
+                 const MatrixType &matrixQ, bool computeU) -> Solver & {
+                return c.computeFromHessenberg(matrixH, matrixQ, computeU);
+              }),
           "matrixH"_a, "matrixQ"_a, "computeU"_a,
           "Compute Schur decomposition from a given Hessenberg matrix. ",
           nb::rv_policy::reference)
@@ -64,7 +60,7 @@ void exposeComplexSchur(nb::module_ m, const char *name) {
 
       .def("getMaxIterations", &Solver::getMaxIterations,
            "Returns the maximum number of iterations.")
-      .def("setMaxIterations", &Solver::setMaxIterations,
+      .def("setMaxIterations", lockExclusive<Solver>(&Solver::setMaxIterations),
            "Sets the maximum number of iterations allowed.",
            nb::rv_policy::reference)
 
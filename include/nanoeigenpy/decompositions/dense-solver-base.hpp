@@ -0,0 +1,91 @@
+/// Copyright 2025 INRIA
+
+#pragma once
+
+#include "nanoeigenpy/fwd.hpp"
+#include "nanoeigenpy/utils/instrumented-method.hpp"
+#include "nanoeigenpy/utils/workspace.hpp"
+
+#include <type_traits>
+
+namespace nanoeigenpy {
+namespace nb = nanobind;
+using namespace nb::literals;
+
+/// \brief Adds compute(matrix) to a dense decomposition. It takes the lock of
+/// the decomposition exclusively, and its calls are counted and timed in the
+/// statistics of the module (see instrumentation). The overloads taking other
+/// arguments are defined with computeMethod().
+/// \tparam UseWorkspace Whether compute() runs in a WorkspaceScope, for the
+/// decompositions whose compute() allocates temporaries.
+template <typename MatrixType, bool UseWorkspace = false>
+struct DenseComputeVisitor
+    : nb::def_visitor<DenseComputeVisitor<MatrixType, UseWorkspace>> {
+  explicit DenseComputeVisitor(const char *doc) : m_doc(doc) {}
+
+  template <typename Solver, typename... Ts>
+  void execute(nb::class_<Solver, Ts...> &cl) const {
+    cl.def(computeMethod(
+        [](Solver &c, const MatrixType &matrix) -> Solver & {
+          if constexpr (UseWorkspace) {
+            WorkspaceScope workspace;
+            c.compute(matrix);
+          } else {
+            c.compute(matrix);
+          }
+          return c;
+        },
+        "matrix"_a, m_doc));
+  }
+
+ private:
+  const char *m_doc;
+};
+
+/// \brief Adds solve(b) and solve(B) to a dense decomposition, for a right
+/// hand side vector and matrix. Their calls are counted and timed in the
+/// statistics of the module (see instrumentation).
+/// \tparam LockSolve Whether solve() takes the lock of the decomposition
+/// exclusively, for the solvers whose solve writes into the solver (e.g. the
+/// mixed precision solvers). Otherwise, it takes it shared, so that
+/// concurrent solves run in parallel.
+template <typename MatrixType, bool LockSolve = false>
+struct DenseSolveVisitor
+    : nb::def_visitor<DenseSolveVisitor<MatrixType, LockSolve>> {
+  using Scalar = typename MatrixType::Scalar;
+  using VectorType = Eigen::Matrix<Scalar, -1, 1>;
+
+  explicit DenseSolveVisitor(
+      const char *vectorDoc =
+          "Returns the solution x of A x = b using the current decomposition "
+          "of A.",
+      const char *matrixDoc =
+          "Returns the solution X of A X = B using the current decomposition "
+          "of A where B is a right hand side matrix.")
+      : m_vectorDoc(vectorDoc), m_matrixDoc(matrixDoc) {}
+
+  template <typename Solver, typename... Ts>
+  void execute(nb::class_<Solver, Ts...> &cl) const {
+    constexpr locks::Mode mode =
+        LockSolve ? locks::Mode::Exclusive : locks::Mode::Shared;
+    using Self = std::conditional_t<LockSolve, Solver &, const Solver &>;
+    cl.def(instrumentedMethod<mode>(
+               "solve",
+               [](Self c, const VectorType &b) -> VectorType {
+                 return c.solve(b);
+               },
+               "b"_a, m_vectorDoc))
+        .def(instrumentedMethod<mode>(
+            "solve",
+            [](Self c, const MatrixType &B) -> MatrixType {
+              return c.solve(B);
+            },
+            "B"_a, m_matrixDoc));
+  }
+
+ private:
+  const char *m_vectorDoc;
+  const char *m_matrixDoc;
+};
+
+}  // namespace nanoeigenpy
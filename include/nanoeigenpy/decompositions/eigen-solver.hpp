@@ -3,6 +3,8 @@
 #pragma once
 
 #include "nanoeigenpy/fwd.hpp"
+#include "nanoeigenpy/decompositions/dense-solver-base.hpp"
+#include "nanoeigenpy/utils/object-lock.hpp"
 #include <Eigen/Eigenvalues>
 
 namespace nanoeigenpy {
@@ -31,24 +33,19 @@ void exposeEigenSolver(nb::module_ m, const char *name) {
       .def("eigenvectors", &Solver::eigenvectors,
            "Returns the eigenvectors of the matrix.")
 
-      .def(
-          "compute",
-          [](Solver &c, const MatrixType &matrix) -> Solver & {
-            return c.compute(matrix);
+      .def(DenseComputeVisitor<MatrixType>(
+          "Computes the eigendecomposition of given matrix."))
+      .def(computeMethod(
+          [](Solver &c, const MatrixType &matrix,
+             bool compute_eigen_vectors) -> Solver & {
+            return c.compute(matrix, compute_eigen_vectors);
           },
-          "matrix"_a, "Computes the eigendecomposition of given matrix.",
-          nb::rv_policy::reference)
-      .def(
-          "compute",
-          [](Solver &c, const MatrixType &matrix, bool compute_eigen_vectors)
-              -> Solver & { return c.compute(matrix, compute_eigen_vectors); },
           "matrix"_a, "compute_eigen_vectors"_a,
-          "Computes the eigendecomposition of given matrix.",
-          nb::rv_policy::reference)
+          "Computes the eigendecomposition of given matrix."))
 
       .def("getMaxIterations", &Solver::getMaxIterations,
            "Returns the maximum number of iterations.")
-      .def("setMaxIterations", &Solver::setMaxIterations,
+      .def("setMaxIterations", lockExclusive<Solver>(&Solver::setMaxIterations),
            "Sets the maximum number of iterations allowed.",
            nb::rv_policy::reference)
 
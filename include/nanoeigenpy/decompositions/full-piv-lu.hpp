@@ -3,25 +3,20 @@
 #pragma once
 
 #include "nanoeigenpy/fwd.hpp"
+#include "nanoeigenpy/decompositions/dense-solver-base.hpp"
+#include "nanoeigenpy/utils/async.hpp"
+#include "nanoeigenpy/utils/object-lock.hpp"
 #include <Eigen/LU>
 
 namespace nanoeigenpy {
 namespace nb = nanobind;
 using namespace nb::literals;
 
-template <typename MatrixType, typename MatrixOrVector>
-MatrixOrVector solve(const Eigen::FullPivLU<MatrixType> &c,
-                     const MatrixOrVector &vec) {
-  return c.solve(vec);
-}
-
 template <typename _MatrixType>
 void exposeFullPivLU(nb::module_ m, const char *name) {
   using MatrixType = _MatrixType;
   using Solver = Eigen::FullPivLU<MatrixType>;
-  using Scalar = typename MatrixType::Scalar;
   using RealScalar = typename MatrixType::RealScalar;
-  using VectorType = Eigen::Matrix<Scalar, -1, 1>;
 
   if (check_registration_alias<Solver>(m)) {
     return;
@@ -61,13 +56,7 @@ void exposeFullPivLU(nb::module_ m, const char *name) {
       .def(nb::init<const MatrixType &>(), "matrix"_a,
            "Constructs a LU factorization from a given matrix.")
 
-      .def(
-          "compute",
-          [](Solver &c, const MatrixType &matrix) -> Solver & {
-            return c.compute(matrix);
-          },
-          "matrix"_a, "Computes the LU of given matrix.",
-          nb::rv_policy::reference)
+      .def(DenseComputeVisitor<MatrixType>("Computes the LU of given matrix."))
 
       .def("matrixLU", &Solver::matrixLU,
            "Returns the LU decomposition matrix: the upper-triangular part is "
@@ -112,9 +101,9 @@ void exposeFullPivLU(nb::module_ m, const char *name) {
 
       .def(
           "setThreshold",
-          [](Solver &c, const RealScalar &threshold) {
+          lockExclusive<Solver>([](Solver &c, const RealScalar &threshold) {
             return c.setThreshold(threshold);
-          },
+          }),
           "threshold"_a,
           "Allows to prescribe a threshold to be used by certain methods, "
           "such as rank(), who need to determine when pivots are to be "
@@ -133,7 +122,8 @@ void exposeFullPivLU(nb::module_ m, const char *name) {
           nb::rv_policy::reference)
       .def(
           "setThreshold",
-          [](Solver &c) { return c.setThreshold(Eigen::Default); },
+          lockExclusive<Solver>(
+              [](Solver &c) { return c.setThreshold(Eigen::Default); }),
           "Allows to come back to the default behavior, letting Eigen use "
           "its default formula for determining the threshold.",
           nb::rv_policy::reference)
@@ -184,22 +174,9 @@ void exposeFullPivLU(nb::module_ m, const char *name) {
       .def("rows", &Solver::rows, "Returns the number of rows of the matrix.")
       .def("cols", &Solver::cols, "Returns the number of cols of the matrix.")
 
-      .def(
-          "solve",
-          [](const Solver &c, const VectorType &b) -> VectorType {
-            return solve(c, b);
-          },
-          "b"_a,
-          "Returns the solution x of A x = b using the current "
-          "decomposition of A.")
-      .def(
-          "solve",
-          [](const Solver &c, const MatrixType &B) -> MatrixType {
-            return solve(c, B);
-          },
-          "B"_a,
-          "Returns the solution X of A X = B using the current "
-          "decomposition of A where B is a right hand side matrix.")
+      .def(DenseSolveVisitor<MatrixType>())
+
+      .def(AsyncVisitor<MatrixType>())
 
       .def(IdVisitor());
 }
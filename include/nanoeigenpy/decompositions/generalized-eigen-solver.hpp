@@ -3,6 +3,8 @@
 #pragma once
 
 #include "nanoeigenpy/fwd.hpp"
+#include "nanoeigenpy/decompositions/dense-solver-base.hpp"
+#include "nanoeigenpy/utils/object-lock.hpp"
 #include <Eigen/Eigenvalues>
 
 namespace nanoeigenpy {
@@ -38,29 +40,25 @@ void exposeGeneralizedEigenSolver(nb::module_ m, const char *name) {
       .def("betas", &Solver::betas,
            "Returns tthe vectors containing the beta values.")
 
-      .def(
-          "compute",
+      .def(computeMethod(
           [](Solver &c, const MatrixType &A, const MatrixType &B) -> Solver & {
             return c.compute(A, B);
           },
           "A"_a, "B"_a,
-          "Computes generalized eigendecomposition of given matrix.",
-          nb::rv_policy::reference)
-      .def(
-          "compute",
+          "Computes generalized eigendecomposition of given matrix."))
+      .def(computeMethod(
           [](Solver &c, const MatrixType &A, const MatrixType &B,
              bool computeEigenvectors) -> Solver & {
             return c.compute(A, B, computeEigenvectors);
           },
           "A"_a, "B"_a, "computeEigenvectors"_a,
-          "Computes generalized eigendecomposition of given matrix.",
-          nb::rv_policy::reference)
+          "Computes generalized eigendecomposition of given matrix."))
 
       .def("info", &Solver::info,
            "NumericalIssue if the input contains INF or NaN values or "
            "overflow occured. Returns Success otherwise.")
 
-      .def("setMaxIterations", &Solver::setMaxIterations,
+      .def("setMaxIterations", lockExclusive<Solver>(&Solver::setMaxIterations),
            "Sets the maximum number of iterations allowed.",
            nb::rv_policy::reference)
 
@@ -3,6 +3,9 @@
 #pragma once
 
 #include "nanoeigenpy/fwd.hpp"
+#include "nanoeigenpy/decompositions/dense-solver-base.hpp"
+#include "nanoeigenpy/utils/object-lock.hpp"
+#include "nanoeigenpy/utils/views.hpp"
 #include <Eigen/Eigenvalues>
 
 namespace nanoeigenpy {
@@ -13,8 +16,6 @@ template <typename _MatrixType>
 void exposeGeneralizedSelfAdjointEigenSolver(nb::module_ m, const char *name) {
   using MatrixType = _MatrixType;
   using Solver = Eigen::GeneralizedSelfAdjointEigenSolver<MatrixType>;
-  using Scalar = typename MatrixType::Scalar;
-  using VectorType = Eigen::Matrix<Scalar, Eigen::Dynamic, 1>;
 
   if (check_registration_alias<Solver>(m)) {
     return;
@@ -28,50 +29,44 @@ void exposeGeneralizedSelfAdjointEigenSolver(nb::module_ m, const char *name) {
            "matB"_a, "options"_a = Eigen::ComputeEigenvectors | Eigen::Ax_lBx,
            "Computes the generalized eigendecomposition of given matrix pencil")
 
-      .def(
-          "compute",
-          [](Solver &c, const MatrixType &matA, const MatrixType &matB)
-              -> Solver & { return c.compute(matA, matB); },
+      .def(computeMethod(
+          [](Solver &c, const MatrixType &matA,
+             const MatrixType &matB) -> Solver & {
+            return c.compute(matA, matB);
+          },
           "matA"_a, "matB"_a,
-          "Computes the generalized eigendecomposition of given matrix.",
-          nb::rv_policy::reference)
-      .def(
-          "compute",
+          "Computes the generalized eigendecomposition of given matrix."))
+      .def(computeMethod(
           [](Solver &c, const MatrixType &matA, const MatrixType &matB,
              int options) -> Solver & {
             return c.compute(matA, matB, options);
           },
           "matA"_a, "matB"_a, "options"_a,
-          "Computes the generalized eigendecomposition of given matrix.",
-          nb::rv_policy::reference)
+          "Computes the generalized eigendecomposition of given matrix."))
 
-      .def(
-          "eigenvalues",
-          [](const Solver &c) -> const VectorType & { return c.eigenvalues(); },
-          "Returns the eigenvalues of given matrix.",
-          nb::rv_policy::reference_internal)
-      .def(
-          "eigenvectors",
-          [](const Solver &c) -> const MatrixType & {
-            return c.eigenvectors();
-          },
-          "Returns the eigenvectors of given matrix.",
-          nb::rv_policy::reference_internal)
+      .def("eigenvalues", readOnlyViewOf<Solver>(&Solver::eigenvalues),
+           "Returns a read-only view of the eigenvalues of given matrix.")
+      .def("eigenvectors", readOnlyViewOf<Solver>(&Solver::eigenvectors),
+           "Returns a read-only view of the eigenvectors of given matrix.")
 
       .def(
           "computeDirect",
-          [](Solver &c, const MatrixType &matrix) -> Solver & {
-            return static_cast<Solver &>(c.computeDirect(matrix));
-          },
+          lockExclusive<Solver>(
+              [](Solver &c, const MatrixType &matrix) -> Solver & {
+                views::detachViews(&c);
+                return static_cast<Solver &>(c.computeDirect(matrix));
+              }),
           "matrix"_a,
           "Computes eigendecomposition of given matrix using a closed-form "
           "algorithm.",
           nb::rv_policy::reference)
       .def(
           "computeDirect",
-          [](Solver &c, const MatrixType &matrix, int options) -> Solver & {
-            return static_cast<Solver &>(c.computeDirect(matrix, options));
-          },
+          lockExclusive<Solver>(
+              [](Solver &c, const MatrixType &matrix, int options) -> Solver & {
+                views::detachViews(&c);
+                return static_cast<Solver &>(c.computeDirect(matrix, options));
+              }),
           "matrix"_a, "options"_a,
           "Computes eigendecomposition of given matrix using a closed-form "
           "algorithm.",
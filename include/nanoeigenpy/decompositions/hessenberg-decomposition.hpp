@@ -3,6 +3,8 @@
 #pragma once
 
 #include "nanoeigenpy/fwd.hpp"
+#include "nanoeigenpy/decompositions/dense-solver-base.hpp"
+#include "nanoeigenpy/utils/object-lock.hpp"
 #include <Eigen/Eigenvalues>
 
 namespace nanoeigenpy {
@@ -24,13 +26,8 @@ void exposeHessenbergDecomposition(nb::module_ m, const char *name) {
       .def(nb::init<const MatrixType &>(), "matrix"_a,
            "Constructor; computes Hessenberg decomposition of given matrix.")
 
-      .def(
-          "compute",
-          [](Solver &c, const MatrixType &matrix) -> Solver & {
-            return c.compute(matrix);
-          },
-          "matrix"_a, "Computes Hessenberg decomposition of given matrix.",
-          nb::rv_policy::reference)
+      .def(DenseComputeVisitor<MatrixType>(
+          "Computes Hessenberg decomposition of given matrix."))
 
       .def("householderCoefficients", &Solver::householderCoefficients,
            "Returns the Householder coefficients.",
@@ -3,24 +3,19 @@
 #pragma once
 
 #include "nanoeigenpy/fwd.hpp"
+#include "nanoeigenpy/decompositions/dense-solver-base.hpp"
+#include "nanoeigenpy/utils/views.hpp"
+#include "nanoeigenpy/utils/object-lock.hpp"
 #include <Eigen/QR>
 
 namespace nanoeigenpy {
 namespace nb = nanobind;
 using namespace nb::literals;
 
-template <typename MatrixType, typename MatrixOrVector>
-MatrixOrVector solve(const Eigen::HouseholderQR<MatrixType> &c,
-                     const MatrixOrVector &vec) {
-  return c.solve(vec);
-}
-
 template <typename _MatrixType>
 void exposeHouseholderQR(nb::module_ m, const char *name) {
   using MatrixType = _MatrixType;
   using Solver = Eigen::HouseholderQR<MatrixType>;
-  using Scalar = typename MatrixType::Scalar;
-  using VectorType = Eigen::Matrix<Scalar, -1, 1>;
 
   if (check_registration_alias<Solver>(m)) {
     return;
@@ -76,40 +71,22 @@ void exposeHouseholderQR(nb::module_ m, const char *name) {
            "work around the risk of overflow/underflow that's inherent to "
            "determinant computation.")
 
-      .def("householderQ", &Solver::matrixQR,
-           "Returns the matrix where the Householder QR decomposition is "
-           "stored in a LAPACK-compatible way.",
-           nb::rv_policy::copy)
+      .def("householderQ", copyOrViewOf<Solver>(&Solver::matrixQR),
+           "copy"_a = false,
+           "Returns a read-only view of the matrix where the Householder QR "
+           "decomposition is stored in a LAPACK-compatible way. With "
+           "copy=True, returns instead a copy.")
 
-      .def("matrixQR", &Solver::matrixQR,
-           "Returns the matrix where the Householder QR decomposition is "
-           "stored in a LAPACK-compatible way.",
-           nb::rv_policy::copy)
+      .def("matrixQR", copyOrViewOf<Solver>(&Solver::matrixQR),
+           "copy"_a = false,
+           "Returns a read-only view of the matrix where the Householder QR "
+           "decomposition is stored in a LAPACK-compatible way. With "
+           "copy=True, returns instead a copy.")
 
-      .def(
-          "compute",
-          [](Solver &c, const MatrixType &matrix) -> Solver & {
-            return c.compute(matrix);
-          },
-          "matrix"_a, "Computes the QR factorization of given matrix.",
-          nb::rv_policy::reference)
+      .def(DenseComputeVisitor<MatrixType>(
+          "Computes the QR factorization of given matrix."))
 
-      .def(
-          "solve",
-          [](const Solver &c, const VectorType &b) -> VectorType {
-            return solve(c, b);
-          },
-          "b"_a,
-          "Returns the solution x of A x = B using the current "
-          "decomposition of A where b is a right hand side vector.")
-      .def(
-          "solve",
-          [](const Solver &c, const MatrixType &B) -> MatrixType {
-            return solve(c, B);
-          },
-          "B"_a,
-          "Returns the solution X of A X = B using the current "
-          "decomposition of A where B is a right hand side matrix.")
+      .def(DenseSolveVisitor<MatrixType>())
 
       .def(IdVisitor());
 }
@@ -3,6 +3,9 @@
 #pragma once
 
 #include "nanoeigenpy/fwd.hpp"
+#include "nanoeigenpy/decompositions/dense-solver-base.hpp"
+#include "nanoeigenpy/utils/async.hpp"
+#include "nanoeigenpy/utils/object-lock.hpp"
 #include "nanoeigenpy/decompositions/svd-base.hpp"
 #include <Eigen/SVD>
 
@@ -10,16 +13,9 @@ namespace nanoeigenpy {
 namespace nb = nanobind;
 using namespace nb::literals;
 
-template <typename MatrixOrVector, typename JacobiSVD>
-MatrixOrVector solve(const JacobiSVD &c, const MatrixOrVector &vec) {
-  return c.solve(vec);
-}
-
 template <typename JacobiSVD>
 struct JacobiSVDVisitor : nb::def_visitor<JacobiSVDVisitor<JacobiSVD>> {
   using MatrixType = typename JacobiSVD::MatrixType;
-  using Scalar = typename MatrixType::Scalar;
-  using VectorType = Eigen::Matrix<Scalar, -1, 1>;
 
   template <typename... Ts>
   void execute(nb::class_<JacobiSVD, Ts...> &cl) {
@@ -34,38 +30,17 @@ struct JacobiSVDVisitor : nb::def_visitor<JacobiSVDVisitor<JacobiSVD>> {
 
         .def(SVDBaseVisitor())
 
-        .def(
-            "compute",
-            [](JacobiSVD &c, const MatrixType &matrix) -> JacobiSVD & {
-              return c.compute(matrix);
-            },
-            "matrix"_a, "Computes the SVD of given matrix.",
-            nb::rv_policy::reference)
-        .def(
-            "compute",
+        .def(DenseComputeVisitor<MatrixType>(
+            "Computes the SVD of given matrix."))
+        .def(computeMethod(
             [](JacobiSVD &c, const MatrixType &matrix,
                unsigned int computationOptions) -> JacobiSVD & {
               return c.compute(matrix, computationOptions);
             },
             "matrix"_a, "computationOptions"_a,
-            "Computes the SVD of given matrix.", nb::rv_policy::reference)
+            "Computes the SVD of given matrix."))
 
-        .def(
-            "solve",
-            [](const JacobiSVD &c, const VectorType &b) -> VectorType {
-              return solve(c, b);
-            },
-            "b"_a,
-            "Returns the solution x of A x = b using the current "
-            "decomposition of A.")
-        .def(
-            "solve",
-            [](const JacobiSVD &c, const MatrixType &B) -> MatrixType {
-              return solve(c, B);
-            },
-            "B"_a,
-            "Returns the solution X of A X = B using the current "
-            "decomposition of A where B is a right hand side matrix.");
+        .def(DenseSolveVisitor<MatrixType>());
   }
 
   static void expose(nb::module_ &m, const char *name) {
@@ -74,6 +49,7 @@ struct JacobiSVDVisitor : nb::def_visitor<JacobiSVDVisitor<JacobiSVD>> {
     }
     nb::class_<JacobiSVD>(m, name)
         .def(JacobiSVDVisitor<JacobiSVD>())
+        .def(AsyncVisitor<typename JacobiSVD::MatrixType>())
         .def(IdVisitor());
   }
 };
@@ -3,6 +3,11 @@
 #pragma once
 
 #include "nanoeigenpy/fwd.hpp"
+#include "nanoeigenpy/decompositions/cholesky-rank-update.hpp"
+#include "nanoeigenpy/decompositions/dense-solver-base.hpp"
+#include "nanoeigenpy/utils/async.hpp"
+#include "nanoeigenpy/utils/views.hpp"
+#include "nanoeigenpy/utils/object-lock.hpp"
 #include "nanoeigenpy/eigen-base.hpp"
 #include <Eigen/Cholesky>
 
@@ -10,12 +15,6 @@ namespace nanoeigenpy {
 namespace nb = nanobind;
 using namespace nb::literals;
 
-template <typename MatrixType, typename MatrixOrVector>
-MatrixOrVector solve(const Eigen::LDLT<MatrixType> &c,
-                     const MatrixOrVector &vec) {
-  return c.solve(vec);
-}
-
 template <typename _MatrixType>
 void exposeLDLT(nb::module_ m, const char *name) {
   using MatrixType = _MatrixType;
@@ -54,19 +53,39 @@ void exposeLDLT(nb::module_ m, const char *name) {
            "Returns true if the matrix is positive (semidefinite).")
 
       .def(
-          "matrixL", [](const Solver &c) -> MatrixType { return c.matrixL(); },
-          "Returns the lower triangular matrix L.")
-      .def(
-          "matrixU", [](const Solver &c) -> MatrixType { return c.matrixU(); },
-          "Returns the upper triangular matrix U.")
+          "matrixL",
+          [](nb::pointer_and_handle<Solver> self, bool copy) -> nb::object {
+            locks::SharedLock lock(self.p, true);
+            if (copy) return nb::cast(MatrixType(self.p->matrixL()));
+            return readOnlyView(self, self.p->matrixLDLT());
+          },
+          "copy"_a = false,
+          "Returns a read-only view of matrixLDLT(), whose strictly lower "
+          "triangular part is the one of the unit lower triangular matrix L, "
+          "whose diagonal is D and whose strictly upper triangular part is "
+          "not specified. With copy=True, returns instead a copy of L.")
       .def(
-          "vectorD", [](const Solver &c) -> VectorType { return c.vectorD(); },
-          "Returns the coefficients of the diagonal matrix D.")
-      .def("matrixLDLT", &Solver::matrixLDLT,
-           "Returns the LDLT decomposition matrix made of the lower matrix "
-           "L, the diagonal D, then the remaining part that corresponds to "
-           "A.",
-           nb::rv_policy::reference_internal)
+          "matrixU",
+          [](nb::pointer_and_handle<Solver> self, bool copy) -> nb::object {
+            locks::SharedLock lock(self.p, true);
+            if (copy) return nb::cast(MatrixType(self.p->matrixU()));
+            return readOnlyTransposeView(self, self.p->matrixLDLT());
+          },
+          "copy"_a = Eigen::NumTraits<Scalar>::IsComplex,
+          "Returns a read-only view of the transpose of matrixLDLT(), whose "
+          "strictly upper triangular part is the one of the unit upper "
+          "triangular matrix U, whose diagonal is D and whose strictly lower "
+          "triangular part is not specified. With copy=True (the default for "
+          "complex matrices, whose U is not stored), returns instead a copy "
+          "of U.")
+      .def("vectorD", copyOrViewOf<Solver>(&Solver::vectorD),
+           "copy"_a = false,
+           "Returns a read-only view of the coefficients of the diagonal "
+           "matrix D. With copy=True, returns instead a copy.")
+      .def("matrixLDLT", readOnlyViewOf<Solver>(&Solver::matrixLDLT),
+           "Returns a read-only view of the LDLT decomposition matrix made of "
+           "the lower matrix L, the diagonal D, then the remaining part that "
+           "corresponds to A.")
 
       .def(
           "transpositionsP",
@@ -78,23 +97,30 @@ void exposeLDLT(nb::module_ m, const char *name) {
 
       .def(
           "rankUpdate",
-          [](Solver &c, const VectorType &w, Scalar sigma) -> Solver & {
-            return c.rankUpdate(w, sigma);
-          },
+          lockExclusive<Solver>(
+              [](Solver &c, const VectorType &w, Scalar sigma) -> Solver & {
+                return c.rankUpdate(w, sigma);
+              }),
           "If LDL^* = A, then it becomes A + sigma * v v^*", "w"_a, "sigma"_a)
+      .def(
+          "rankUpdate",
+          lockExclusive<Solver>(
+              [](Solver &c, const MatrixType &W, const VectorType &sigmas)
+                  -> Solver & { return rankUpdate(c, W, sigmas); }),
+          "If LDL^* = A, then it becomes A + W diag(sigmas) W^*, where W is a "
+          "n x k matrix and sigmas a vector of k signed weights. The k "
+          "rank-one updates and downdates are applied by panels of columns, "
+          "most of the work being done by matrix products, which is faster "
+          "than k calls to the rank-one rankUpdate for large matrices.",
+          "W"_a, "sigmas"_a, nb::rv_policy::reference)
 
       .def("adjoint", &Solver::adjoint,
            "Returns the adjoint, that is, a reference to the decomposition "
            "itself as if the underlying matrix is self-adjoint.",
            nb::rv_policy::reference)
 
-      .def(
-          "compute",
-          [](Solver &c, const MatrixType &matrix) -> Solver & {
-            return c.compute(matrix);
-          },
-          "matrix"_a, "Computes the LDLT of given matrix.",
-          nb::rv_policy::reference)
+      .def(DenseComputeVisitor<MatrixType>(
+          "Computes the LDLT of given matrix."))
       .def("info", &Solver::info,
            "NumericalIssue if the input contains INF or NaN values or "
            "overflow occured. Returns Success otherwise.")
@@ -108,24 +134,12 @@ void exposeLDLT(nb::module_ m, const char *name) {
            "returns the product: L L^*. This function is provided for debug "
            "purpose.")
 
-      .def(
-          "solve",
-          [](const Solver &c, const VectorType &b) -> VectorType {
-            return solve(c, b);
-          },
-          "b"_a,
-          "Returns the solution x of A x = b using the current "
-          "decomposition of A.")
-      .def(
-          "solve",
-          [](const Solver &c, const MatrixType &B) -> MatrixType {
-            return solve(c, B);
-          },
-          "B"_a,
-          "Returns the solution X of A X = B using the current "
-          "decomposition of A where B is a right hand side matrix.")
+      .def(DenseSolveVisitor<MatrixType>())
+
+      .def("setZero", lockExclusive<Solver>(&Solver::setZero),
+           "Clear any existing decomposition.")
 
-      .def("setZero", &Solver::setZero, "Clear any existing decomposition.")
+      .def(AsyncVisitor<MatrixType>())
 
       .def(IdVisitor());
 }
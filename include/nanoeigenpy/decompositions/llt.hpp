@@ -3,6 +3,11 @@
 #pragma once
 
 #include "nanoeigenpy/fwd.hpp"
+#include "nanoeigenpy/decompositions/cholesky-rank-update.hpp"
+#include "nanoeigenpy/decompositions/dense-solver-base.hpp"
+#include "nanoeigenpy/utils/async.hpp"
+#include "nanoeigenpy/utils/views.hpp"
+#include "nanoeigenpy/utils/object-lock.hpp"
 #include "nanoeigenpy/eigen-base.hpp"
 #include <Eigen/Cholesky>
 
@@ -10,12 +15,6 @@ namespace nanoeigenpy {
 namespace nb = nanobind;
 using namespace nb::literals;
 
-template <typename MatrixType, typename MatrixOrVector>
-MatrixOrVector solve(const Eigen::LLT<MatrixType> &c,
-                     const MatrixOrVector &vec) {
-  return c.solve(vec);
-}
-
 template <typename _MatrixType>
 void exposeLLT(nb::module_ m, const char *name) {
   using MatrixType = _MatrixType;
@@ -50,45 +49,75 @@ void exposeLLT(nb::module_ m, const char *name) {
       .def(EigenBaseVisitor())
 
       .def(
-          "matrixL", [](const Chol &c) -> MatrixType { return c.matrixL(); },
-          "Returns the lower triangular matrix L.")
+          "matrixL",
+          [](nb::pointer_and_handle<Chol> self, bool copy) -> nb::object {
+            locks::SharedLock lock(self.p, true);
+            if (copy) return nb::cast(MatrixType(self.p->matrixL()));
+            return readOnlyView(self, self.p->matrixLLT());
+          },
+          "copy"_a = false,
+          "Returns a read-only view of matrixLLT(), whose lower triangular "
+          "part is the lower triangular matrix L and whose strictly upper "
+          "triangular part is not specified. With copy=True, returns instead "
+          "a copy of L.")
       .def(
-          "matrixU", [](const Chol &c) -> MatrixType { return c.matrixU(); },
-          "Returns the upper triangular matrix U.")
-      .def("matrixLLT", &Chol::matrixLLT,
-           "Returns the LLT decomposition matrix made of the lower matrix "
-           "L, plus the remaining part that corresponds to A.",
-           nb::rv_policy::reference_internal)
+          "matrixU",
+          [](nb::pointer_and_handle<Chol> self, bool copy) -> nb::object {
+            locks::SharedLock lock(self.p, true);
+            if (copy) return nb::cast(MatrixType(self.p->matrixU()));
+            return readOnlyTransposeView(self, self.p->matrixLLT());
+          },
+          "copy"_a = Eigen::NumTraits<Scalar>::IsComplex,
+          "Returns a read-only view of the transpose of matrixLLT(), whose "
+          "upper triangular part is the upper triangular matrix U and whose "
+          "strictly lower triangular part is not specified. With copy=True "
+          "(the default for complex matrices, whose U is not stored), returns "
+          "instead a copy of U.")
+      .def("matrixLLT", readOnlyViewOf<Chol>(&Chol::matrixLLT),
+           "Returns a read-only view of the LLT decomposition matrix made of "
+           "the lower matrix L, plus the remaining part that corresponds to "
+           "A.")
 
 #if EIGEN_VERSION_AT_LEAST(3, 3, 90)
       .def(
           "rankUpdate",
-          [](Chol &c, const VectorType &w, Scalar sigma) -> Chol & {
-            return c.rankUpdate(w, sigma);
-          },
+          lockExclusive<Chol>(
+              [](Chol &c, const VectorType &w, Scalar sigma) -> Chol & {
+                return c.rankUpdate(w, sigma);
+              }),
           "If LL^* = A, then it becomes A + sigma * v v^*", "w"_a, "sigma"_a,
           nb::rv_policy::reference)
 #else
       .def(
           "rankUpdate",
-          [](Chol &c, const VectorType &w, Scalar sigma) -> Chol & {
-            return c.rankUpdate(w, sigma);
-          },
+          lockExclusive<Chol>(
+              [](Chol &c, const VectorType &w, Scalar sigma) -> Chol & {
+                return c.rankUpdate(w, sigma);
+              }),
           "If LL^* = A, then it becomes A + sigma * v v^*", "w"_a, "sigma"_a)
 #endif
+      .def(
+          "rankUpdate",
+          lockExclusive<Chol>(
+              [](Chol &c, const MatrixType &W,
+                 const VectorType &sigmas) -> Chol & {
+                return rankUpdate(c, W, sigmas);
+              }),
+          "If LL^* = A, then it becomes A + W diag(sigmas) W^*, where W is a "
+          "n x k matrix and sigmas a vector of k signed weights. The k "
+          "rank-one updates and downdates are applied by panels of columns, "
+          "most of the work being done by matrix products, which is faster "
+          "than k calls to the rank-one rankUpdate for large matrices. info() "
+          "is set to NumericalIssue if a downdate makes the matrix not "
+          "positive definite.",
+          "W"_a, "sigmas"_a, nb::rv_policy::reference)
 
       .def("adjoint", &Chol::adjoint,
            "Returns the adjoint, that is, a reference to the decomposition "
            "itself as if the underlying matrix is self-adjoint.",
            nb::rv_policy::reference)
 
-      .def(
-          "compute",
-          [](Chol &c, const MatrixType &matrix) -> Chol & {
-            return c.compute(matrix);
-          },
-          "matrix"_a, "Computes the LDLT of given matrix.",
-          nb::rv_policy::reference)
+      .def(DenseComputeVisitor<MatrixType>("Computes the LLT of given matrix."))
       .def("info", &Chol::info,
            "NumericalIssue if the input contains INF or NaN values or "
            "overflow occured. Returns Success otherwise.")
@@ -102,22 +131,9 @@ void exposeLLT(nb::module_ m, const char *name) {
            "returns the product: L L^*. This function is provided for debug "
            "purpose.")
 
-      .def(
-          "solve",
-          [](const Chol &c, const VectorType &b) -> VectorType {
-            return solve(c, b);
-          },
-          "b"_a,
-          "Returns the solution x of A x = b using the current "
-          "decomposition of A.")
-      .def(
-          "solve",
-          [](const Chol &c, const MatrixType &B) -> MatrixType {
-            return solve(c, B);
-          },
-          "B"_a,
-          "Returns the solution X of A X = B using the current "
-          "decomposition of A where B is a right hand side matrix.")
+      .def(DenseSolveVisitor<MatrixType>())
+
+      .def(AsyncVisitor<MatrixType>())
 
       .def(IdVisitor());
 }
@@ -0,0 +1,367 @@
+/// Copyright 2025 INRIA
+
+#pragma once
+
+#include "nanoeigenpy/fwd.hpp"
+#include "nanoeigenpy/decompositions/dense-solver-base.hpp"
+#include "nanoeigenpy/utils/object-lock.hpp"
+#include <Eigen/Cholesky>
+#include <Eigen/LU>
+
+#include <cmath>
+
+namespace nanoeigenpy {
+namespace nb = nanobind;
+using namespace nb::literals;
+
+/// \brief Solves A X = B to working precision from a low precision
+/// factorization of A.
+///
+/// The matrix is factorized with \a LowDecomposition, typically the float
+/// instantiation of \a Decomposition, and each solve is followed by iterative
+/// refinement, where the residuals are computed in the working precision of
+/// \a Decomposition. When the refinement stalls, or when the low precision
+/// factorization fails, the solver falls back to \a Decomposition, which is
+/// then kept for the subsequent solves.
+///
+/// The stopping criterion is the one of LAPACK's dsgesv, applied to each
+/// column: refinement stops once ||r_j||_inf <= tolerance * sqrt(n) *
+/// ||A||_inf * ||x_j||_inf holds for every column j of the residual R and of
+/// the solution X.
+///
+/// solve() records the statistics of the refinement and may compute the
+/// fallback factorization, so that, unlike the Eigen decompositions, it is
+/// not const.
+///
+/// A zero matrix is not factorized: its solves return zero, with info()
+/// Success if the right hand side is zero, and NumericalIssue otherwise.
+template <typename _Decomposition, typename _LowDecomposition>
+class MixedPrecisionSolver {
+ public:
+  using Decomposition = _Decomposition;
+  using LowDecomposition = _LowDecomposition;
+  using MatrixType = typename Decomposition::MatrixType;
+  using Scalar = typename MatrixType::Scalar;
+  using RealScalar = typename MatrixType::RealScalar;
+  using LowScalar = typename LowDecomposition::MatrixType::Scalar;
+
+  MixedPrecisionSolver()
+      : m_anorm(0),
+        m_tolerance(Eigen::NumTraits<RealScalar>::epsilon()),
+        m_error(0),
+        m_maxIterations(30),
+        m_iterations(0),
+        m_isInitialized(false),
+        m_fallback(false),
+        m_info(Eigen::Success) {}
+
+  explicit MixedPrecisionSolver(const MatrixType &matrix)
+      : MixedPrecisionSolver() {
+    compute(matrix);
+  }
+
+  MixedPrecisionSolver &compute(const MatrixType &matrix) {
+    eigen_assert(matrix.rows() == matrix.cols() &&
+                 "MixedPrecisionSolver requires a square matrix");
+    m_matrix = matrix;
+    m_anorm = matrix.rows() > 0
+                  ? matrix.cwiseAbs().rowwise().sum().maxCoeff()
+                  : RealScalar(0);
+    m_fallback = false;
+    m_highDecomposition = Decomposition();
+    m_iterations = 0;
+    m_error = 0;
+    m_isInitialized = true;
+    m_info = Eigen::Success;
+    if (m_anorm == RealScalar(0)) return *this;
+
+    // Entries outside of the range of LowScalar would overflow.
+    const RealScalar max_low = static_cast<RealScalar>(
+        Eigen::NumTraits<LowScalar>::highest());
+    if (!(m_matrix.cwiseAbs().maxCoeff() <= max_low)) {
+      useFallback();
+      return *this;
+    }
+    m_lowDecomposition.compute(m_matrix.template cast<LowScalar>());
+    if (!lowDecompositionSucceeded()) useFallback();
+    return *this;
+  }
+
+  /// \returns the solution X of A X = B.
+  template <typename Rhs>
+  typename Rhs::PlainObject solve(const Eigen::MatrixBase<Rhs> &b) {
+    eigen_assert(m_isInitialized &&
+                 "MixedPrecisionSolver is not initialized.");
+    eigen_assert(b.rows() == m_matrix.rows() &&
+                 "MixedPrecisionSolver::solve(): invalid number of rows of "
+                 "the right hand side matrix b");
+    using PlainObject = typename Rhs::PlainObject;
+
+    m_iterations = 0;
+    if (m_anorm == RealScalar(0)) return solveZero(b);
+    if (m_fallback) return solveWithFallback(b);
+
+    PlainObject x = m_lowDecomposition.solve(b.template cast<LowScalar>())
+                        .template cast<Scalar>();
+    PlainObject r = b - m_matrix * x;
+    const RealScalar threshold =
+        m_tolerance * std::sqrt(static_cast<RealScalar>(m_matrix.rows())) *
+        m_anorm;
+    RealScalar previous = Eigen::NumTraits<RealScalar>::infinity();
+    while (true) {
+      bool converged;
+      m_error = backwardError(r, x, threshold, converged);
+      if (!(m_error == m_error)) break;
+      if (converged) {
+        m_info = Eigen::Success;
+        return x;
+      }
+      // Refinement stalls when the largest backward error of the columns
+      // does not halve anymore.
+      if (m_iterations >= m_maxIterations ||
+          m_error > RealScalar(0.5) * previous)
+        break;
+      previous = m_error;
+      x += m_lowDecomposition.solve(r.template cast<LowScalar>())
+               .template cast<Scalar>();
+      r = b - m_matrix * x;
+      ++m_iterations;
+    }
+    useFallback();
+    return solveWithFallback(b);
+  }
+
+  Eigen::Index rows() const { return m_matrix.rows(); }
+  Eigen::Index cols() const { return m_matrix.cols(); }
+
+  /// \returns Success if the last solve reached the requested accuracy,
+  /// NumericalIssue if the factorization failed in both precisions.
+  Eigen::ComputationInfo info() const {
+    eigen_assert(m_isInitialized &&
+                 "MixedPrecisionSolver is not initialized.");
+    return m_info;
+  }
+
+  /// \returns whether the solver fell back to the working precision
+  /// factorization.
+  bool usedFallback() const { return m_fallback; }
+
+  Eigen::Index iterations() const { return m_iterations; }
+  RealScalar error() const { return m_error; }
+
+  Eigen::Index maxIterations() const { return m_maxIterations; }
+  MixedPrecisionSolver &setMaxIterations(Eigen::Index max_iterations) {
+    m_maxIterations = max_iterations;
+    return *this;
+  }
+
+  RealScalar tolerance() const { return m_tolerance; }
+  MixedPrecisionSolver &setTolerance(const RealScalar &tolerance) {
+    m_tolerance = tolerance;
+    return *this;
+  }
+
+  const LowDecomposition &lowPrecisionDecomposition() const {
+    return m_lowDecomposition;
+  }
+
+ protected:
+  /// \returns the largest normwise backward error ||r_j|| / (||A|| ||x_j||)
+  /// of the columns, in infinity norm (NaN if r or x is not finite), and sets
+  /// \p converged to whether ||r_j|| <= threshold * ||x_j|| holds for every
+  /// column j.
+  template <typename Res, typename Sol>
+  RealScalar backwardError(const Eigen::MatrixBase<Res> &r,
+                           const Eigen::MatrixBase<Sol> &x,
+                           const RealScalar &threshold,
+                           bool &converged) const {
+    converged = true;
+    RealScalar error(0);
+    if (r.rows() == 0) return error;
+    for (Eigen::Index j = 0; j < r.cols(); ++j) {
+      const RealScalar rnorm = r.col(j).cwiseAbs().maxCoeff();
+      const RealScalar xnorm = x.col(j).cwiseAbs().maxCoeff();
+      if (!(rnorm == rnorm) || !(xnorm == xnorm)) {
+        converged = false;
+        return Eigen::NumTraits<RealScalar>::quiet_NaN();
+      }
+      const RealScalar column_error =
+          xnorm > 0 && m_anorm > 0 ? rnorm / (m_anorm * xnorm) : rnorm;
+      if (column_error > error) error = column_error;
+      if (!(rnorm <= threshold * xnorm)) converged = false;
+    }
+    return error;
+  }
+
+  bool lowDecompositionSucceeded() const {
+    return decompositionInfo(m_lowDecomposition) == Eigen::Success &&
+           factorMatrix(m_lowDecomposition).allFinite();
+  }
+
+  // PartialPivLU does not report failures through info().
+  template <typename Dec>
+  static auto decompositionInfo(const Dec &dec) -> decltype(dec.info()) {
+    return dec.info();
+  }
+  template <typename... Ts>
+  static Eigen::ComputationInfo decompositionInfo(const Ts &...) {
+    return Eigen::Success;
+  }
+
+  template <typename M, typename... Ts>
+  static const M &factorMatrix(const Eigen::PartialPivLU<M, Ts...> &dec) {
+    return dec.matrixLU();
+  }
+  template <typename M, int UpLo>
+  static const M &factorMatrix(const Eigen::LLT<M, UpLo> &dec) {
+    return dec.matrixLLT();
+  }
+
+  void useFallback() {
+    if (!m_fallback) {
+      m_highDecomposition.compute(m_matrix);
+      m_fallback = true;
+    }
+  }
+
+  template <typename Rhs>
+  typename Rhs::PlainObject solveWithFallback(
+      const Eigen::MatrixBase<Rhs> &b) {
+    using PlainObject = typename Rhs::PlainObject;
+    m_info = decompositionInfo(m_highDecomposition);
+    PlainObject x = m_highDecomposition.solve(b);
+    const PlainObject r = b - m_matrix * x;
+    bool converged;
+    m_error = backwardError(r, x, RealScalar(0), converged);
+    return x;
+  }
+
+  /// Solves with a zero matrix, for which the solution is zero and the
+  /// backward error is the norm of the right hand side.
+  template <typename Rhs>
+  typename Rhs::PlainObject solveZero(const Eigen::MatrixBase<Rhs> &b) {
+    using PlainObject = typename Rhs::PlainObject;
+    const PlainObject x = PlainObject::Zero(b.rows(), b.cols());
+    bool converged;
+    m_error = backwardError(b, x, RealScalar(0), converged);
+    m_info = converged ? Eigen::Success : Eigen::NumericalIssue;
+    return x;
+  }
+
+  MatrixType m_matrix;
+  LowDecomposition m_lowDecomposition;
+  Decomposition m_highDecomposition;
+  RealScalar m_anorm;
+  RealScalar m_tolerance;
+  RealScalar m_error;
+  Eigen::Index m_maxIterations;
+  Eigen::Index m_iterations;
+  bool m_isInitialized;
+  bool m_fallback;
+  Eigen::ComputationInfo m_info;
+};
+
+template <typename Decomposition, typename LowDecomposition>
+void exposeMixedPrecisionSolver(nb::module_ m, const char *name,
+                                const char *doc) {
+  using Solver = MixedPrecisionSolver<Decomposition, LowDecomposition>;
+  using MatrixType = typename Solver::MatrixType;
+  using RealScalar = typename MatrixType::RealScalar;
+
+  if (check_registration_alias<Solver>(m)) {
+    return;
+  }
+  nb::class_<Solver>(m, name, doc)
+
+      .def(nb::init<>(), "Default constructor.")
+      .def(nb::init<const MatrixType &>(), "matrix"_a,
+           "Constructs a low precision factorization from a given matrix.")
+
+      .def(DenseComputeVisitor<MatrixType>(
+          "Computes the low precision factorization of given matrix."))
+
+      .def("info", lockShared<Solver>(&Solver::info),
+           "Returns Success if the last solve reached the requested accuracy, "
+           "and NumericalIssue if the matrix could not be factorized.")
+      .def("usedFallback", lockShared<Solver>(&Solver::usedFallback),
+           "Returns whether the solver fell back to a double precision "
+           "factorization, because the refinement stalled or the low "
+           "precision factorization failed.")
+      .def("iterations", lockShared<Solver>(&Solver::iterations),
+           "Returns the number of refinement steps performed during the last "
+           "solve.")
+      .def("error", lockShared<Solver>(&Solver::error),
+           "Returns the normwise backward error |Ax-b| / (|A||x|) reached "
+           "during the last solve, measured in infinity norm. For a right "
+           "hand side matrix, it is the largest error of the columns.")
+      .def("maxIterations", &Solver::maxIterations,
+           "Returns the max number of refinement steps before falling back to "
+           "double precision.")
+      .def("setMaxIterations", lockExclusive<Solver>(&Solver::setMaxIterations),
+           "max_iterations"_a,
+           "Sets the max number of refinement steps. Default is 30.",
+           nb::rv_policy::reference)
+      .def("tolerance", &Solver::tolerance,
+           "Returns the tolerance threshold used by the stopping criteria.")
+      .def(
+          "setTolerance",
+          lockExclusive<Solver>(
+              [](Solver &c, const RealScalar &tolerance) -> Solver & {
+                return c.setTolerance(tolerance);
+              }),
+          "tolerance"_a,
+          "Sets the tolerance threshold used by the stopping criteria: "
+          "refinement stops once |r| <= tolerance * sqrt(n) * |A| |x| in "
+          "infinity norm for every column of the residual r and of the "
+          "solution x. The default value is the double machine precision.",
+          nb::rv_policy::reference)
+
+      .def("rows", &Solver::rows, "Returns the number of rows of the matrix.")
+      .def("cols", &Solver::cols, "Returns the number of cols of the matrix.")
+
+      .def(DenseSolveVisitor<MatrixType, true>(
+          "Returns the solution x of A x = b, refined to double precision.",
+          "Returns the solution X of A X = B, refined to double precision, "
+          "where B is a right hand side matrix."))
+
+      .def(IdVisitor());
+}
+
+template <typename MatrixType>
+void exposeMixedPrecisionPartialPivLU(nb::module_ m, const char *name) {
+  using LowMatrixType = Eigen::Matrix<float, MatrixType::RowsAtCompileTime,
+                                      MatrixType::ColsAtCompileTime,
+                                      MatrixType::Options>;
+  exposeMixedPrecisionSolver<Eigen::PartialPivLU<MatrixType>,
+                             Eigen::PartialPivLU<LowMatrixType>>(
+      m, name,
+      "Mixed precision LU solver with iterative refinement.\n\n"
+      "The matrix is factorized in single precision with a partial pivoting "
+      "LU decomposition, which is about twice as fast and whose factors "
+      "take half the memory of a double precision one. Solutions are then "
+      "refined with "
+      "residuals computed in double precision until they reach double "
+      "precision accuracy.\n\n"
+      "When the refinement stalls, typically for ill-conditioned matrices, "
+      "or when the single precision factorization fails, the solver falls "
+      "back to a double precision factorization.");
+}
+
+template <typename MatrixType>
+void exposeMixedPrecisionLLT(nb::module_ m, const char *name) {
+  using LowMatrixType = Eigen::Matrix<float, MatrixType::RowsAtCompileTime,
+                                      MatrixType::ColsAtCompileTime,
+                                      MatrixType::Options>;
+  exposeMixedPrecisionSolver<Eigen::LLT<MatrixType>, Eigen::LLT<LowMatrixType>>(
+      m, name,
+      "Mixed precision Cholesky solver with iterative refinement.\n\n"
+      "The symmetric positive definite matrix is factorized in single "
+      "precision with a LL^T Cholesky decomposition, and solutions are "
+      "refined with residuals computed in double precision until they reach "
+      "double precision accuracy.\n\n"
+      "When the refinement stalls, or when the single precision "
+      "factorization fails, the solver falls back to a double precision "
+      "factorization.");
+}
+
+}  // namespace nanoeigenpy
@@ -4,6 +4,7 @@
 
 #include "nanoeigenpy/fwd.hpp"
 #include "nanoeigenpy/eigen-base.hpp"
+#include "nanoeigenpy/utils/object-lock.hpp"
 #include <nanobind/operators.h>
 
 namespace nanoeigenpy {
@@ -45,21 +46,30 @@ void exposePermutationMatrix(nb::module_ m, const char *name) {
           },
           "The stored array representing the permutation.")
 
-      .def("applyTranspositionOnTheLeft",
-           &PermutationMatrix::applyTranspositionOnTheLeft, "i"_a, "j"_a,
-           "Multiplies self by the transposition (ij) on the left.")
-      .def("applyTranspositionOnTheRight",
-           &PermutationMatrix::applyTranspositionOnTheRight, "i"_a, "j"_a,
-           "Multiplies self by the transposition (ij) on the right.")
+      .def(
+          "applyTranspositionOnTheLeft",
+          lockExclusive<PermutationMatrix>(
+              &PermutationMatrix::applyTranspositionOnTheLeft),
+          "i"_a, "j"_a,
+          "Multiplies self by the transposition (ij) on the left.")
+      .def(
+          "applyTranspositionOnTheRight",
+          lockExclusive<PermutationMatrix>(
+              &PermutationMatrix::applyTranspositionOnTheRight),
+          "i"_a, "j"_a,
+          "Multiplies self by the transposition (ij) on the right.")
 
       .def(
-          "setIdentity", [](PermutationMatrix &self) { self.setIdentity(); },
+          "setIdentity",
+          lockExclusive<PermutationMatrix>(
+              [](PermutationMatrix &self) { self.setIdentity(); }),
           "Sets self to be the identity permutation matrix.")
       .def(
           "setIdentity",
-          [](PermutationMatrix &self, Eigen::DenseIndex size) {
-            self.setIdentity(size);
-          },
+          lockExclusive<PermutationMatrix>(
+              [](PermutationMatrix &self, Eigen::DenseIndex size) {
+                self.setIdentity(size);
+              }),
           "size"_a,
           "Sets self to be the identity permutation matrix of given size.")
 
@@ -80,8 +90,9 @@ void exposePermutationMatrix(nb::module_ m, const char *name) {
           },
           "Returns the inverse permutation matrix.")
 
-      .def("resize", &PermutationMatrix::resize, "size"_a,
-           "Resizes to given size.")
+      .def("resize",
+           lockExclusive<PermutationMatrix>(&PermutationMatrix::resize),
+           "size"_a, "Resizes to given size.")
 
       .def(nb::self * nb::self)
       .def(EigenBaseVisitor())
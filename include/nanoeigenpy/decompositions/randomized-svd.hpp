@@ -0,0 +1,245 @@
+/// Copyright 2025 INRIA
+
+#pragma once
+
+#include "nanoeigenpy/fwd.hpp"
+#include "nanoeigenpy/decompositions/dense-solver-base.hpp"
+#include "nanoeigenpy/utils/object-lock.hpp"
+#include <Eigen/QR>
+#include <Eigen/SVD>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+
+namespace nanoeigenpy {
+namespace nb = nanobind;
+using namespace nb::literals;
+
+/// \brief Truncated SVD computed with the randomized range finder of Halko,
+/// Martinsson and Tropp.
+///
+/// The range of A is sampled by Y = A Omega, where Omega is a Gaussian n-by-l
+/// matrix with l = rank + oversampling, and orthonormalized with a
+/// HouseholderQR. Power iterations Y = (A A^*)^q A Omega, re-orthonormalized
+/// at each step, sharpen the spectrum when the singular values decay slowly.
+/// The SVD of the small l-by-n projection B = Q^* A is then computed with
+/// BDCSVD and lifted back to U = Q U_B.
+///
+/// The cost is dominated by the O(mnl) products with A, which go through
+/// Eigen's GEMM and are therefore multi-threaded when OpenMP is enabled.
+template <typename _MatrixType>
+class RandomizedSVD {
+ public:
+  using MatrixType = _MatrixType;
+  using Scalar = typename MatrixType::Scalar;
+  using RealScalar = typename MatrixType::RealScalar;
+  using DenseMatrix = Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic,
+                                    MatrixType::Options>;
+  using SingularValuesType = Eigen::Matrix<RealScalar, Eigen::Dynamic, 1>;
+
+  RandomizedSVD()
+      : m_rows(0),
+        m_cols(0),
+        m_oversampling(10),
+        m_powerIterations(2),
+        m_seed(0),
+        m_isInitialized(false),
+        m_info(Eigen::Success) {}
+
+  RandomizedSVD(const MatrixType &matrix, Eigen::Index rank) : RandomizedSVD() {
+    compute(matrix, rank);
+  }
+
+  /// \brief Computes the \a rank leading singular triplets of \a matrix.
+  RandomizedSVD &compute(const MatrixType &matrix, Eigen::Index rank) {
+    eigen_assert(rank >= 0 && "RandomizedSVD: the rank must be non negative");
+    m_rows = matrix.rows();
+    m_cols = matrix.cols();
+    const Eigen::Index diag_size = (std::min)(m_rows, m_cols);
+    const Eigen::Index k = (std::min)(rank, diag_size);
+    const Eigen::Index l = (std::min)(k + m_oversampling, diag_size);
+    m_isInitialized = true;
+
+    if (l == 0) {
+      m_matrixU.resize(m_rows, 0);
+      m_matrixV.resize(m_cols, 0);
+      m_singularValues.resize(0);
+      m_info = Eigen::Success;
+      return *this;
+    }
+
+    std::mt19937_64 generator(m_seed);
+    std::normal_distribution<RealScalar> distribution;
+    DenseMatrix omega(m_cols, l);
+    for (Eigen::Index j = 0; j < l; ++j)
+      for (Eigen::Index i = 0; i < m_cols; ++i)
+        omega(i, j) = Scalar(distribution(generator));
+
+    DenseMatrix q = orthonormalize(matrix * omega);
+    for (Eigen::Index it = 0; it < m_powerIterations; ++it) {
+      const DenseMatrix z = orthonormalize(matrix.adjoint() * q);
+      q = orthonormalize(matrix * z);
+    }
+
+    const DenseMatrix b = q.adjoint() * matrix;
+    Eigen::BDCSVD<DenseMatrix> svd(b,
+                                   Eigen::ComputeThinU | Eigen::ComputeThinV);
+    m_info = svd.info();
+    if (m_info != Eigen::Success) return *this;
+
+    m_singularValues = svd.singularValues().head(k);
+    m_matrixU.noalias() = q * svd.matrixU().leftCols(k);
+    m_matrixV = svd.matrixV().leftCols(k);
+    return *this;
+  }
+
+  const DenseMatrix &matrixU() const {
+    eigen_assert(m_isInitialized && "RandomizedSVD is not initialized.");
+    return m_matrixU;
+  }
+  const DenseMatrix &matrixV() const {
+    eigen_assert(m_isInitialized && "RandomizedSVD is not initialized.");
+    return m_matrixV;
+  }
+  const SingularValuesType &singularValues() const {
+    eigen_assert(m_isInitialized && "RandomizedSVD is not initialized.");
+    return m_singularValues;
+  }
+
+  /// \returns the number of computed singular triplets.
+  Eigen::Index computedRank() const { return m_singularValues.size(); }
+
+  Eigen::Index rows() const { return m_rows; }
+  Eigen::Index cols() const { return m_cols; }
+
+  Eigen::ComputationInfo info() const {
+    eigen_assert(m_isInitialized && "RandomizedSVD is not initialized.");
+    return m_info;
+  }
+
+  Eigen::Index oversampling() const { return m_oversampling; }
+  RandomizedSVD &setOversampling(Eigen::Index oversampling) {
+    eigen_assert(oversampling >= 0);
+    m_oversampling = oversampling;
+    return *this;
+  }
+
+  Eigen::Index powerIterations() const { return m_powerIterations; }
+  RandomizedSVD &setPowerIterations(Eigen::Index power_iterations) {
+    eigen_assert(power_iterations >= 0);
+    m_powerIterations = power_iterations;
+    return *this;
+  }
+
+  std::uint64_t seed() const { return m_seed; }
+  RandomizedSVD &setSeed(std::uint64_t seed) {
+    m_seed = seed;
+    return *this;
+  }
+
+ protected:
+  /// \returns an orthonormal basis of the range of \a y (thin Q factor).
+  static DenseMatrix orthonormalize(const DenseMatrix &y) {
+    Eigen::HouseholderQR<DenseMatrix> qr(y);
+    return qr.householderQ() * DenseMatrix::Identity(y.rows(), y.cols());
+  }
+
+  DenseMatrix m_matrixU;
+  DenseMatrix m_matrixV;
+  SingularValuesType m_singularValues;
+  Eigen::Index m_rows;
+  Eigen::Index m_cols;
+  Eigen::Index m_oversampling;
+  Eigen::Index m_powerIterations;
+  std::uint64_t m_seed;
+  bool m_isInitialized;
+  Eigen::ComputationInfo m_info;
+};
+
+template <typename _MatrixType>
+void exposeRandomizedSVD(nb::module_ m, const char *name) {
+  using MatrixType = _MatrixType;
+  using Solver = RandomizedSVD<MatrixType>;
+
+  if (check_registration_alias<Solver>(m)) {
+    return;
+  }
+  nb::class_<Solver>(
+      m, name,
+      "Randomized truncated SVD.\n\n"
+      "This class computes the leading singular triplets of a matrix with the "
+      "randomized range finder of Halko, Martinsson and Tropp. The range of "
+      "the matrix is sampled with a Gaussian sketch of rank + oversampling "
+      "columns, orthonormalized with a HouseholderQR, and refined with power "
+      "iterations. The SVD of the small projected matrix is then computed "
+      "with BDCSVD.\n\n"
+      "For a m-by-n matrix and a target rank k, the cost is O(mnk) instead of "
+      "the O(mn min(m, n)) of a full decomposition. The accuracy depends on "
+      "the decay of the singular values: increase the number of power "
+      "iterations when it is slow.")
+
+      .def(nb::init<>(), "Default constructor.")
+      .def(
+          "__init__",
+          [](Solver *c, const MatrixType &matrix, Eigen::Index rank,
+             Eigen::Index oversampling, Eigen::Index power_iterations,
+             std::uint64_t seed) {
+            new (c) Solver();
+            c->setOversampling(oversampling)
+                .setPowerIterations(power_iterations)
+                .setSeed(seed)
+                .compute(matrix, rank);
+          },
+          "matrix"_a, "rank"_a, "oversampling"_a = 10,
+          "powerIterations"_a = 2, "seed"_a = 0,
+          "Computes the rank leading singular triplets of the given matrix.")
+
+      .def(computeMethod(
+          [](Solver &c, const MatrixType &matrix, Eigen::Index rank)
+              -> Solver & { return c.compute(matrix, rank); },
+          "matrix"_a, "rank"_a,
+          "Computes the rank leading singular triplets of the given matrix."))
+
+      .def("matrixU", &Solver::matrixU,
+           "Returns the m-by-k matrix of the left singular vectors.",
+           nb::rv_policy::reference_internal)
+      .def("matrixV", &Solver::matrixV,
+           "Returns the n-by-k matrix of the right singular vectors.",
+           nb::rv_policy::reference_internal)
+      .def("singularValues", &Solver::singularValues,
+           "Returns the k leading singular values, sorted in decreasing "
+           "order.",
+           nb::rv_policy::reference_internal)
+      .def("computedRank", lockShared<Solver>(&Solver::computedRank),
+           "Returns the number of computed singular triplets, i.e. the "
+           "requested rank clamped to the dimensions of the matrix.")
+
+      .def("oversampling", &Solver::oversampling,
+           "Returns the number of additional sampled columns.")
+      .def("setOversampling", lockExclusive<Solver>(&Solver::setOversampling),
+           "oversampling"_a,
+           "Sets the number of additional sampled columns. Default is 10.",
+           nb::rv_policy::reference)
+      .def("powerIterations", &Solver::powerIterations,
+           "Returns the number of power iterations.")
+      .def("setPowerIterations",
+           lockExclusive<Solver>(&Solver::setPowerIterations),
+           "powerIterations"_a,
+           "Sets the number of power iterations. Default is 2.",
+           nb::rv_policy::reference)
+      .def("seed", &Solver::seed,
+           "Returns the seed of the random sketching matrix.")
+      .def("setSeed", lockExclusive<Solver>(&Solver::setSeed), "seed"_a,
+           "Sets the seed of the random sketching matrix. Default is 0.",
+           nb::rv_policy::reference)
+
+      .def("rows", &Solver::rows, "Returns the number of rows of the matrix.")
+      .def("cols", &Solver::cols, "Returns the number of cols of the matrix.")
+      .def("info", &Solver::info,
+           "Reports whether previous computation was successful.")
+
+      .def(IdVisitor());
+}
+
+}  // namespace nanoeigenpy
@@ -3,6 +3,8 @@
 #pragma once
 
 #include "nanoeigenpy/fwd.hpp"
+#include "nanoeigenpy/decompositions/dense-solver-base.hpp"
+#include "nanoeigenpy/utils/object-lock.hpp"
 #include <Eigen/Eigenvalues>
 
 namespace nanoeigenpy {
@@ -38,28 +40,26 @@ void exposeRealQZ(nb::module_ m, const char *name) {
            "Returns matrix T in the QZ decomposition.",
            nb::rv_policy::reference_internal)
 
-      .def(
-          "compute",
+      .def(computeMethod(
           [](Solver &c, const MatrixType &A, const MatrixType &B) -> Solver & {
             return c.compute(A, B);
           },
-          "A"_a, "B"_a, "Computes QZ decomposition of given matrix. ",
-          nb::rv_policy::reference)
+          "A"_a, "B"_a, "Computes QZ decomposition of given matrix. "))
 
-      .def(
-          "compute",
+      .def(computeMethod(
           [](Solver &c, const MatrixType &A, const MatrixType &B,
-             bool computeQZ) -> Solver & { return c.compute(A, B, computeQZ); },
+             bool computeQZ) -> Solver & {
+            return c.compute(A, B, computeQZ);
+          },
           "A"_a, "B"_a, "computeQZ"_a,
-          "Computes QZ decomposition of given matrix. ",
-          nb::rv_policy::reference)
+          "Computes QZ decomposition of given matrix. "))
 
       .def("info", &Solver::info,
            "Reports whether previous computation was successful.")
 
       .def("iterations", &Solver::iterations,
            "Returns number of performed QR-like iterations.")
-      .def("setMaxIterations", &Solver::setMaxIterations,
+      .def("setMaxIterations", lockExclusive<Solver>(&Solver::setMaxIterations),
            "Sets the maximum number of iterations allowed.",
            nb::rv_policy::reference)
 
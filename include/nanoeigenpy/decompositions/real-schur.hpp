@@ -3,6 +3,9 @@
 #pragma once
 
 #include "nanoeigenpy/fwd.hpp"
+#include "nanoeigenpy/decompositions/dense-solver-base.hpp"
+#include "nanoeigenpy/utils/workspace.hpp"
+#include "nanoeigenpy/utils/object-lock.hpp"
 #include <Eigen/Eigenvalues>
 
 namespace nanoeigenpy {
@@ -32,29 +35,24 @@ void exposeRealSchur(nb::module_ m, const char *name) {
            "Returns the quasi-triangular matrix in the Schur decomposition.",
            nb::rv_policy::reference_internal)
 
-      .def(
-          "compute",
-          [](Solver &c, const MatrixType &matrix) -> Solver & {
-            return c.compute(matrix);
-          },
-          "matrix"_a, "Computes Schur decomposition of given matrix.",
-          nb::rv_policy::reference)
+      .def(DenseComputeVisitor<MatrixType, true>(
+          "Computes Schur decomposition of given matrix."))
 
-      .def(
-          "compute",
+      .def(computeMethod(
           [](Solver &c, const MatrixType &matrix, bool computeU) -> Solver & {
+            WorkspaceScope workspace;
             return c.compute(matrix, computeU);
           },
           "matrix"_a, "computeU"_a,
-          "Computes Schur decomposition of given matrix.",
-          nb::rv_policy::reference)
+          "Computes Schur decomposition of given matrix."))
 
       .def(
           "computeFromHessenberg",
-          [](Solver &c, const MatrixType &matrixH, const MatrixType &matrixQ,
-             bool computeU) -> Solver & {
-            return c.computeFromHessenberg(matrixH, matrixQ, computeU);
-          },
+          lockExclusive<Solver>(
+              [](Solver &c, const MatrixType &matrixH,
+                 const MatrixType &matrixQ, bool computeU) -> Solver & {
+                return c.computeFromHessenberg(matrixH, matrixQ, computeU);
+              }),
           "matrixH"_a, "matrixQ"_a, "computeU"_a,
           "Computes Schur decomposition of a Hessenberg matrix H = Z T Z^T",
           nb::rv_policy::reference)
@@ -62,7 +60,7 @@ void exposeRealSchur(nb::module_ m, const char *name) {
       .def("info", &Solver::info,
            "Reports whether previous computation was successful.")
 
-      .def("setMaxIterations", &Solver::setMaxIterations,
+      .def("setMaxIterations", lockExclusive<Solver>(&Solver::setMaxIterations),
            "Sets the maximum number of iterations allowed.",
            nb::rv_policy::reference)
       .def("getMaxIterations", &Solver::getMaxIterations,
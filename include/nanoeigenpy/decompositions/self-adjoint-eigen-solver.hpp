@@ -3,6 +3,9 @@
 #pragma once
 
 #include "nanoeigenpy/fwd.hpp"
+#include "nanoeigenpy/decompositions/dense-solver-base.hpp"
+#include "nanoeigenpy/utils/views.hpp"
+#include "nanoeigenpy/utils/object-lock.hpp"
 #include <Eigen/Eigenvalues>
 
 namespace nanoeigenpy {
@@ -13,8 +16,6 @@ template <typename _MatrixType>
 void exposeSelfAdjointEigenSolver(nb::module_ m, const char *name) {
   using MatrixType = _MatrixType;
   using Solver = Eigen::SelfAdjointEigenSolver<MatrixType>;
-  using Scalar = typename MatrixType::Scalar;
-  using VectorType = Eigen::Matrix<Scalar, Eigen::Dynamic, 1>;
 
   if (check_registration_alias<Solver>(m)) {
     return;
@@ -28,49 +29,42 @@ void exposeSelfAdjointEigenSolver(nb::module_ m, const char *name) {
            "matrix"_a, "options"_a = Eigen::ComputeEigenvectors,
            "Computes eigendecomposition of given matrix")
 
-      .def(
-          "eigenvalues",
-          [](const Solver &c) -> const VectorType & { return c.eigenvalues(); },
-          "Returns the eigenvalues of given matrix.",
-          nb::rv_policy::reference_internal)
-      .def(
-          "eigenvectors",
-          [](const Solver &c) -> const MatrixType & {
-            return c.eigenvectors();
-          },
-          "Returns the eigenvectors of given matrix.",
-          nb::rv_policy::reference_internal)
+      .def("eigenvalues", copyOrViewOf<Solver>(&Solver::eigenvalues),
+           "copy"_a = false,
+           "Returns a read-only view of the eigenvalues of given matrix. With "
+           "copy=True, returns instead a copy.")
+      .def("eigenvectors", copyOrViewOf<Solver>(&Solver::eigenvectors),
+           "copy"_a = false,
+           "Returns a read-only view of the eigenvectors of given matrix. "
+           "With copy=True, returns instead a copy.")
 
-      .def(
-          "compute",
-          [](Solver &c, const MatrixType &matrix) -> Solver & {
-            return c.compute(matrix);
-          },
-          "matrix"_a, "Computes the eigendecomposition of given matrix.",
-          nb::rv_policy::reference)
-      .def(
-          "compute",
+      .def(DenseComputeVisitor<MatrixType>(
+          "Computes the eigendecomposition of given matrix."))
+      .def(computeMethod(
           [](Solver &c, const MatrixType &matrix, int options) -> Solver & {
             return c.compute(matrix, options);
           },
           "matrix"_a, "options"_a,
-          "Computes the eigendecomposition of given matrix.",
-          nb::rv_policy::reference)
+          "Computes the eigendecomposition of given matrix."))
 
       .def(
           "computeDirect",
-          [](Solver &c, const MatrixType &matrix) -> Solver & {
-            return c.computeDirect(matrix);
-          },
+          lockExclusive<Solver>(
+              [](Solver &c, const MatrixType &matrix) -> Solver & {
+                views::detachViews(&c);
+                return c.computeDirect(matrix);
+              }),
           "matrix"_a,
           "Computes eigendecomposition of given matrix using a closed-form "
           "algorithm.",
           nb::rv_policy::reference)
       .def(
           "computeDirect",
-          [](Solver &c, const MatrixType &matrix, int options) -> Solver & {
-            return c.computeDirect(matrix, options);
-          },
+          lockExclusive<Solver>(
+              [](Solver &c, const MatrixType &matrix, int options) -> Solver & {
+                views::detachViews(&c);
+                return c.computeDirect(matrix, options);
+              }),
           "matrix"_a, "options"_a,
           "Computes eigendecomposition of given matrix using a closed-form "
           "algorithm.",
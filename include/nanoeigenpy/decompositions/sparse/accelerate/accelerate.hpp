@@ -5,6 +5,7 @@
 #include "nanoeigenpy/fwd.hpp"
 #include "nanoeigenpy/id.hpp"
 #include "nanoeigenpy/decompositions/sparse/sparse-solver-base.hpp"
+#include "nanoeigenpy/utils/object-lock.hpp"
 
 #include <Eigen/AccelerateSupport>
 
@@ -30,33 +31,13 @@ struct AccelerateImplVisitor
              "This constructor is a shortcut for the default constructor "
              "followed by a call to compute().")
 
-        .def("analyzePattern", &Solver::analyzePattern,
-             "Performs a symbolic decomposition on the sparcity of matrix.\n"
-             "This function is particularly useful when solving for several "
-             "problems having the same structure.")
-
         .def(SparseSolverBaseVisitor())
 
-        .def(
-            "compute",
-            [](Solver& c, const MatrixType& matrix) {
-              return c.compute(matrix);
-            },
-            "matrix"_a,
-            "Computes the sparse Cholesky decomposition of a given matrix.",
-            nb::rv_policy::reference)
-
-        .def("factorize", &Solver::factorize, "matrix"_a,
-             "Performs a numeric decomposition of a given matrix.\n"
-             "The given matrix must has the same sparcity than the matrix on "
-             "which the symbolic decomposition has been performed.\n"
-             "See also analyzePattern().")
-
         .def("info", &Solver::info,
              "NumericalIssue if the input contains INF or NaN values or "
              "overflow occured. Returns Success otherwise.")
 
-        .def("setOrder", &Solver::setOrder, "Set order");
+        .def("setOrder", lockExclusive<Solver>(&Solver::setOrder), "Set order");
   }
 
   static void expose(nb::module_& m, const char* name, const char* doc) {
@@ -0,0 +1,495 @@
+/// Copyright 2025 INRIA
+
+#pragma once
+
+#include "nanoeigenpy/fwd.hpp"
+#include "nanoeigenpy/decompositions/sparse/sparse-solver-base.hpp"
+#include <nanobind/stl/string.h>
+#include <Eigen/SparseCholesky>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace nanoeigenpy {
+namespace nb = nanobind;
+using namespace nb::literals;
+
+namespace detail {
+
+/// \brief Layout of the on-disk Cholesky factor files.
+///
+/// The file starts with a fixed-size header, followed by the sections of the
+/// factor (column pointers, row indices, values of L, diagonal D and
+/// permutation indices). Every section starts on a page boundary, so that
+/// mapping the file gives naturally aligned arrays and touches only the pages
+/// which are actually read by the solves.
+struct CholeskyFactorFileHeader {
+  char magic[8];
+  std::uint32_t version;
+  std::uint32_t byte_order;
+  std::uint32_t scalar_size;
+  std::uint32_t scalar_is_complex;
+  std::uint32_t index_size;
+  std::uint32_t unit_diagonal;
+  std::int64_t size;
+  std::int64_t non_zeros;
+  std::uint64_t outer_offset;
+  std::uint64_t inner_offset;
+  std::uint64_t values_offset;
+  std::uint64_t diagonal_offset;
+  std::uint64_t permutation_offset;
+  std::uint64_t file_size;
+};
+
+static constexpr char kCholeskyFactorMagic[8] = {'N', 'E', 'P', 'Y',
+                                                 'C', 'H', 'O', 'L'};
+static constexpr std::uint32_t kCholeskyFactorVersion = 1;
+static constexpr std::uint32_t kCholeskyFactorByteOrder = 0x01020304;
+static constexpr std::uint64_t kCholeskyFactorPageSize = 4096;
+
+inline std::uint64_t alignToPage(std::uint64_t offset) {
+  return (offset + kCholeskyFactorPageSize - 1) / kCholeskyFactorPageSize *
+         kCholeskyFactorPageSize;
+}
+
+/// \brief Read-only memory mapping of a whole file.
+class MappedFile {
+ public:
+  MappedFile() = default;
+
+  explicit MappedFile(const std::string &path) {
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                              nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL,
+                              nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+      throw std::runtime_error("Unable to open file " + path);
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file, &file_size)) {
+      CloseHandle(file);
+      throw std::runtime_error("Unable to get the size of file " + path);
+    }
+    m_size = static_cast<std::size_t>(file_size.QuadPart);
+    if (m_size > 0) {
+      HANDLE mapping =
+          CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+      if (mapping == nullptr) {
+        CloseHandle(file);
+        throw std::runtime_error("Unable to map file " + path);
+      }
+      m_data = static_cast<const char *>(
+          MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+      CloseHandle(mapping);
+    }
+    CloseHandle(file);
+    if (m_size > 0 && m_data == nullptr)
+      throw std::runtime_error("Unable to map file " + path);
+#else
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) throw std::runtime_error("Unable to open file " + path);
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+      ::close(fd);
+      throw std::runtime_error("Unable to get the size of file " + path);
+    }
+    m_size = static_cast<std::size_t>(st.st_size);
+    if (m_size > 0) {
+      void *data = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (data == MAP_FAILED) {
+        ::close(fd);
+        throw std::runtime_error("Unable to map file " + path);
+      }
+      m_data = static_cast<const char *>(data);
+    }
+    // The mapping stays valid after the descriptor is closed.
+    ::close(fd);
+#endif
+  }
+
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+
+  MappedFile(MappedFile &&other) noexcept
+      : m_data(other.m_data), m_size(other.m_size) {
+    other.m_data = nullptr;
+    other.m_size = 0;
+  }
+
+  MappedFile &operator=(MappedFile &&other) noexcept {
+    if (this != &other) {
+      release();
+      std::swap(m_data, other.m_data);
+      std::swap(m_size, other.m_size);
+    }
+    return *this;
+  }
+
+  ~MappedFile() { release(); }
+
+  const char *data() const { return m_data; }
+  std::size_t size() const { return m_size; }
+
+ private:
+  void release() {
+    if (m_data == nullptr) return;
+#ifdef _WIN32
+    UnmapViewOfFile(m_data);
+#else
+    ::munmap(const_cast<char *>(m_data), m_size);
+#endif
+    m_data = nullptr;
+    m_size = 0;
+  }
+
+  const char *m_data = nullptr;
+  std::size_t m_size = 0;
+};
+
+/// \brief Writes a Cholesky factor P A P^T = L D L^T (or L L^T) to \a path.
+///
+/// \param outer, inner, values Compressed column storage of L.
+/// \param diagonal D, or nullptr for a LL^T factor.
+/// \param unit_diagonal Whether the diagonal of L is implicitly one (the
+/// stored diagonal coefficients, if any, are then ignored).
+/// \param permutation Indices of P, or nullptr for the identity.
+template <typename Scalar, typename StorageIndex>
+void writeCholeskyFactor(const std::string &path, Eigen::Index size,
+                         const StorageIndex *outer, const StorageIndex *inner,
+                         const Scalar *values, const Scalar *diagonal,
+                         bool unit_diagonal, const StorageIndex *permutation) {
+  const Eigen::Index non_zeros = outer[size];
+
+  CholeskyFactorFileHeader header;
+  std::memset(&header, 0, sizeof(header));
+  std::memcpy(header.magic, kCholeskyFactorMagic, sizeof(header.magic));
+  header.version = kCholeskyFactorVersion;
+  header.byte_order = kCholeskyFactorByteOrder;
+  header.scalar_size = sizeof(Scalar);
+  header.scalar_is_complex = Eigen::NumTraits<Scalar>::IsComplex ? 1 : 0;
+  header.index_size = sizeof(StorageIndex);
+  header.unit_diagonal = unit_diagonal ? 1 : 0;
+  header.size = size;
+  header.non_zeros = non_zeros;
+
+  const std::uint64_t n = static_cast<std::uint64_t>(size);
+  const std::uint64_t nnz = static_cast<std::uint64_t>(non_zeros);
+  header.outer_offset = alignToPage(sizeof(header));
+  header.inner_offset =
+      alignToPage(header.outer_offset + (n + 1) * sizeof(StorageIndex));
+  header.values_offset =
+      alignToPage(header.inner_offset + nnz * sizeof(StorageIndex));
+  header.diagonal_offset =
+      alignToPage(header.values_offset + nnz * sizeof(Scalar));
+  header.permutation_offset =
+      alignToPage(header.diagonal_offset + n * sizeof(Scalar));
+  header.file_size = header.permutation_offset + n * sizeof(StorageIndex);
+
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  if (!file) throw std::runtime_error("Unable to open file " + path);
+
+  auto write_section = [&file](std::uint64_t offset, const void *data,
+                               std::uint64_t bytes) {
+    const std::uint64_t position = static_cast<std::uint64_t>(file.tellp());
+    if (offset > position) {
+      const std::vector<char> padding(offset - position, 0);
+      file.write(padding.data(),
+                 static_cast<std::streamsize>(padding.size()));
+    }
+    if (bytes > 0)
+      file.write(static_cast<const char *>(data),
+                 static_cast<std::streamsize>(bytes));
+  };
+
+  write_section(0, &header, sizeof(header));
+  write_section(header.outer_offset, outer, (n + 1) * sizeof(StorageIndex));
+  write_section(header.inner_offset, inner, nnz * sizeof(StorageIndex));
+  write_section(header.values_offset, values, nnz * sizeof(Scalar));
+  if (diagonal != nullptr) {
+    write_section(header.diagonal_offset, diagonal, n * sizeof(Scalar));
+  } else {
+    const std::vector<Scalar> ones(static_cast<std::size_t>(n), Scalar(1));
+    write_section(header.diagonal_offset, ones.data(), n * sizeof(Scalar));
+  }
+  if (permutation != nullptr) {
+    write_section(header.permutation_offset, permutation,
+                  n * sizeof(StorageIndex));
+  } else {
+    std::vector<StorageIndex> identity(static_cast<std::size_t>(n));
+    for (std::size_t i = 0; i < identity.size(); ++i)
+      identity[i] = static_cast<StorageIndex>(i);
+    write_section(header.permutation_offset, identity.data(),
+                  n * sizeof(StorageIndex));
+  }
+
+  file.flush();
+  if (!file) throw std::runtime_error("Unable to write file " + path);
+}
+
+}  // namespace detail
+
+/// \brief Saves the factor of a SimplicialLLT decomposition to \a path.
+template <typename MatrixType, int UpLo, typename Ordering>
+void saveCholeskyFactor(
+    const Eigen::SimplicialLLT<MatrixType, UpLo, Ordering> &solver,
+    const std::string &path) {
+  if (solver.info() != Eigen::Success)
+    throw std::invalid_argument(
+        "The decomposition must be successfully computed before saving it.");
+  const auto &L = solver.matrixL().nestedExpression();
+  const auto &P = solver.permutationP();
+  detail::writeCholeskyFactor(
+      path, L.cols(), L.outerIndexPtr(), L.innerIndexPtr(), L.valuePtr(),
+      static_cast<const typename MatrixType::Scalar *>(nullptr), false,
+      P.size() > 0 ? P.indices().data() : nullptr);
+}
+
+/// \brief Saves the factors of a SimplicialLDLT decomposition to \a path.
+template <typename MatrixType, int UpLo, typename Ordering>
+void saveCholeskyFactor(
+    const Eigen::SimplicialLDLT<MatrixType, UpLo, Ordering> &solver,
+    const std::string &path) {
+  if (solver.info() != Eigen::Success)
+    throw std::invalid_argument(
+        "The decomposition must be successfully computed before saving it.");
+  const auto &L = solver.matrixL().nestedExpression();
+  const auto &P = solver.permutationP();
+  detail::writeCholeskyFactor(path, L.cols(), L.outerIndexPtr(),
+                              L.innerIndexPtr(), L.valuePtr(),
+                              solver.vectorD().data(), true,
+                              P.size() > 0 ? P.indices().data() : nullptr);
+}
+
+/// \brief Cholesky factorization P A P^T = L D L^T loaded from a file written
+/// by saveCholeskyFactor.
+///
+/// The file is memory-mapped: the values of the factor are not read eagerly,
+/// their pages are brought in by the operating system when the solves first
+/// touch them. The index arrays are read once on loading to validate them.
+template <typename _MatrixType>
+class MappedCholeskyFactor
+    : public Eigen::SparseSolverBase<MappedCholeskyFactor<_MatrixType>> {
+  using Base = Eigen::SparseSolverBase<MappedCholeskyFactor<_MatrixType>>;
+
+ public:
+  using MatrixType = _MatrixType;
+  using Scalar = typename MatrixType::Scalar;
+  using RealScalar = typename MatrixType::RealScalar;
+  using StorageIndex = typename MatrixType::StorageIndex;
+  using FactorType = Eigen::SparseMatrix<Scalar, Eigen::ColMajor, StorageIndex>;
+  using FactorMap = Eigen::Map<const FactorType>;
+  using VectorType = Eigen::Matrix<Scalar, Eigen::Dynamic, 1>;
+  using VectorMap = Eigen::Map<const VectorType>;
+  using PermutationType =
+      Eigen::PermutationMatrix<Eigen::Dynamic, Eigen::Dynamic, StorageIndex>;
+  enum {
+    ColsAtCompileTime = Eigen::Dynamic,
+    MaxColsAtCompileTime = Eigen::Dynamic
+  };
+
+  using Base::_solve_impl;
+
+  explicit MappedCholeskyFactor(const std::string &path) : m_file(path) {
+    using detail::CholeskyFactorFileHeader;
+    const char *data = m_file.data();
+    if (m_file.size() < sizeof(CholeskyFactorFileHeader))
+      throw std::invalid_argument(path + " is not a Cholesky factor file.");
+    CholeskyFactorFileHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    if (std::memcmp(header.magic, detail::kCholeskyFactorMagic,
+                    sizeof(header.magic)) != 0)
+      throw std::invalid_argument(path + " is not a Cholesky factor file.");
+    if (header.version != detail::kCholeskyFactorVersion)
+      throw std::invalid_argument(
+          path + " has an unsupported format version (" +
+          std::to_string(header.version) + ", expected " +
+          std::to_string(detail::kCholeskyFactorVersion) + ").");
+    if (header.byte_order != detail::kCholeskyFactorByteOrder)
+      throw std::invalid_argument(path + " was written with another byte "
+                                         "order.");
+    if (header.scalar_size != sizeof(Scalar) ||
+        header.scalar_is_complex !=
+            (Eigen::NumTraits<Scalar>::IsComplex ? 1u : 0u) ||
+        header.index_size != sizeof(StorageIndex))
+      throw std::invalid_argument(
+          path + " holds a factor of another scalar or index type.");
+    const std::string corrupted = path + " is truncated or corrupted.";
+    if (header.size < 0 || header.non_zeros < 0 ||
+        header.file_size > m_file.size())
+      throw std::invalid_argument(corrupted);
+
+    m_size = header.size;
+    m_nonZeros = header.non_zeros;
+    m_unitDiagonal = header.unit_diagonal != 0;
+    const std::uint64_t n = static_cast<std::uint64_t>(m_size);
+    const std::uint64_t nnz = static_cast<std::uint64_t>(m_nonZeros);
+    const std::uint64_t end = header.file_size;
+    if (!section(header.outer_offset, n + 1, end, m_outer) ||
+        !section(header.inner_offset, nnz, end, m_inner) ||
+        !section(header.values_offset, nnz, end, m_values) ||
+        !section(header.diagonal_offset, n, end, m_diagonal) ||
+        !section(header.permutation_offset, n, end, m_permutation))
+      throw std::invalid_argument(corrupted);
+
+    // The solves index the arrays with the stored indices: check them, so
+    // that a corrupted file cannot make them read or write out of bounds.
+    // The values are not read.
+    if (m_outer[0] != 0 || m_outer[m_size] != m_nonZeros)
+      throw std::invalid_argument(corrupted);
+    for (Eigen::Index j = 0; j < m_size; ++j)
+      if (m_outer[j + 1] < m_outer[j]) throw std::invalid_argument(corrupted);
+    for (Eigen::Index k = 0; k < m_nonZeros; ++k)
+      if (m_inner[k] < 0 || m_inner[k] >= m_size)
+        throw std::invalid_argument(corrupted);
+    std::vector<bool> seen(static_cast<std::size_t>(m_size), false);
+    for (Eigen::Index i = 0; i < m_size; ++i) {
+      const StorageIndex p = m_permutation[i];
+      if (p < 0 || p >= m_size || seen[static_cast<std::size_t>(p)])
+        throw std::invalid_argument(corrupted);
+      seen[static_cast<std::size_t>(p)] = true;
+    }
+    this->m_isInitialized = true;
+  }
+
+  Eigen::Index rows() const { return m_size; }
+  Eigen::Index cols() const { return m_size; }
+  Eigen::Index nonZeros() const { return m_nonZeros; }
+  Eigen::ComputationInfo info() const { return Eigen::Success; }
+
+  /// \returns true if the stored factorization is a LDL^T one.
+  bool isLDLT() const { return m_unitDiagonal; }
+
+  /// \returns a read-only view of the factor L, mapped from the file.
+  FactorMap matrixL() const {
+    return FactorMap(m_size, m_size, m_nonZeros, m_outer, m_inner, m_values);
+  }
+
+  /// \returns a read-only view of the diagonal D (ones for a LL^T factor).
+  VectorMap vectorD() const { return VectorMap(m_diagonal, m_size); }
+
+  PermutationType permutationP() const {
+    PermutationType P(m_size);
+    std::copy(m_permutation, m_permutation + m_size, P.indices().data());
+    return P;
+  }
+
+  template <typename Rhs, typename Dest>
+  void _solve_impl(const Eigen::MatrixBase<Rhs> &b,
+                   Eigen::MatrixBase<Dest> &dest) const {
+    eigen_assert(m_size == b.rows());
+    Dest &x = dest.derived();
+    for (Eigen::Index i = 0; i < m_size; ++i)
+      x.row(m_permutation[i]) = b.row(i);
+
+    const FactorMap L = matrixL();
+    if (m_unitDiagonal) {
+      L.template triangularView<Eigen::UnitLower>().solveInPlace(x);
+      x = vectorD().asDiagonal().inverse() * x;
+      L.adjoint().template triangularView<Eigen::UnitUpper>().solveInPlace(x);
+    } else {
+      L.template triangularView<Eigen::Lower>().solveInPlace(x);
+      L.adjoint().template triangularView<Eigen::Upper>().solveInPlace(x);
+    }
+
+    const typename Dest::PlainObject y = x;
+    for (Eigen::Index i = 0; i < m_size; ++i)
+      x.row(i) = y.row(m_permutation[i]);
+  }
+
+ protected:
+  /// \brief Points \p ptr to the \p count elements of type T stored at
+  /// \p offset in the file.
+  /// \returns false if they are not aligned or do not lie within the first
+  /// \p end bytes of the file.
+  template <typename T>
+  bool section(std::uint64_t offset, std::uint64_t count, std::uint64_t end,
+               const T *&ptr) const {
+    if (offset % alignof(T) != 0 || offset > end ||
+        count > (end - offset) / sizeof(T))
+      return false;
+    ptr = reinterpret_cast<const T *>(m_file.data() + offset);
+    return true;
+  }
+
+  detail::MappedFile m_file;
+  Eigen::Index m_size = 0;
+  Eigen::Index m_nonZeros = 0;
+  bool m_unitDiagonal = false;
+  const StorageIndex *m_outer = nullptr;
+  const StorageIndex *m_inner = nullptr;
+  const Scalar *m_values = nullptr;
+  const Scalar *m_diagonal = nullptr;
+  const StorageIndex *m_permutation = nullptr;
+};
+
+template <typename _MatrixType>
+void exposeMappedCholeskyFactor(nb::module_ m, const char *name) {
+  using MatrixType = _MatrixType;
+  using Solver = MappedCholeskyFactor<MatrixType>;
+  using FactorType = typename Solver::FactorType;
+  using VectorType = typename Solver::VectorType;
+
+  if (check_registration_alias<Solver>(m)) {
+    return;
+  }
+  nb::class_<Solver>(
+      m, name,
+      "A sparse Cholesky factorization loaded from a file.\n\n"
+      "The file is written by the save() method of SimplicialLLT, "
+      "SimplicialLDLT or of the Cholmod solvers, and holds the factors of "
+      "P A P^T = L D L^T in a versioned and page-aligned binary format.\n\n"
+      "Loading maps the file into memory and validates its index arrays: "
+      "the values of the factors are read lazily by the first solves, so "
+      "that the object is ready to use without refactorizing the matrix nor "
+      "reading the whole file. A truncated or corrupted file raises a "
+      "ValueError.")
+
+      .def(nb::init<const std::string &>(), "path"_a,
+           "Maps the factorization stored in the given file.")
+
+      .def(SparseSolverBaseVisitor())
+
+      .def("rows", &Solver::rows, "Returns the number of rows of the matrix.")
+      .def("cols", &Solver::cols, "Returns the number of cols of the matrix.")
+      .def("nonZeros", &Solver::nonZeros,
+           "Returns the number of non zero elements in L.")
+      .def("info", &Solver::info,
+           "Reports whether previous computation was successful.")
+      .def("isLDLT", &Solver::isLDLT,
+           "Returns true if the stored factorization is a LDL^T one, and "
+           "false if it is a LL^T one.")
+
+      .def(
+          "matrixL",
+          [](const Solver &self) -> FactorType { return self.matrixL(); },
+          "Returns the lower triangular matrix L.")
+      .def(
+          "vectorD",
+          [](const Solver &self) -> VectorType { return self.vectorD(); },
+          "Returns the diagonal vector D (ones for a LL^T factorization).")
+      .def("permutationP", &Solver::permutationP,
+           "Returns the permutation P.")
+
+      .def(IdVisitor());
+}
+
+}  // namespace nanoeigenpy
@@ -4,11 +4,320 @@
 
 #include "nanoeigenpy/fwd.hpp"
 #include "nanoeigenpy/decompositions/sparse/sparse-solver-base.hpp"
+#include "nanoeigenpy/decompositions/sparse/cholesky-factor-store.hpp"
+#include "nanoeigenpy/decompositions/sparse/selected-inversion.hpp"
+#include "nanoeigenpy/utils/object-lock.hpp"
 #include <Eigen/CholmodSupport>
 
+#include <cmath>
+#include <vector>
+
 namespace nanoeigenpy {
 using namespace nb::literals;
 
+namespace detail {
+/// \brief Access to the protected members of an Eigen Cholmod solver.
+///
+/// Eigen keeps the factor and the status as protected members of
+/// CholmodBase. Naming them through a derived class is the
+/// standard-conforming way of reaching them.
+template <typename MatrixType, int UpLo, typename Derived>
+struct CholmodBaseAccessor : Eigen::CholmodBase<MatrixType, UpLo, Derived> {
+  using Base = Eigen::CholmodBase<MatrixType, UpLo, Derived>;
+  static cholmod_factor *factor(const Base &base) {
+    return base.*(&CholmodBaseAccessor::m_cholmodFactor);
+  }
+  static void setInfo(Base &base, Eigen::ComputationInfo info) {
+    base.*(&CholmodBaseAccessor::m_info) = info;
+  }
+};
+
+/// \brief Returns the factor of \a solver, which must hold a successful
+/// factorization.
+template <typename MatrixType, int UpLo, typename Derived>
+cholmod_factor *computedCholmodFactor(
+    const Eigen::CholmodBase<MatrixType, UpLo, Derived> &solver) {
+  cholmod_factor *factor =
+      CholmodBaseAccessor<MatrixType, UpLo, Derived>::factor(solver);
+  if (factor == nullptr || solver.info() != Eigen::Success)
+    throw std::invalid_argument(
+        "The decomposition must be successfully computed before modifying "
+        "it.");
+  return factor;
+}
+
+/// \returns the position of each row of A in the factorized matrix
+/// A(Perm, Perm).
+template <typename StorageIndex>
+std::vector<StorageIndex> cholmodInversePermutation(
+    const cholmod_factor *factor) {
+  const StorageIndex *perm = static_cast<const StorageIndex *>(factor->Perm);
+  std::vector<StorageIndex> iperm(factor->n);
+  for (std::size_t k = 0; k < factor->n; ++k)
+    iperm[perm != nullptr ? static_cast<std::size_t>(perm[k]) : k] =
+        static_cast<StorageIndex>(k);
+  return iperm;
+}
+
+/// \returns the sparse matrix C(iperm, :), as expected by the Cholmod
+/// modification routines.
+template <typename SparseMatrixType, typename StorageIndex>
+Eigen::SparseMatrix<typename SparseMatrixType::Scalar, Eigen::ColMajor,
+                    StorageIndex>
+permuteRowsForCholmod(const SparseMatrixType &C,
+                      const std::vector<StorageIndex> &iperm) {
+  using Scalar = typename SparseMatrixType::Scalar;
+  std::vector<Eigen::Triplet<Scalar, StorageIndex>> triplets;
+  triplets.reserve(static_cast<std::size_t>(C.nonZeros()));
+  for (Eigen::Index j = 0; j < C.outerSize(); ++j)
+    for (typename SparseMatrixType::InnerIterator it(C, j); it; ++it)
+      triplets.emplace_back(iperm[static_cast<std::size_t>(it.row())],
+                            static_cast<StorageIndex>(it.col()), it.value());
+  Eigen::SparseMatrix<Scalar, Eigen::ColMajor, StorageIndex> permuted(
+      C.rows(), C.cols());
+  permuted.setFromTriplets(triplets.begin(), triplets.end());
+  return permuted;
+}
+
+/// \brief Reports a failed modification of the factor through info().
+template <typename MatrixType, int UpLo, typename Derived>
+void checkCholmodModification(
+    Eigen::CholmodBase<MatrixType, UpLo, Derived> &solver, int ok) {
+  if (!ok || solver.cholmod().status == CHOLMOD_NOT_POSDEF)
+    CholmodBaseAccessor<MatrixType, UpLo, Derived>::setInfo(
+        solver, Eigen::NumericalIssue);
+}
+
+/// \brief Copy of a Cholmod factor converted to a packed simplicial one, as
+/// LL^T if \a is_ll is nonzero and as LDL^T otherwise. The copy is freed
+/// with the object, so that the factor of the solver is left untouched.
+template <typename StorageIndex>
+struct SimplicialFactorCopy {
+  static constexpr bool IsLong = sizeof(StorageIndex) != sizeof(int);
+
+  SimplicialFactorCopy(cholmod_factor *source, int is_ll,
+                       cholmod_common &common)
+      : factor(IsLong ? cholmod_l_copy_factor(source, &common)
+                      : cholmod_copy_factor(source, &common)),
+        common(common) {
+    if (factor == nullptr)
+      throw std::runtime_error("Unable to copy the factor.");
+    const int status =
+        IsLong ? cholmod_l_change_factor(source->xtype, is_ll, 0, 1, 1, factor,
+                                         &common)
+               : cholmod_change_factor(source->xtype, is_ll, 0, 1, 1, factor,
+                                       &common);
+    if (!status) {
+      free();
+      throw std::runtime_error("Unable to convert the factor.");
+    }
+  }
+  SimplicialFactorCopy(const SimplicialFactorCopy &) = delete;
+  SimplicialFactorCopy &operator=(const SimplicialFactorCopy &) = delete;
+  ~SimplicialFactorCopy() { free(); }
+
+  cholmod_factor *factor;
+  cholmod_common &common;
+
+ private:
+  void free() {
+    IsLong ? cholmod_l_free_factor(&factor, &common)
+           : cholmod_free_factor(&factor, &common);
+  }
+};
+}  // namespace detail
+
+/// \brief Returns the cholmod_factor held by an Eigen Cholmod solver.
+template <typename MatrixType, int UpLo, typename Derived>
+cholmod_factor *getCholmodFactor(
+    const Eigen::CholmodBase<MatrixType, UpLo, Derived> &solver) {
+  return detail::CholmodBaseAccessor<MatrixType, UpLo, Derived>::factor(
+      solver);
+}
+
+/// \brief Updates the factorization of A into the one of A + C C^T, or of
+/// A - C C^T when \a update is false, with cholmod_updown.
+///
+/// The factor is converted to a simplicial LDL^T one by Cholmod if needed.
+/// info() is set to NumericalIssue if a downdate makes the matrix not
+/// positive definite.
+template <typename MatrixType, int UpLo, typename Derived,
+          typename SparseMatrixType>
+void cholmodUpdown(Eigen::CholmodBase<MatrixType, UpLo, Derived> &solver,
+                   const SparseMatrixType &C, bool update) {
+  using StorageIndex = typename MatrixType::StorageIndex;
+  static constexpr bool IsLong = sizeof(StorageIndex) != sizeof(int);
+
+  cholmod_factor *factor = detail::computedCholmodFactor(solver);
+  if (C.rows() != static_cast<Eigen::Index>(factor->n))
+    throw std::invalid_argument("C must have as many rows as the matrix.");
+  if (C.cols() == 0) return;
+
+  auto C_permuted = detail::permuteRowsForCholmod(
+      C, detail::cholmodInversePermutation<StorageIndex>(factor));
+  cholmod_sparse C_cholmod = Eigen::viewAsCholmod(C_permuted);
+  cholmod_common &common = solver.cholmod();
+  const int ok = IsLong ? cholmod_l_updown(update, &C_cholmod, factor, &common)
+                        : cholmod_updown(update, &C_cholmod, factor, &common);
+  detail::checkCholmodModification(solver, ok);
+}
+
+/// \brief Updates the factorization of A into the one of
+/// A + sum_j sigmas[j] W[:, j] W[:, j]^T, with cholmod_updown.
+///
+/// The columns are gathered by sign, so that it takes at most one update and
+/// one downdate.
+template <typename MatrixType, int UpLo, typename Derived, typename WType,
+          typename SigmaType>
+void cholmodRankUpdate(Eigen::CholmodBase<MatrixType, UpLo, Derived> &solver,
+                       const Eigen::MatrixBase<WType> &W,
+                       const Eigen::MatrixBase<SigmaType> &sigmas) {
+  using Scalar = typename MatrixType::Scalar;
+  using RealScalar = typename MatrixType::RealScalar;
+  using StorageIndex = typename MatrixType::StorageIndex;
+  using ColMatrix = Eigen::SparseMatrix<Scalar, Eigen::ColMajor, StorageIndex>;
+  using DenseMatrix = Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>;
+
+  const cholmod_factor *factor = detail::computedCholmodFactor(solver);
+  if (W.rows() != static_cast<Eigen::Index>(factor->n))
+    throw std::invalid_argument("W must have as many rows as the matrix.");
+  if (W.cols() != sigmas.size())
+    throw std::invalid_argument("W must have one column per sigma.");
+
+  for (const bool update : {true, false}) {
+    std::vector<Eigen::Index> columns;
+    for (Eigen::Index j = 0; j < sigmas.size(); ++j) {
+      const RealScalar sigma = Eigen::numext::real(sigmas[j]);
+      if (update ? sigma > 0 : sigma < 0) columns.push_back(j);
+    }
+    if (columns.empty()) continue;
+
+    DenseMatrix C(W.rows(), static_cast<Eigen::Index>(columns.size()));
+    for (Eigen::Index c = 0; c < C.cols(); ++c) {
+      const Eigen::Index j = columns[static_cast<std::size_t>(c)];
+      C.col(c) = std::sqrt(std::abs(Eigen::numext::real(sigmas[j]))) * W.col(j);
+    }
+    cholmodUpdown(solver, ColMatrix(C.sparseView()), update);
+    if (solver.info() != Eigen::Success) return;
+  }
+}
+
+/// \brief Adds the row and column \a k to the factorization, whose row and
+/// column \a k must be the ones of the identity (e.g. after
+/// cholmodRowDelete()). \a column is the column \a k of the new matrix,
+/// diagonal included.
+template <typename MatrixType, int UpLo, typename Derived,
+          typename SparseMatrixType>
+void cholmodRowAdd(Eigen::CholmodBase<MatrixType, UpLo, Derived> &solver,
+                   Eigen::Index k, const SparseMatrixType &column) {
+  using StorageIndex = typename MatrixType::StorageIndex;
+  static constexpr bool IsLong = sizeof(StorageIndex) != sizeof(int);
+
+  cholmod_factor *factor = detail::computedCholmodFactor(solver);
+  const Eigen::Index n = static_cast<Eigen::Index>(factor->n);
+  if (k < 0 || k >= n) throw std::out_of_range("Row index out of range.");
+  if (column.rows() != n || column.cols() != 1)
+    throw std::invalid_argument("The column must be a n x 1 vector.");
+
+  const std::vector<StorageIndex> iperm =
+      detail::cholmodInversePermutation<StorageIndex>(factor);
+  auto R = detail::permuteRowsForCholmod(column, iperm);
+  cholmod_sparse R_cholmod = Eigen::viewAsCholmod(R);
+  const std::size_t kp = static_cast<std::size_t>(iperm[k]);
+  cholmod_common &common = solver.cholmod();
+  const int ok = IsLong ? cholmod_l_rowadd(kp, &R_cholmod, factor, &common)
+                        : cholmod_rowadd(kp, &R_cholmod, factor, &common);
+  detail::checkCholmodModification(solver, ok);
+}
+
+/// \brief Deletes the row and column \a k of the factorization, which are
+/// replaced by the ones of the identity.
+template <typename MatrixType, int UpLo, typename Derived>
+void cholmodRowDelete(Eigen::CholmodBase<MatrixType, UpLo, Derived> &solver,
+                      Eigen::Index k) {
+  using StorageIndex = typename MatrixType::StorageIndex;
+  static constexpr bool IsLong = sizeof(StorageIndex) != sizeof(int);
+
+  cholmod_factor *factor = detail::computedCholmodFactor(solver);
+  if (k < 0 || k >= static_cast<Eigen::Index>(factor->n))
+    throw std::out_of_range("Row index out of range.");
+
+  const std::size_t kp = static_cast<std::size_t>(
+      detail::cholmodInversePermutation<StorageIndex>(factor)[k]);
+  cholmod_common &common = solver.cholmod();
+  const int ok = IsLong ? cholmod_l_rowdel(kp, nullptr, factor, &common)
+                        : cholmod_rowdel(kp, nullptr, factor, &common);
+  detail::checkCholmodModification(solver, ok);
+}
+
+/// \brief Saves the factor of a Cholmod decomposition to \a path.
+///
+/// Supernodal factors are converted to a simplicial one on a copy of the
+/// factor, so that the solver itself is left untouched.
+template <typename MatrixType, int UpLo, typename Derived>
+void saveCholeskyFactor(Eigen::CholmodBase<MatrixType, UpLo, Derived> &solver,
+                        const std::string &path) {
+  using Scalar = typename MatrixType::Scalar;
+  using StorageIndex = typename MatrixType::StorageIndex;
+
+  cholmod_factor *factor = getCholmodFactor(solver);
+  if (factor == nullptr || solver.info() != Eigen::Success)
+    throw std::invalid_argument(
+        "The decomposition must be successfully computed before saving it.");
+
+  const int is_ll = factor->is_ll;
+  const detail::SimplicialFactorCopy<StorageIndex> copy(factor, is_ll,
+                                                        solver.cholmod());
+  const cholmod_factor *L = copy.factor;
+
+  const Eigen::Index n = static_cast<Eigen::Index>(L->n);
+  const StorageIndex *outer = static_cast<const StorageIndex *>(L->p);
+  const StorageIndex *inner = static_cast<const StorageIndex *>(L->i);
+  const Scalar *values = static_cast<const Scalar *>(L->x);
+  const StorageIndex *perm = static_cast<const StorageIndex *>(L->Perm);
+
+  // Cholmod factorizes A(Perm, Perm), i.e. P A P^T with P^-1 = Perm.
+  std::vector<StorageIndex> indices(static_cast<std::size_t>(n));
+  for (Eigen::Index k = 0; k < n; ++k)
+    indices[static_cast<std::size_t>(perm[k])] = static_cast<StorageIndex>(k);
+  // A simplicial LDL^T factor stores D on the diagonal of L.
+  std::vector<Scalar> diagonal;
+  if (!is_ll) {
+    diagonal.resize(static_cast<std::size_t>(n));
+    for (Eigen::Index j = 0; j < n; ++j)
+      diagonal[static_cast<std::size_t>(j)] = values[outer[j]];
+  }
+
+  detail::writeCholeskyFactor(path, n, outer, inner, values,
+                              is_ll ? nullptr : diagonal.data(), !is_ll,
+                              indices.data());
+}
+
+/// \brief Runs the selected inversion on the factor of a Cholmod
+/// decomposition, converted to a simplicial LDL^T one on a copy.
+template <typename MatrixType, int UpLo, typename Derived>
+SelectedInverse<typename MatrixType::Scalar, typename MatrixType::StorageIndex>
+cholmodSelectedInverse(Eigen::CholmodBase<MatrixType, UpLo, Derived> &solver) {
+  using Scalar = typename MatrixType::Scalar;
+  using StorageIndex = typename MatrixType::StorageIndex;
+
+  cholmod_factor *factor = getCholmodFactor(solver);
+  if (factor == nullptr || solver.info() != Eigen::Success)
+    throw std::invalid_argument(
+        "The decomposition must be successfully computed before inverting "
+        "it.");
+  const detail::SimplicialFactorCopy<StorageIndex> copy(factor, 0,
+                                                        solver.cholmod());
+  const cholmod_factor *L = copy.factor;
+  // A simplicial LDL^T factor stores D as the first entry of each column.
+  SelectedInverse<Scalar, StorageIndex> inverse;
+  inverse.compute(static_cast<Eigen::Index>(L->n),
+                  static_cast<const StorageIndex *>(L->p),
+                  static_cast<const StorageIndex *>(L->i),
+                  static_cast<const Scalar *>(L->x), false);
+  return inverse;
+}
+
 struct CholmodBaseVisitor : nb::def_visitor<CholmodBaseVisitor> {
   template <typename CholdmodDerived, typename... Ts>
   void execute(nb::class_<CholdmodDerived, Ts...> &cl) {
@@ -17,33 +326,18 @@ struct CholmodBaseVisitor : nb::def_visitor<CholmodBaseVisitor> {
                   "Template type parameter Solver must inherit from "
                   "Eigen::SparseSolverBase");
     using MatrixType = typename CholdmodDerived::MatrixType;
+    using Scalar = typename MatrixType::Scalar;
+    using DenseMatrix = Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>;
+    using DenseVector = Eigen::Matrix<Scalar, Eigen::Dynamic, 1>;
+    using StorageIndex = typename MatrixType::StorageIndex;
+    using IndexVector = Eigen::Matrix<StorageIndex, Eigen::Dynamic, 1>;
 
-    cl.def("analyzePattern", &Solver::analyzePattern,
-           "Performs a symbolic decomposition on the sparcity of matrix.\n"
-           "This function is particularly useful when solving for several "
-           "problems having the same structure.")
-
-        .def(SparseSolverBaseVisitor())
-
-        .def(
-            "compute",
-            [](Solver &self, const MatrixType &matrix) -> decltype(auto) {
-              return self.compute(matrix);
-            },
-            "matrix"_a,
-            "Computes the sparse Cholesky decomposition of a given matrix.",
-            nb::rv_policy::reference)
+    cl.def(SparseSolverBaseVisitor<true>())
 
         .def("determinant", &Solver::determinant,
              "Returns the determinant of the underlying matrix from the "
              "current factorization.")
 
-        .def("factorize", &Solver::factorize, "matrix"_a,
-             "Performs a numeric decomposition of a given matrix.\n"
-             "The given matrix must has the same sparcity than the matrix on "
-             "which the symbolic decomposition has been performed.\n"
-             "See also analyzePattern().")
-
         .def("info", &Solver::info,
              "NumericalIssue if the input contains INF or NaN values or "
              "overflow occured. Returns Success otherwise.")
@@ -52,14 +346,109 @@ struct CholmodBaseVisitor : nb::def_visitor<CholmodBaseVisitor> {
              "NumericalIssue if the input contains INF or NaN values or "
              "overflow occured. Returns Success otherwise.")
 
-        .def("setShift", &Solver::setShift, "offset"_a,
+        .def("setShift", lockExclusive<Solver>(&Solver::setShift), "offset"_a,
              "Sets the shift parameters that will be used to adjust the "
              "diagonal coefficients during the numerical factorization.\n"
              "During the numerical factorization, the diagonal coefficients "
              "are transformed by the following linear model: d_ii = offset + "
              "d_ii.\n"
              "The default is the identity transformation with offset=0.",
-             nb::rv_policy::reference);
+             nb::rv_policy::reference)
+
+        .def(
+            "rankUpdate",
+            lockExclusive<Solver>([](Solver &self, const DenseMatrix &W,
+                                     const DenseVector &sigmas) -> Solver & {
+              cholmodRankUpdate(self, W, sigmas);
+              return self;
+            }),
+            "W"_a, "sigmas"_a,
+            "If LDL^T = A, then it becomes A + W diag(sigmas) W^T, where W is "
+            "a n x k matrix and sigmas a vector of k signed weights.\n"
+            "The update is applied with CHOLMOD's updown, without "
+            "refactorization. The factor is converted to a simplicial LDL^T "
+            "one if needed. info() is set to NumericalIssue if the updated "
+            "matrix is not positive definite.",
+            nb::rv_policy::reference)
+        .def(
+            "updown",
+            lockExclusive<Solver>(
+                [](Solver &self, const MatrixType &C, bool update) -> Solver & {
+                  cholmodUpdown(self, C, update);
+                  return self;
+                }),
+            "C"_a, "update"_a = true,
+            "If LDL^T = A, then it becomes A + C C^T when update is true, and "
+            "A - C C^T otherwise, where C is a sparse n x k matrix.\n"
+            "The modification is applied with CHOLMOD's updown, at a cost "
+            "proportional to the number of modified entries of L.",
+            nb::rv_policy::reference)
+        .def(
+            "rowAdd",
+            lockExclusive<Solver>(
+                [](Solver &self, Eigen::Index k, const MatrixType &column)
+                    -> Solver & {
+                  cholmodRowAdd(self, k, column);
+                  return self;
+                }),
+            "k"_a, "column"_a,
+            "Adds the row and column k to the factorization, where column is "
+            "the sparse n x 1 column k of the new matrix, diagonal included. "
+            "The row and column k of the factorized matrix must be the ones "
+            "of the identity, e.g. after rowDelete(k).\n"
+            "This is the modification applied when a constraint enters the "
+            "active set of a KKT system.",
+            nb::rv_policy::reference)
+        .def(
+            "rowDelete",
+            lockExclusive<Solver>([](Solver &self, Eigen::Index k) -> Solver & {
+              cholmodRowDelete(self, k);
+              return self;
+            }),
+            "k"_a,
+            "Deletes the row and column k of the factorization, which are "
+            "replaced by the ones of the identity.\n"
+            "This is the modification applied when a constraint leaves the "
+            "active set of a KKT system.",
+            nb::rv_policy::reference)
+
+        .def(
+            "selectedInversion",
+            lockExclusive<Solver>([](Solver &self) -> MatrixType {
+              const SelectedInverse<Scalar, StorageIndex> inverse =
+                  cholmodSelectedInverse(self);
+              const std::vector<StorageIndex> indices =
+                  detail::cholmodInversePermutation<StorageIndex>(
+                      getCholmodFactor(self));
+              return inverse.matrix(Eigen::Map<const IndexVector>(
+                  indices.data(), Eigen::Index(indices.size())));
+            }),
+            "Returns the entries of A^-1 on the sparsity pattern of the "
+            "factor, computed with Takahashi's equations at a cost "
+            "comparable to the factorization. Supernodal and LL^T factors "
+            "are converted to a simplicial LDL^T one on a copy.")
+        .def(
+            "inverseDiagonal",
+            lockExclusive<Solver>([](Solver &self) -> DenseVector {
+              const SelectedInverse<Scalar, StorageIndex> inverse =
+                  cholmodSelectedInverse(self);
+              const std::vector<StorageIndex> indices =
+                  detail::cholmodInversePermutation<StorageIndex>(
+                      getCholmodFactor(self));
+              return inverse.diagonal(Eigen::Map<const IndexVector>(
+                  indices.data(), Eigen::Index(indices.size())));
+            }),
+            "Returns the diagonal of A^-1, e.g. the marginal variances of a "
+            "Gaussian with information matrix A, by selected inversion.")
+
+        .def(
+            "save",
+            lockExclusive<Solver>([](Solver &self, const std::string &path) {
+              saveCholeskyFactor(self, path);
+            }),
+            "path"_a,
+            "Saves the factorization to a file, which can be loaded back "
+            "without refactorizing the matrix with MappedCholeskyFactor.");
   }
 };
 
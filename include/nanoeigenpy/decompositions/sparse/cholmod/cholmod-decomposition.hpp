@@ -4,6 +4,7 @@
 
 #include "nanoeigenpy/fwd.hpp"
 #include "nanoeigenpy/decompositions/sparse/cholmod/cholmod-base.hpp"
+#include "nanoeigenpy/utils/object-lock.hpp"
 
 namespace nanoeigenpy {
 
@@ -17,7 +18,7 @@ struct CholmodDecompositionVisitor
                   "Eigen::SparseSolverBase");
 
     cl.def(CholmodBaseVisitor())
-        .def("setMode", &Solver::setMode, "mode"_a,
+        .def("setMode", lockExclusive<Solver>(&Solver::setMode), "mode"_a,
              "Set the mode for the Cholesky decomposition.");
   }
 };
@@ -0,0 +1,546 @@
+/// Copyright 2025 INRIA
+
+#pragma once
+
+#include "nanoeigenpy/fwd.hpp"
+#include "nanoeigenpy/decompositions/sparse/orderings.hpp"
+#include "nanoeigenpy/utils/sparse-matrix-handle.hpp"
+#include "nanoeigenpy/utils/object-lock.hpp"
+#include <nanobind/eigen/sparse.h>
+#include <Eigen/Eigenvalues>
+#include <Eigen/SparseCholesky>
+#include <Eigen/SparseLU>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace nanoeigenpy {
+namespace nb = nanobind;
+using namespace nb::literals;
+
+/// \brief Part of the spectrum targeted by LanczosEigenSolver.
+enum LanczosSelection {
+  LargestAlgebraic,
+  SmallestAlgebraic,
+  LargestMagnitude,
+  SmallestMagnitude
+};
+
+/// \brief Thick-restart Lanczos solver for a few eigenpairs of a large sparse
+/// selfadjoint matrix.
+///
+/// The Krylov basis is kept fully reorthogonalized, and the projected matrix
+/// is diagonalized with SelfAdjointEigenSolver. When the wanted Ritz pairs
+/// have not converged, the basis is compressed to the wanted Ritz vectors plus
+/// half of the remaining ones and the Lanczos process resumes from the last
+/// residual vector (Wu and Simon, 2000).
+///
+/// Eigenvalues close to a shift sigma are obtained in shift-invert mode, which
+/// runs the iterations on (A - sigma I)^-1 using a sparse factorization of
+/// A - sigma I, as in ARPACK and Spectra.
+///
+/// Only the lower triangular part of the matrix is referenced. The
+/// computations throw std::invalid_argument if the matrix is not square or
+/// if nev is not in [1, n].
+template <typename _MatrixType>
+class LanczosEigenSolver {
+ public:
+  using MatrixType = _MatrixType;
+  using Scalar = typename MatrixType::Scalar;
+  using RealScalar = typename MatrixType::RealScalar;
+  using VectorType = Eigen::Matrix<Scalar, Eigen::Dynamic, 1>;
+  using RealVectorType = Eigen::Matrix<RealScalar, Eigen::Dynamic, 1>;
+  using DenseMatrix = Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>;
+
+  LanczosEigenSolver()
+      : m_ncv(0),
+        m_maxIterations(1000),
+        m_tolerance(RealScalar(1e-10)),
+        m_seed(0),
+        m_iterations(0),
+        m_operations(0),
+        m_isInitialized(false),
+        m_info(Eigen::Success) {}
+
+  /// \brief Computes the \a nev eigenpairs of \a matrix selected by \a
+  /// selection.
+  LanczosEigenSolver &compute(const MatrixType &matrix, Eigen::Index nev,
+                              LanczosSelection selection = LargestMagnitude) {
+    checkArguments(matrix.rows(), matrix.cols(), nev);
+    const auto op = [&matrix](const VectorType &x, VectorType &y) {
+      y.noalias() = matrix.template selfadjointView<Eigen::Lower>() * x;
+    };
+    run(op, matrix.rows(), nev, selection);
+    return *this;
+  }
+
+  /// \brief Computes the \a nev eigenpairs of \a matrix closest to \a sigma,
+  /// factorizing A - sigma I with SimplicialLDLT.
+  LanczosEigenSolver &computeShiftInvert(const MatrixType &matrix,
+                                         Eigen::Index nev,
+                                         const RealScalar &sigma) {
+    checkArguments(matrix.rows(), matrix.cols(), nev);
+    MatrixType identity(matrix.rows(), matrix.cols());
+    identity.setIdentity();
+    Eigen::SimplicialLDLT<MatrixType> factorization(
+        MatrixType(matrix - Scalar(sigma) * identity));
+    if (factorization.info() != Eigen::Success) {
+      failFactorization(matrix.rows());
+      return *this;
+    }
+    return computeShiftInvert(factorization, nev, sigma);
+  }
+
+  /// \brief Computes the \a nev eigenpairs closest to \a sigma, where \a
+  /// factorization is a computed factorization of A - sigma I.
+  ///
+  /// Any solver providing rows(), cols(), info() and solve() can be used,
+  /// e.g. SimplicialLDLT or SparseLU.
+  template <typename Factorization>
+  LanczosEigenSolver &computeShiftInvert(const Factorization &factorization,
+                                         Eigen::Index nev,
+                                         const RealScalar &sigma) {
+    checkArguments(factorization.rows(), factorization.cols(), nev);
+    if (factorization.info() != Eigen::Success) {
+      failFactorization(factorization.rows());
+      return *this;
+    }
+    const auto op = [&factorization](const VectorType &x, VectorType &y) {
+      y = factorization.solve(x);
+    };
+    // The eigenvalues nu = 1 / (lambda - sigma) of the largest magnitude
+    // correspond to the eigenvalues lambda closest to sigma.
+    run(op, factorization.rows(), nev, LargestMagnitude);
+    for (Eigen::Index i = 0; i < m_eigenvalues.size(); ++i)
+      m_eigenvalues[i] = sigma + RealScalar(1) / m_eigenvalues[i];
+    sortEigenpairs();
+    return *this;
+  }
+
+  /// \returns the computed eigenvalues, sorted in increasing order.
+  const RealVectorType &eigenvalues() const {
+    eigen_assert(m_isInitialized && "LanczosEigenSolver is not initialized.");
+    return m_eigenvalues;
+  }
+
+  /// \returns the eigenvectors as columns, in the order of eigenvalues().
+  const DenseMatrix &eigenvectors() const {
+    eigen_assert(m_isInitialized && "LanczosEigenSolver is not initialized.");
+    return m_eigenvectors;
+  }
+
+  /// \returns Success if all the requested eigenpairs converged,
+  /// NoConvergence if the max number of restarts was reached and
+  /// NumericalIssue if the shift-invert factorization failed.
+  Eigen::ComputationInfo info() const {
+    eigen_assert(m_isInitialized && "LanczosEigenSolver is not initialized.");
+    return m_info;
+  }
+
+  /// \returns the number of restarts of the last computation.
+  Eigen::Index iterations() const { return m_iterations; }
+  /// \returns the number of operator applications of the last computation.
+  Eigen::Index operations() const { return m_operations; }
+
+  Eigen::Index maxIterations() const { return m_maxIterations; }
+  LanczosEigenSolver &setMaxIterations(Eigen::Index max_iterations) {
+    m_maxIterations = max_iterations;
+    return *this;
+  }
+
+  RealScalar tolerance() const { return m_tolerance; }
+  LanczosEigenSolver &setTolerance(const RealScalar &tolerance) {
+    m_tolerance = tolerance;
+    return *this;
+  }
+
+  /// \returns the dimension of the Krylov subspace, 0 meaning
+  /// max(2 nev + 1, 20).
+  Eigen::Index subspaceSize() const { return m_ncv; }
+  LanczosEigenSolver &setSubspaceSize(Eigen::Index ncv) {
+    if (ncv < 0)
+      throw std::invalid_argument(
+          "LanczosEigenSolver: the subspace size must be nonnegative.");
+    m_ncv = ncv;
+    return *this;
+  }
+
+  std::uint64_t seed() const { return m_seed; }
+  LanczosEigenSolver &setSeed(std::uint64_t seed) {
+    m_seed = seed;
+    return *this;
+  }
+
+ protected:
+  /// \brief Checks that the operator is square and that nev is in [1, n],
+  /// before anything is computed.
+  static void checkArguments(Eigen::Index rows, Eigen::Index cols,
+                             Eigen::Index nev) {
+    if (rows != cols)
+      throw std::invalid_argument(
+          "LanczosEigenSolver: the matrix must be square.");
+    if (nev < 1 || nev > rows)
+      throw std::invalid_argument(
+          "LanczosEigenSolver: nev must be in [1, n], where n is the size "
+          "of the matrix.");
+  }
+
+  void failFactorization(Eigen::Index n) {
+    m_isInitialized = true;
+    m_info = Eigen::NumericalIssue;
+    m_iterations = 0;
+    m_operations = 0;
+    m_eigenvalues.resize(0);
+    m_eigenvectors.resize(n, 0);
+  }
+
+  /// \returns the indices of the \a count wanted Ritz values, most wanted
+  /// first.
+  static std::vector<Eigen::Index> selectRitzValues(const RealVectorType &theta,
+                                                    LanczosSelection selection,
+                                                    Eigen::Index count) {
+    std::vector<Eigen::Index> order(static_cast<std::size_t>(theta.size()));
+    std::iota(order.begin(), order.end(), Eigen::Index(0));
+    std::stable_sort(order.begin(), order.end(),
+                     [&theta, selection](Eigen::Index a, Eigen::Index b) {
+                       switch (selection) {
+                         case LargestAlgebraic:
+                           return theta[a] > theta[b];
+                         case SmallestAlgebraic:
+                           return theta[a] < theta[b];
+                         case LargestMagnitude:
+                           return std::abs(theta[a]) > std::abs(theta[b]);
+                         default:
+                           return std::abs(theta[a]) < std::abs(theta[b]);
+                       }
+                     });
+    order.resize(static_cast<std::size_t>(count));
+    return order;
+  }
+
+  /// \brief Orthogonalizes \a w against the first \a j columns of the basis
+  /// with two passes of classical Gram-Schmidt.
+  /// \returns the projection coefficients.
+  VectorType orthogonalize(Eigen::Index j, VectorType &w) const {
+    const auto basis = m_basis.leftCols(j);
+    VectorType h = basis.adjoint() * w;
+    w.noalias() -= basis * h;
+    const VectorType correction = basis.adjoint() * w;
+    w.noalias() -= basis * correction;
+    h += correction;
+    return h;
+  }
+
+  template <typename Generator>
+  void randomVector(Generator &generator, VectorType &v) const {
+    std::uniform_real_distribution<RealScalar> distribution(RealScalar(-1),
+                                                            RealScalar(1));
+    for (Eigen::Index i = 0; i < v.size(); ++i)
+      v[i] = Scalar(distribution(generator));
+  }
+
+  template <typename Operator>
+  void run(const Operator &op, Eigen::Index n, Eigen::Index nev,
+           LanczosSelection selection) {
+    // The subspace is larger than nev, except when nev = n, where the
+    // first pass builds a basis of the whole space and the restarts are not
+    // reached.
+    const Eigen::Index ncv =
+        (std::min)(n, (std::max)(m_ncv > 0 ? m_ncv : Eigen::Index(20),
+                                 2 * nev + 1));
+    eigen_assert(nev >= 1 && (ncv > nev || ncv == n));
+    const RealScalar eps = Eigen::NumTraits<RealScalar>::epsilon();
+    const RealScalar eps23 = std::pow(eps, RealScalar(2) / RealScalar(3));
+
+    m_isInitialized = true;
+    m_iterations = 0;
+    m_operations = 0;
+    m_basis.resize(n, ncv + 1);
+    DenseMatrix projected = DenseMatrix::Zero(ncv, ncv);
+    std::mt19937_64 generator(m_seed);
+
+    VectorType v(n), w(n);
+    randomVector(generator, v);
+    m_basis.col(0) = v.normalized();
+
+    // Number of locked columns of the basis at the beginning of a cycle.
+    Eigen::Index start = 0;
+    RealScalar beta = 0;
+    Eigen::SelfAdjointEigenSolver<DenseMatrix> ritz;
+    std::vector<Eigen::Index> wanted;
+    while (true) {
+      for (Eigen::Index j = start; j < ncv; ++j) {
+        op(m_basis.col(j), w);
+        ++m_operations;
+        const VectorType h = orthogonalize(j + 1, w);
+        projected.col(j).head(j + 1) = h;
+        projected.row(j).head(j + 1) = h.adjoint();
+        beta = w.norm();
+        // Breakdown: the basis spans an invariant subspace. Carry on with a
+        // random vector orthogonal to it.
+        const RealScalar scale = (std::max)(h.norm(), RealScalar(1));
+        if (beta <= eps * scale && j + 1 < n) {
+          randomVector(generator, w);
+          orthogonalize(j + 1, w);
+          m_basis.col(j + 1) = w.normalized();
+          beta = 0;
+        } else {
+          m_basis.col(j + 1) = w / (beta > 0 ? beta : RealScalar(1));
+        }
+        if (j + 1 < ncv) {
+          projected(j + 1, j) = Scalar(beta);
+          projected(j, j + 1) = Scalar(beta);
+        }
+      }
+
+      ritz.compute(projected);
+      const RealVectorType &theta = ritz.eigenvalues();
+      const DenseMatrix &y = ritz.eigenvectors();
+      wanted = selectRitzValues(theta, selection, nev);
+
+      Eigen::Index nconv = 0;
+      for (Eigen::Index i : wanted) {
+        const RealScalar residual = beta * std::abs(y(ncv - 1, i));
+        if (residual <= m_tolerance * (std::max)(eps23, std::abs(theta[i])))
+          ++nconv;
+      }
+      if (nconv == nev || ncv == n || m_iterations >= m_maxIterations) {
+        m_info = (nconv == nev || ncv == n) ? Eigen::Success
+                                            : Eigen::NoConvergence;
+        break;
+      }
+      ++m_iterations;
+
+      // Thick restart on the wanted Ritz vectors, plus some of the next ones
+      // to speed up the convergence.
+      const Eigen::Index keep =
+          (std::min)(nev + (std::min)(nconv, (ncv - nev) / 2), ncv - 1);
+      const std::vector<Eigen::Index> kept =
+          selectRitzValues(theta, selection, keep);
+      DenseMatrix ritz_vectors(ncv, keep);
+      for (Eigen::Index i = 0; i < keep; ++i)
+        ritz_vectors.col(i) = y.col(kept[static_cast<std::size_t>(i)]);
+      const DenseMatrix compressed = m_basis.leftCols(ncv) * ritz_vectors;
+      m_basis.leftCols(keep) = compressed;
+      m_basis.col(keep) = m_basis.col(ncv);
+
+      projected.setZero();
+      for (Eigen::Index i = 0; i < keep; ++i) {
+        const Eigen::Index k = kept[static_cast<std::size_t>(i)];
+        projected(i, i) = Scalar(theta[k]);
+        const Scalar coupling = Scalar(beta) * y(ncv - 1, k);
+        projected(keep, i) = coupling;
+        projected(i, keep) = coupling;
+      }
+      start = keep;
+    }
+
+    m_eigenvalues.resize(nev);
+    m_eigenvectors.resize(n, nev);
+    for (Eigen::Index i = 0; i < nev; ++i) {
+      const Eigen::Index k = wanted[static_cast<std::size_t>(i)];
+      m_eigenvalues[i] = ritz.eigenvalues()[k];
+      m_eigenvectors.col(i).noalias() =
+          m_basis.leftCols(ncv) * ritz.eigenvectors().col(k);
+    }
+    sortEigenpairs();
+  }
+
+  void sortEigenpairs() {
+    const Eigen::Index nev = m_eigenvalues.size();
+    std::vector<Eigen::Index> order(static_cast<std::size_t>(nev));
+    std::iota(order.begin(), order.end(), Eigen::Index(0));
+    std::sort(order.begin(), order.end(),
+              [this](Eigen::Index a, Eigen::Index b) {
+                return m_eigenvalues[a] < m_eigenvalues[b];
+              });
+    const RealVectorType values = m_eigenvalues;
+    const DenseMatrix vectors = m_eigenvectors;
+    for (Eigen::Index i = 0; i < nev; ++i) {
+      const Eigen::Index k = order[static_cast<std::size_t>(i)];
+      m_eigenvalues[i] = values[k];
+      m_eigenvectors.col(i) = vectors.col(k);
+    }
+  }
+
+  DenseMatrix m_basis;
+  RealVectorType m_eigenvalues;
+  DenseMatrix m_eigenvectors;
+  Eigen::Index m_ncv;
+  Eigen::Index m_maxIterations;
+  RealScalar m_tolerance;
+  std::uint64_t m_seed;
+  Eigen::Index m_iterations;
+  Eigen::Index m_operations;
+  bool m_isInitialized;
+  Eigen::ComputationInfo m_info;
+};
+
+template <typename _MatrixType>
+void exposeLanczosEigenSolver(nb::module_ m, const char *name) {
+  using MatrixType = _MatrixType;
+  using Solver = LanczosEigenSolver<MatrixType>;
+  using RealScalar = typename MatrixType::RealScalar;
+  using StorageIndex = typename MatrixType::StorageIndex;
+  // The factorizations as bound by exposeSimplicialLDLT and exposeSparseLU.
+  using SimplicialLDLT = Eigen::SimplicialLDLT<
+      MatrixType, Eigen::Lower,
+      RuntimeOrdering<StorageIndex, OrderingMethod::AMD>>;
+  using SparseLU = Eigen::SparseLU<
+      MatrixType, RuntimeOrdering<StorageIndex, OrderingMethod::COLAMD>>;
+
+  if (!check_registration_alias<LanczosSelection>(m)) {
+    nb::enum_<LanczosSelection>(m, "LanczosSelection")
+        .value("LargestAlgebraic", LargestAlgebraic,
+               "Eigenvalues with the largest algebraic value.")
+        .value("SmallestAlgebraic", SmallestAlgebraic,
+               "Eigenvalues with the smallest algebraic value.")
+        .value("LargestMagnitude", LargestMagnitude,
+               "Eigenvalues with the largest magnitude.")
+        .value("SmallestMagnitude", SmallestMagnitude,
+               "Eigenvalues with the smallest magnitude. Converges slowly, "
+               "prefer the shift-invert mode with a zero shift.");
+  }
+
+  if (check_registration_alias<Solver>(m)) {
+    return;
+  }
+  nb::class_<Solver>(
+      m, name,
+      "Thick-restart Lanczos eigensolver for large sparse selfadjoint "
+      "matrices.\n\n"
+      "This class computes a few eigenpairs of a sparse selfadjoint matrix "
+      "without densifying it. The extreme eigenvalues are obtained with "
+      "compute(), and the eigenvalues closest to a shift sigma with "
+      "computeShiftInvert(), which iterates on (A - sigma I)^-1 using a "
+      "sparse factorization of A - sigma I.\n\n"
+      "Only the lower triangular part of the matrix is referenced.")
+
+      .def(nb::init<>(), "Default constructor.")
+
+      .def(
+          "compute",
+          lockExclusive<Solver>(
+              [](Solver &c, const MatrixType &matrix, Eigen::Index nev,
+                 LanczosSelection selection) -> Solver & {
+                return c.compute(matrix, nev, selection);
+              }),
+          "matrix"_a, "nev"_a, "selection"_a = LargestMagnitude,
+          "Computes the nev eigenpairs of the matrix selected by selection.",
+          nb::rv_policy::reference)
+      .def(
+          "compute",
+          lockExclusive<Solver>(
+              [](Solver &c, const SparseMatrixHandle<MatrixType> &matrix,
+                 Eigen::Index nev, LanczosSelection selection) -> Solver & {
+                return c.compute(matrix.matrix(), nev, selection);
+              }),
+          "matrix"_a, "nev"_a, "selection"_a = LargestMagnitude,
+          "Computes the nev eigenpairs of the matrix selected by selection.",
+          nb::rv_policy::reference)
+      .def(
+          "computeShiftInvert",
+          lockExclusive<Solver>(
+              [](Solver &c, const MatrixType &matrix, Eigen::Index nev,
+                 const RealScalar &sigma) -> Solver & {
+                return c.computeShiftInvert(matrix, nev, sigma);
+              }),
+          "matrix"_a, "nev"_a, "sigma"_a,
+          "Computes the nev eigenpairs of the matrix whose eigenvalues are the "
+          "closest to sigma. A - sigma I is factorized with SimplicialLDLT.",
+          nb::rv_policy::reference)
+      .def(
+          "computeShiftInvert",
+          lockExclusive<Solver>(
+              [](Solver &c, const SparseMatrixHandle<MatrixType> &matrix,
+                 Eigen::Index nev, const RealScalar &sigma) -> Solver & {
+                return c.computeShiftInvert(matrix.matrix(), nev, sigma);
+              }),
+          "matrix"_a, "nev"_a, "sigma"_a,
+          "Computes the nev eigenpairs of the matrix whose eigenvalues are the "
+          "closest to sigma. A - sigma I is factorized with SimplicialLDLT.",
+          nb::rv_policy::reference)
+      .def(
+          "computeShiftInvert",
+          lockExclusive<Solver>(
+              [](Solver &c, const SimplicialLDLT &factorization,
+                 Eigen::Index nev, const RealScalar &sigma) -> Solver & {
+                locks::SharedLock lock(&factorization, true);
+                return c.computeShiftInvert(factorization, nev, sigma);
+              }),
+          "factorization"_a, "nev"_a, "sigma"_a,
+          "Computes the nev eigenpairs closest to sigma, reusing a "
+          "SimplicialLDLT factorization of A - sigma I.",
+          nb::rv_policy::reference)
+      .def(
+          "computeShiftInvert",
+          lockExclusive<Solver>(
+              [](Solver &c, const SparseLU &factorization, Eigen::Index nev,
+                 const RealScalar &sigma) -> Solver & {
+                locks::SharedLock lock(&factorization, true);
+                return c.computeShiftInvert(factorization, nev, sigma);
+              }),
+          "factorization"_a, "nev"_a, "sigma"_a,
+          "Computes the nev eigenpairs closest to sigma, reusing a SparseLU "
+          "factorization of A - sigma I.",
+          nb::rv_policy::reference)
+
+      .def("eigenvalues", &Solver::eigenvalues,
+           "Returns the computed eigenvalues, sorted in increasing order.",
+           nb::rv_policy::reference_internal)
+      .def("eigenvectors", &Solver::eigenvectors,
+           "Returns the computed eigenvectors as columns, in the order of the "
+           "eigenvalues.",
+           nb::rv_policy::reference_internal)
+      .def("info", &Solver::info,
+           "Returns Success if all the requested eigenpairs converged, "
+           "NoConvergence if the max number of restarts was reached, and "
+           "NumericalIssue if the shift-invert factorization failed.")
+
+      .def("iterations", &Solver::iterations,
+           "Returns the number of restarts performed during the last "
+           "computation.")
+      .def("operations", &Solver::operations,
+           "Returns the number of applications of the operator (products "
+           "with A, or solves with A - sigma I) during the last computation.")
+      .def("maxIterations", &Solver::maxIterations,
+           "Returns the max number of restarts.")
+      .def("setMaxIterations", lockExclusive<Solver>(&Solver::setMaxIterations),
+           "max_iterations"_a,
+           "Sets the max number of restarts. Default is 1000.",
+           nb::rv_policy::reference)
+      .def("tolerance", &Solver::tolerance,
+           "Returns the relative tolerance on the Ritz residuals.")
+      .def(
+          "setTolerance",
+          lockExclusive<Solver>(
+              [](Solver &c, const RealScalar &tolerance) -> Solver & {
+                return c.setTolerance(tolerance);
+              }),
+          "tolerance"_a,
+          "Sets the relative tolerance on the Ritz residuals. Default is "
+          "1e-10.",
+          nb::rv_policy::reference)
+      .def("subspaceSize", &Solver::subspaceSize,
+           "Returns the dimension of the Krylov subspace (0 means the default "
+           "max(2 nev + 1, 20)).")
+      .def("setSubspaceSize", lockExclusive<Solver>(&Solver::setSubspaceSize),
+           "ncv"_a,
+           "Sets the dimension of the Krylov subspace. It is clamped to "
+           "[2 nev + 1, n].",
+           nb::rv_policy::reference)
+      .def("seed", &Solver::seed,
+           "Returns the seed of the random starting vector.")
+      .def("setSeed", lockExclusive<Solver>(&Solver::setSeed), "seed"_a,
+           "Sets the seed of the random starting vector. Default is 0.",
+           nb::rv_policy::reference)
+
+      .def(IdVisitor());
+}
+
+}  // namespace nanoeigenpy
@@ -0,0 +1,361 @@
+/// Copyright 2025 INRIA
+
+#pragma once
+
+#include "nanoeigenpy/fwd.hpp"
+#include <Eigen/OrderingMethods>
+#include <Eigen/SparseCore>
+
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace nanoeigenpy {
+namespace nb = nanobind;
+
+/// \brief Nested dissection fill-reducing ordering.
+///
+/// The adjacency graph of the matrix (A + A^T for square matrices, A^T A for
+/// rectangular ones) is recursively split by vertex separators, which are
+/// numbered after the two parts they separate. Each separator is the middle
+/// level of a breadth-first level structure rooted at a pseudo-peripheral
+/// vertex (George and Liu), thinned by moving back the vertices which have no
+/// neighbor in the second part. The subgraphs smaller than leafSize() are
+/// ordered with AMD, as METIS does with minimum degree.
+///
+/// This is a drop-in replacement for the Eigen ordering functors, and can be
+/// used as the _Ordering parameter of the sparse solvers.
+template <typename _StorageIndex>
+class NestedDissectionOrdering {
+ public:
+  using StorageIndex = _StorageIndex;
+  using PermutationType =
+      Eigen::PermutationMatrix<Eigen::Dynamic, Eigen::Dynamic, StorageIndex>;
+
+  explicit NestedDissectionOrdering(Eigen::Index leaf_size = 64)
+      : m_leafSize(leaf_size) {}
+
+  Eigen::Index leafSize() const { return m_leafSize; }
+
+  /// \brief Computes the permutation \a perm such that perm.indices()(k) is
+  /// the column eliminated at the step k.
+  template <typename MatrixType>
+  void operator()(const MatrixType &mat, PermutationType &perm) {
+    buildGraph(mat);
+    const Eigen::Index size = Eigen::Index(m_adjPtr.size()) - 1;
+    perm.resize(size);
+    m_owner.assign(size, -1);
+    m_level.assign(size, -1);
+
+    struct Part {
+      std::vector<StorageIndex> nodes;
+      Eigen::Index offset;
+    };
+    std::vector<Part> stack;
+    stack.push_back(Part{std::vector<StorageIndex>(size), 0});
+    for (Eigen::Index i = 0; i < size; ++i)
+      stack.back().nodes[i] = StorageIndex(i);
+
+    StorageIndex tag = 0;
+    while (!stack.empty()) {
+      Part part = std::move(stack.back());
+      stack.pop_back();
+      std::vector<StorageIndex> &nodes = part.nodes;
+      const Eigen::Index count = Eigen::Index(nodes.size());
+      if (count == 0) continue;
+      if (count <= m_leafSize) {
+        orderLeaf(nodes, part.offset, perm, ++tag);
+        continue;
+      }
+
+      ++tag;
+      for (StorageIndex v : nodes) m_owner[v] = tag;
+      // Pseudo-peripheral root: restart from a vertex of minimal degree in
+      // the last level while the eccentricity increases.
+      StorageIndex root = nodes[0];
+      Eigen::Index depth = levelStructure(root, tag);
+      for (int it = 0; it < 5; ++it) {
+        StorageIndex candidate = m_order.back();
+        for (auto k = m_order.rbegin();
+             k != m_order.rend() && m_level[*k] == depth; ++k)
+          if (degree(*k) < degree(candidate)) candidate = *k;
+        const Eigen::Index candidate_depth = levelStructure(candidate, tag);
+        if (candidate_depth <= depth) {
+          levelStructure(root, tag);
+          break;
+        }
+        root = candidate;
+        depth = candidate_depth;
+      }
+
+      // Split off the other connected components.
+      if (Eigen::Index(m_order.size()) < count) {
+        for (StorageIndex v : m_order) m_owner[v] = -1;
+        std::vector<StorageIndex> rest;
+        rest.reserve(count - m_order.size());
+        for (StorageIndex v : nodes)
+          if (m_owner[v] == tag) rest.push_back(v);
+        const Eigen::Index reached = Eigen::Index(m_order.size());
+        stack.push_back(Part{std::move(rest), part.offset + reached});
+        stack.push_back(Part{m_order, part.offset});
+        continue;
+      }
+      if (depth < 2) {
+        orderLeaf(nodes, part.offset, perm, tag);
+        continue;
+      }
+
+      // The separator is the first level which reaches half of the vertices.
+      Eigen::Index middle = 0;
+      for (Eigen::Index k = 0, seen = 0; k < count; ++k) {
+        if (2 * ++seen >= count) {
+          middle = m_level[m_order[k]];
+          break;
+        }
+      }
+      middle = (std::max)(Eigen::Index(1), (std::min)(middle, depth - 1));
+
+      std::vector<StorageIndex> first, second, separator;
+      for (StorageIndex v : m_order) {
+        if (m_level[v] < middle)
+          first.push_back(v);
+        else if (m_level[v] > middle)
+          second.push_back(v);
+        else if (hasNeighborAtLevel(v, middle + 1, tag))
+          separator.push_back(v);
+        else
+          first.push_back(v);
+      }
+      Eigen::Index position = part.offset + Eigen::Index(first.size()) +
+                              Eigen::Index(second.size());
+      for (StorageIndex v : separator) perm.indices()(position++) = v;
+      const Eigen::Index second_offset =
+          part.offset + Eigen::Index(first.size());
+      stack.push_back(Part{std::move(second), second_offset});
+      stack.push_back(Part{std::move(first), part.offset});
+    }
+  }
+
+ protected:
+  /// \brief Builds the adjacency lists of the symmetrized pattern of \a mat,
+  /// without the diagonal.
+  template <typename MatrixType>
+  void buildGraph(const MatrixType &mat) {
+    using PatternMatrix =
+        Eigen::SparseMatrix<double, Eigen::ColMajor, StorageIndex>;
+    std::vector<Eigen::Triplet<double, StorageIndex>> triplets;
+    triplets.reserve(mat.nonZeros());
+    for (Eigen::Index j = 0; j < mat.outerSize(); ++j)
+      for (typename MatrixType::InnerIterator it(mat, j); it; ++it)
+        triplets.emplace_back(StorageIndex(it.row()), StorageIndex(it.col()),
+                              1.0);
+    PatternMatrix pattern(mat.rows(), mat.cols());
+    pattern.setFromTriplets(triplets.begin(), triplets.end());
+    PatternMatrix graph;
+    if (pattern.rows() == pattern.cols())
+      graph = PatternMatrix(pattern.transpose()) + pattern;
+    else
+      graph = PatternMatrix(pattern.transpose()) * pattern;
+
+    const Eigen::Index size = graph.cols();
+    m_adjPtr.assign(size + 1, 0);
+    m_adj.clear();
+    m_adj.reserve(graph.nonZeros());
+    for (Eigen::Index j = 0; j < size; ++j) {
+      for (typename PatternMatrix::InnerIterator it(graph, j); it; ++it)
+        if (it.index() != j) m_adj.push_back(StorageIndex(it.index()));
+      m_adjPtr[j + 1] = StorageIndex(m_adj.size());
+    }
+  }
+
+  StorageIndex degree(StorageIndex v) const {
+    return m_adjPtr[v + 1] - m_adjPtr[v];
+  }
+
+  /// \brief Breadth-first search from \a root in the subgraph of the vertices
+  /// owned by \a tag. Fills m_order and m_level and returns the depth.
+  Eigen::Index levelStructure(StorageIndex root, StorageIndex tag) {
+    for (StorageIndex v : m_order) m_level[v] = -1;
+    m_order.clear();
+    m_order.push_back(root);
+    m_level[root] = 0;
+    for (std::size_t head = 0; head < m_order.size(); ++head) {
+      const StorageIndex v = m_order[head];
+      for (StorageIndex k = m_adjPtr[v]; k < m_adjPtr[v + 1]; ++k) {
+        const StorageIndex w = m_adj[k];
+        if (m_owner[w] == tag && m_level[w] < 0) {
+          m_level[w] = m_level[v] + 1;
+          m_order.push_back(w);
+        }
+      }
+    }
+    return m_level[m_order.back()];
+  }
+
+  bool hasNeighborAtLevel(StorageIndex v, Eigen::Index level,
+                          StorageIndex tag) const {
+    for (StorageIndex k = m_adjPtr[v]; k < m_adjPtr[v + 1]; ++k) {
+      const StorageIndex w = m_adj[k];
+      if (m_owner[w] == tag && m_level[w] == level) return true;
+    }
+    return false;
+  }
+
+  /// \brief Orders the subgraph induced by \a nodes with AMD.
+  void orderLeaf(const std::vector<StorageIndex> &nodes, Eigen::Index offset,
+                 PermutationType &perm, StorageIndex tag) {
+    const Eigen::Index count = Eigen::Index(nodes.size());
+    for (Eigen::Index i = 0; i < count; ++i) {
+      m_owner[nodes[i]] = tag;
+      m_level[nodes[i]] = StorageIndex(i);
+    }
+    std::vector<Eigen::Triplet<double, StorageIndex>> triplets;
+    for (Eigen::Index i = 0; i < count; ++i) {
+      triplets.emplace_back(StorageIndex(i), StorageIndex(i), 1.0);
+      const StorageIndex v = nodes[i];
+      for (StorageIndex k = m_adjPtr[v]; k < m_adjPtr[v + 1]; ++k)
+        if (m_owner[m_adj[k]] == tag)
+          triplets.emplace_back(m_level[m_adj[k]], StorageIndex(i), 1.0);
+    }
+    Eigen::SparseMatrix<double, Eigen::ColMajor, StorageIndex> local(count,
+                                                                     count);
+    local.setFromTriplets(triplets.begin(), triplets.end());
+    PermutationType local_perm;
+    Eigen::AMDOrdering<StorageIndex>()(local, local_perm);
+    for (Eigen::Index k = 0; k < count; ++k)
+      perm.indices()(offset + k) = nodes[local_perm.indices()(k)];
+    for (StorageIndex v : nodes) m_level[v] = -1;
+  }
+
+  Eigen::Index m_leafSize;
+  std::vector<StorageIndex> m_adjPtr;
+  std::vector<StorageIndex> m_adj;
+  std::vector<StorageIndex> m_owner;
+  std::vector<StorageIndex> m_level;
+  std::vector<StorageIndex> m_order;
+};
+
+/// \brief Fill-reducing orderings available at runtime.
+enum class OrderingMethod { Natural, AMD, COLAMD, NestedDissection };
+
+/// \brief Computes the fill-reducing ordering \a method of \a mat, with the
+/// conventions of the Eigen ordering functors.
+template <typename MatrixType, typename PermutationType>
+void computeOrdering(OrderingMethod method, const MatrixType &mat,
+                     PermutationType &perm) {
+  using StorageIndex = typename MatrixType::StorageIndex;
+  switch (method) {
+    case OrderingMethod::Natural:
+      perm.setIdentity(mat.cols());
+      break;
+    case OrderingMethod::AMD:
+      if (mat.rows() != mat.cols())
+        throw std::invalid_argument(
+            "The AMD ordering requires a square matrix.");
+      Eigen::AMDOrdering<StorageIndex>()(mat, perm);
+      break;
+    case OrderingMethod::COLAMD:
+      Eigen::COLAMDOrdering<StorageIndex>()(mat, perm);
+      break;
+    case OrderingMethod::NestedDissection:
+      NestedDissectionOrdering<StorageIndex>()(mat, perm);
+      break;
+  }
+}
+
+namespace detail {
+/// Ordering of the analyses run by the current thread, see OrderingScope.
+inline const OrderingMethod *&scopedOrderingMethod() {
+  thread_local const OrderingMethod *method = nullptr;
+  return method;
+}
+}  // namespace detail
+
+/// \brief Selects the ordering of the RuntimeOrdering functors constructed by
+/// the current thread while it is alive.
+class OrderingScope {
+ public:
+  explicit OrderingScope(const OrderingMethod &method)
+      : m_previous(detail::scopedOrderingMethod()) {
+    detail::scopedOrderingMethod() = &method;
+  }
+  ~OrderingScope() { detail::scopedOrderingMethod() = m_previous; }
+
+  OrderingScope(const OrderingScope &) = delete;
+  OrderingScope &operator=(const OrderingScope &) = delete;
+
+ private:
+  const OrderingMethod *m_previous;
+};
+
+/// \brief Ordering functor computing an OrderingMethod chosen at runtime.
+///
+/// The Eigen sparse solvers construct their ordering functor in
+/// analyzePattern(), so the method is the one of the innermost OrderingScope
+/// of the thread, or \a Default outside of any scope. This lets a single
+/// solver class take the ordering as an argument of analyzePattern().
+template <typename _StorageIndex, OrderingMethod Default>
+class RuntimeOrdering {
+ public:
+  using StorageIndex = _StorageIndex;
+  using PermutationType =
+      Eigen::PermutationMatrix<Eigen::Dynamic, Eigen::Dynamic, StorageIndex>;
+  static constexpr OrderingMethod DefaultMethod = Default;
+
+  RuntimeOrdering() {
+    const OrderingMethod *scoped = detail::scopedOrderingMethod();
+    m_method = scoped ? *scoped : Default;
+  }
+  explicit RuntimeOrdering(OrderingMethod method) : m_method(method) {}
+
+  OrderingMethod method() const { return m_method; }
+
+  template <typename MatrixType>
+  void operator()(const MatrixType &mat, PermutationType &perm) const {
+    computeOrdering(m_method, mat, perm);
+  }
+
+ private:
+  OrderingMethod m_method;
+};
+
+namespace detail {
+/// Whether the ordering of \a Solver is a RuntimeOrdering.
+template <typename Solver, typename = void>
+struct has_runtime_ordering : std::false_type {};
+template <typename Solver>
+struct has_runtime_ordering<
+    Solver, std::void_t<decltype(Solver::OrderingType::DefaultMethod)>>
+    : std::true_type {};
+}  // namespace detail
+
+/// \brief Wraps \a f(solver, matrix), which analyzes the pattern of \a
+/// matrix, into a function taking the ordering as its last argument.
+template <typename Solver, typename Func>
+auto withOrdering(Func f) {
+  using MatrixType = typename Solver::MatrixType;
+  return [f](Solver &self, const MatrixType &matrix,
+             OrderingMethod ordering) -> decltype(auto) {
+    OrderingScope scope(ordering);
+    return f(self, matrix);
+  };
+}
+
+inline void exposeOrderingMethod(nb::module_ m) {
+  if (check_registration_alias<OrderingMethod>(m)) {
+    return;
+  }
+  nb::enum_<OrderingMethod>(m, "OrderingMethod")
+      .value("Natural", OrderingMethod::Natural,
+             "Keeps the original ordering of the columns.")
+      .value("AMD", OrderingMethod::AMD,
+             "Approximate minimum degree ordering of A + A^T.")
+      .value("COLAMD", OrderingMethod::COLAMD,
+             "Column approximate minimum degree ordering of A.")
+      .value("NestedDissection", OrderingMethod::NestedDissection,
+             "Nested dissection ordering. Reduces the fill on large 2D and "
+             "3D meshes.");
+}
+
+}  // namespace nanoeigenpy
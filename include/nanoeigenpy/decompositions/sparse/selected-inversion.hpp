@@ -0,0 +1,174 @@
+/// Copyright 2025 INRIA
+
+#pragma once
+
+#include "nanoeigenpy/fwd.hpp"
+#include <Eigen/SparseCore>
+#include <Eigen/SparseCholesky>
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+namespace nanoeigenpy {
+
+/// \brief Entries of the inverse of a sparse symmetric matrix on the sparsity
+/// pattern of its Cholesky factor (selected inversion).
+///
+/// Given P A P^T = L D L^T with L unit lower triangular, the inverse
+/// Z = P A^-1 P^T satisfies Takahashi's equations
+///   Z(i, j) = -sum_{k > j} Z(i, k) L(k, j)            for i > j,
+///   Z(j, j) = 1 / D(j) - sum_{k > j} Z(k, j) L(k, j).
+/// Only the entries of Z on the pattern of L are needed to evaluate them,
+/// which are computed column by column from the last one, at the cost of a
+/// numeric factorization.
+template <typename _Scalar, typename _StorageIndex>
+class SelectedInverse {
+ public:
+  using Scalar = _Scalar;
+  using StorageIndex = _StorageIndex;
+  using MatrixType = Eigen::SparseMatrix<Scalar, Eigen::ColMajor, StorageIndex>;
+  using VectorType = Eigen::Matrix<Scalar, Eigen::Dynamic, 1>;
+  static_assert(!Eigen::NumTraits<Scalar>::IsComplex,
+                "Selected inversion is implemented for real matrices only.");
+
+  /// \brief Computes the entries of Z on the pattern of \a L, the strictly
+  /// lower part of the unit factor, which must be compressed. The row indices
+  /// of its columns do not need to be sorted.
+  void compute(const MatrixType &L, const VectorType &d) {
+    eigen_assert(L.isCompressed() && L.rows() == L.cols() &&
+                 d.size() == L.cols());
+    const Eigen::Index size = L.cols();
+    const StorageIndex *outer = L.outerIndexPtr();
+    const StorageIndex *inner = L.innerIndexPtr();
+    const Scalar *lx = L.valuePtr();
+
+    m_lower = L;
+    Scalar *zx = m_lower.valuePtr();
+    std::fill(zx, zx + m_lower.nonZeros(), Scalar(0));
+    m_diagonal.resize(size);
+    // Position in the current column of each of its rows, or -1.
+    m_position.assign(std::size_t(size), -1);
+
+    for (Eigen::Index j = size - 1; j >= 0; --j) {
+      const StorageIndex begin = outer[j], end = outer[j + 1];
+      for (StorageIndex p = begin; p < end; ++p) m_position[inner[p]] = p;
+      for (StorageIndex p = begin; p < end; ++p) {
+        const StorageIndex k = inner[p];
+        const Scalar lkj = lx[p];
+        zx[p] -= lkj * m_diagonal[k];
+        // The rows i > k of the column k that also belong to the column j
+        // give both Z(i, j) -= Z(i, k) L(k, j) and, by symmetry,
+        // Z(k, j) -= Z(i, k) L(i, j).
+        for (StorageIndex q = outer[k]; q < outer[k + 1]; ++q) {
+          const StorageIndex pi = m_position[inner[q]];
+          if (pi < 0) continue;
+          zx[pi] -= lkj * zx[q];
+          zx[p] -= lx[pi] * zx[q];
+        }
+      }
+      Scalar zjj = Scalar(1) / d[j];
+      for (StorageIndex p = begin; p < end; ++p) {
+        zjj -= lx[p] * zx[p];
+        m_position[inner[p]] = -1;
+      }
+      m_diagonal[j] = zjj;
+    }
+  }
+
+  /// \brief Computes the entries of Z from a factor whose columns start with
+  /// their diagonal entry, either L of an LL^T factorization or L and D
+  /// packed together (\a is_ll false).
+  void compute(Eigen::Index size, const StorageIndex *outer,
+               const StorageIndex *inner, const Scalar *values, bool is_ll) {
+    MatrixType unit(size, size);
+    unit.reserve(outer[size] - size);
+    VectorType d(size);
+    for (Eigen::Index j = 0; j < size; ++j) {
+      const Scalar diagonal = values[outer[j]];
+      const Scalar scale = is_ll ? Scalar(1) / diagonal : Scalar(1);
+      d[j] = is_ll ? diagonal * diagonal : diagonal;
+      unit.startVec(j);
+      for (StorageIndex p = outer[j] + 1; p < outer[j + 1]; ++p)
+        unit.insertBack(inner[p], j) = values[p] * scale;
+    }
+    unit.finalize();
+    compute(unit, d);
+  }
+
+  /// \returns the diagonal of A^-1, where the row i of A is the row
+  /// \a indices(i) of P A P^T (empty for the identity).
+  template <typename Indices>
+  VectorType diagonal(const Indices &indices) const {
+    if (indices.size() == 0) return m_diagonal;
+    VectorType res(m_diagonal.size());
+    for (Eigen::Index i = 0; i < res.size(); ++i)
+      res[i] = m_diagonal[indices(i)];
+    return res;
+  }
+
+  /// \returns the symmetric matrix holding the entries of A^-1 on the
+  /// pattern of P^T (L + L^T) P, with \a indices as in diagonal().
+  template <typename Indices>
+  MatrixType matrix(const Indices &indices) const {
+    const Eigen::Index size = m_diagonal.size();
+    std::vector<StorageIndex> original(static_cast<std::size_t>(size));
+    for (Eigen::Index i = 0; i < size; ++i)
+      original[indices.size() > 0 ? indices(i) : i] = StorageIndex(i);
+
+    std::vector<Eigen::Triplet<Scalar, StorageIndex>> triplets;
+    triplets.reserve(std::size_t(2 * m_lower.nonZeros() + size));
+    for (Eigen::Index j = 0; j < size; ++j) {
+      const StorageIndex oj = original[j];
+      triplets.emplace_back(oj, oj, m_diagonal[j]);
+      for (typename MatrixType::InnerIterator it(m_lower, j); it; ++it) {
+        const StorageIndex oi = original[it.index()];
+        triplets.emplace_back(oi, oj, it.value());
+        triplets.emplace_back(oj, oi, it.value());
+      }
+    }
+    MatrixType res(size, size);
+    res.setFromTriplets(triplets.begin(), triplets.end());
+    return res;
+  }
+
+ protected:
+  /// Strictly lower part of Z, on the pattern of L.
+  MatrixType m_lower;
+  VectorType m_diagonal;
+  std::vector<StorageIndex> m_position;
+};
+
+namespace detail {
+
+/// \brief Runs the selected inversion on the factor of a simplicial
+/// Cholesky decomposition.
+template <typename Solver>
+SelectedInverse<typename Solver::Scalar, typename Solver::StorageIndex>
+simplicialSelectedInverse(const Solver &solver) {
+  using Scalar = typename Solver::Scalar;
+  using StorageIndex = typename Solver::StorageIndex;
+  using MatrixL = typename Solver::MatrixL;
+  constexpr bool unit_diagonal = (MatrixL::Mode & Eigen::UnitDiag) != 0;
+  if (solver.info() != Eigen::Success)
+    throw std::invalid_argument(
+        "The decomposition must be successfully computed before inverting "
+        "it.");
+
+  const MatrixL matrix_l = solver.matrixL();
+  const auto &L = matrix_l.nestedExpression();
+  SelectedInverse<Scalar, StorageIndex> inverse;
+  if constexpr (unit_diagonal) {
+    // SimplicialLDLT stores the strictly lower part of L, and D apart.
+    inverse.compute(L, solver.vectorD());
+  } else {
+    // With a simplicial LLT, the diagonal is the first entry of each column.
+    inverse.compute(L.cols(), L.outerIndexPtr(), L.innerIndexPtr(),
+                    L.valuePtr(), true);
+  }
+  return inverse;
+}
+
+}  // namespace detail
+
+}  // namespace nanoeigenpy
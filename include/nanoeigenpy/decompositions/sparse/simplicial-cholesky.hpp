@@ -4,6 +4,11 @@
 
 #include "nanoeigenpy/fwd.hpp"
 #include "nanoeigenpy/decompositions/sparse/sparse-solver-base.hpp"
+#include "nanoeigenpy/decompositions/sparse/orderings.hpp"
+#include "nanoeigenpy/decompositions/sparse/cholesky-factor-store.hpp"
+#include "nanoeigenpy/decompositions/sparse/sparse-triangular-solve.hpp"
+#include "nanoeigenpy/decompositions/sparse/selected-inversion.hpp"
+#include "nanoeigenpy/utils/object-lock.hpp"
 #include <Eigen/SparseCholesky>
 
 namespace nanoeigenpy {
@@ -17,13 +22,10 @@ struct SimplicialCholeskyVisitor : nb::def_visitor<SimplicialCholeskyVisitor> {
     static_assert(std::is_base_of_v<Base, Solver>);
     using MatrixType = typename SimplicialDerived::MatrixType;
     using RealScalar = typename MatrixType::RealScalar;
+    using DenseVectorType =
+        Eigen::Matrix<typename MatrixType::Scalar, Eigen::Dynamic, 1>;
 
-    cl.def("analyzePattern", &Solver::analyzePattern,
-           "Performs a symbolic decomposition on the sparcity of matrix.\n"
-           "This function is particularly useful when solving for several "
-           "problems having the same structure.")
-
-        .def(SparseSolverBaseVisitor())
+    cl.def(SparseSolverBaseVisitor())
 
         .def(
             "matrixL",
@@ -33,33 +35,47 @@ struct SimplicialCholeskyVisitor : nb::def_visitor<SimplicialCholeskyVisitor> {
             "matrixU",
             [](const Solver &self) -> MatrixType { return self.matrixU(); },
             "Returns the upper triangular matrix U.")
-
         .def(
-            "compute",
-            [](Solver &self, const MatrixType &matrix) -> decltype(auto) {
-              return self.compute(matrix);
-            },
-            "matrix"_a,
-            "Computes the sparse Cholesky decomposition of a given matrix.",
-            nb::rv_policy::reference)
+            "solveLower",
+            lockShared<Solver>(
+                [](const Solver &self, const MatrixType &B) -> MatrixType {
+                  return sparseRhsSolve(self, B, true);
+                }),
+            "B"_a,
+            "Returns L^-1 P B for a sparse right hand side B, so that "
+            "B^T A^-1 B is the Gram matrix of its columns (scaled by D^-1 for "
+            "an LDLT). Only the columns of L reachable from the nonzeros of "
+            "B are visited.")
+        .def(
+            "selectedInversion",
+            lockShared<Solver>([](const Solver &self) -> MatrixType {
+              return detail::simplicialSelectedInverse(self).matrix(
+                  self.permutationP().indices());
+            }),
+            "Returns the entries of A^-1 on the sparsity pattern of the "
+            "factor, i.e. of P^T (L + L^T) P, which includes the pattern of A. "
+            "They are computed with Takahashi's equations from the factor, at "
+            "a cost comparable to the factorization.")
+        .def(
+            "inverseDiagonal",
+            lockShared<Solver>([](const Solver &self) -> DenseVectorType {
+              return detail::simplicialSelectedInverse(self).diagonal(
+                  self.permutationP().indices());
+            }),
+            "Returns the diagonal of A^-1, e.g. the marginal variances of a "
+            "Gaussian with information matrix A, by selected inversion.")
 
         .def("determinant", &Solver::determinant,
              "Returns the determinant of the underlying matrix from the "
              "current factorization.")
 
-        .def("factorize", &Solver::factorize, "matrix"_a,
-             "Performs a numeric decomposition of a given matrix.\n"
-             "The given matrix must has the same sparcity than the matrix on "
-             "which the symbolic decomposition has been performed.\n"
-             "See also analyzePattern().")
-
         .def("rows", &Solver::rows)
         .def("cols", &Solver::cols)
         .def("info", &Solver::info,
              "NumericalIssue if the input contains INF or NaN values or "
              "overflow occured. Returns Success otherwise.")
 
-        .def("setShift", &Solver::setShift, "offset"_a,
+        .def("setShift", lockExclusive<Solver>(&Solver::setShift), "offset"_a,
              "scale"_a = RealScalar(1),
              "Sets the shift parameters that will be used to adjust the "
              "diagonal coefficients during the numerical factorization.\n"
@@ -76,6 +92,16 @@ struct SimplicialCholeskyVisitor : nb::def_visitor<SimplicialCholeskyVisitor> {
              "Returns the inverse P^-1 of the permutation P.",
              nb::rv_policy::copy)
 
+        .def(
+            "save",
+            lockShared<Solver>(
+                [](const Solver &self, const std::string &path) {
+                  saveCholeskyFactor(self, path);
+                }),
+            "path"_a,
+            "Saves the factorization to a file, which can be loaded back "
+            "without refactorizing the matrix with MappedCholeskyFactor.")
+
         ;
   }
 };
@@ -10,10 +10,11 @@ namespace nb = nanobind;
 
 template <
     typename _MatrixType, int _UpLo = Eigen::Lower,
-    typename _Ordering = Eigen::AMDOrdering<typename _MatrixType::StorageIndex>>
+    typename _Ordering = RuntimeOrdering<typename _MatrixType::StorageIndex,
+                                         OrderingMethod::AMD>>
 void exposeSimplicialLDLT(nb::module_ m, const char *name) {
   using MatrixType = _MatrixType;
-  using Solver = Eigen::SimplicialLDLT<MatrixType>;
+  using Solver = Eigen::SimplicialLDLT<MatrixType, _UpLo, _Ordering>;
   using Scalar = typename MatrixType::Scalar;
   using DenseVectorXs =
       Eigen::Matrix<Scalar, Eigen::Dynamic, 1, MatrixType::Options>;
@@ -21,6 +22,7 @@ void exposeSimplicialLDLT(nb::module_ m, const char *name) {
   if (check_registration_alias<Solver>(m)) {
     return;
   }
+  exposeOrderingMethod(m);
   nb::class_<Solver>(
       m, name,
       "A direct sparse LDLT Cholesky factorizations.\n\n"
@@ -34,8 +36,16 @@ void exposeSimplicialLDLT(nb::module_ m, const char *name) {
       "P^-1.")
 
       .def(nb::init<>(), "Default constructor.")
-      .def(nb::init<const MatrixType &>(), "matrix"_a,
-           "Constructs a LDLT factorization from a given matrix.")
+      .def(
+          "__init__",
+          [](Solver *self, const MatrixType &matrix, OrderingMethod ordering) {
+            new (self) Solver();
+            OrderingScope scope(ordering);
+            self->compute(matrix);
+          },
+          "matrix"_a, "ordering"_a = _Ordering::DefaultMethod,
+          "Constructs a LDLT factorization from a given matrix, with the "
+          "given fill-reducing ordering.")
 
       .def(
           "vectorD",
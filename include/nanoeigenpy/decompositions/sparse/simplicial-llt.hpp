@@ -8,14 +8,16 @@ namespace nanoeigenpy {
 
 template <
     typename _MatrixType, int _UpLo = Eigen::Lower,
-    typename _Ordering = Eigen::AMDOrdering<typename _MatrixType::StorageIndex>>
+    typename _Ordering = RuntimeOrdering<typename _MatrixType::StorageIndex,
+                                         OrderingMethod::AMD>>
 void exposeSimplicialLLT(nb::module_ m, const char *name) {
   using MatrixType = _MatrixType;
-  using Solver = Eigen::SimplicialLLT<MatrixType>;
+  using Solver = Eigen::SimplicialLLT<MatrixType, _UpLo, _Ordering>;
 
   if (check_registration_alias<Solver>(m)) {
     return;
   }
+  exposeOrderingMethod(m);
   nb::class_<Solver>(
       m, name,
       "A direct sparse LLT Cholesky factorizations.\n\n"
@@ -30,8 +32,16 @@ void exposeSimplicialLLT(nb::module_ m, const char *name) {
       "P^-1.")
 
       .def(nb::init<>(), "Default constructor.")
-      .def(nb::init<const MatrixType &>(), "matrix"_a,
-           "Constructs a LLT factorization from a given matrix.")
+      .def(
+          "__init__",
+          [](Solver *self, const MatrixType &matrix, OrderingMethod ordering) {
+            new (self) Solver();
+            OrderingScope scope(ordering);
+            self->compute(matrix);
+          },
+          "matrix"_a, "ordering"_a = _Ordering::DefaultMethod,
+          "Constructs a LLT factorization from a given matrix, with the "
+          "given fill-reducing ordering.")
 
       .def(SimplicialCholeskyVisitor())
 
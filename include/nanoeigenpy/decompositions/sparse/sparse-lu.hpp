@@ -4,8 +4,13 @@
 
 #include "nanoeigenpy/fwd.hpp"
 #include "nanoeigenpy/decompositions/sparse/sparse-solver-base.hpp"
+#include "nanoeigenpy/decompositions/sparse/orderings.hpp"
+#include "nanoeigenpy/decompositions/sparse/sparse-triangular-solve.hpp"
+#include "nanoeigenpy/utils/object-lock.hpp"
 #include <Eigen/SparseLU>
 
+#include <vector>
+
 namespace nanoeigenpy {
 namespace nb = nanobind;
 using namespace nb::literals;
@@ -16,10 +21,58 @@ static void solveInPlace(const LTypeOrUType &self,
   self.solveInPlace(mat_vec);
 }
 
+/// \brief Copies the unit lower triangular factor L of a SparseLU
+/// factorization, stored by supernodes in \a mapL, into a compressed column
+/// matrix with sorted row indices.
+template <typename SparseMatrixType, typename MappedSupernodalType>
+SparseMatrixType sparseLUToSparseL(const MappedSupernodalType &mapL) {
+  using Scalar = typename SparseMatrixType::Scalar;
+  using StorageIndex = typename SparseMatrixType::StorageIndex;
+  std::vector<Eigen::Triplet<Scalar, StorageIndex>> triplets;
+  for (Eigen::Index j = 0; j < mapL.cols(); ++j) {
+    triplets.emplace_back(StorageIndex(j), StorageIndex(j), Scalar(1));
+    for (typename MappedSupernodalType::InnerIterator it(mapL, j); it; ++it)
+      if (it.row() > j)
+        triplets.emplace_back(StorageIndex(it.row()), StorageIndex(j),
+                              it.value());
+  }
+  SparseMatrixType L(mapL.rows(), mapL.cols());
+  L.setFromTriplets(triplets.begin(), triplets.end());
+  return L;
+}
+
+/// \brief Copies the upper triangular factor U of a SparseLU factorization
+/// into a compressed column matrix with sorted row indices. The diagonal
+/// blocks of the supernodes are stored in \a mapL, and the rest of U in
+/// \a mapU.
+template <typename SparseMatrixType, typename MappedSupernodalType,
+          typename MappedSparseMatrixType>
+SparseMatrixType sparseLUToSparseU(const MappedSupernodalType &mapL,
+                                   const MappedSparseMatrixType &mapU) {
+  using Scalar = typename SparseMatrixType::Scalar;
+  using StorageIndex = typename SparseMatrixType::StorageIndex;
+  std::vector<Eigen::Triplet<Scalar, StorageIndex>> triplets;
+  for (Eigen::Index j = 0; j < mapL.cols(); ++j) {
+    for (typename MappedSupernodalType::InnerIterator it(mapL, j); it; ++it)
+      if (it.row() <= j)
+        triplets.emplace_back(StorageIndex(it.row()), StorageIndex(j),
+                              it.value());
+    for (typename MappedSparseMatrixType::InnerIterator it(mapU, j); it; ++it)
+      triplets.emplace_back(StorageIndex(it.index()), StorageIndex(j),
+                            it.value());
+  }
+  SparseMatrixType U(mapL.rows(), mapL.cols());
+  U.setFromTriplets(triplets.begin(), triplets.end());
+  return U;
+}
+
 template <typename MappedSupernodalType>
 void exposeMatrixL(nb::module_ m) {
   using LType = Eigen::SparseLUMatrixLReturnType<MappedSupernodalType>;
   using Scalar = typename MappedSupernodalType::Scalar;
+  using StorageIndex = typename MappedSupernodalType::StorageIndex;
+  using SparseMatrixXs =
+      Eigen::SparseMatrix<Scalar, Eigen::ColMajor, StorageIndex>;
   using VectorXs = Eigen::Matrix<Scalar, Eigen::Dynamic, 1, Eigen::ColMajor>;
   using MatrixXs =
       Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::ColMajor>;
@@ -32,13 +85,23 @@ void exposeMatrixL(nb::module_ m) {
       .def("rows", &LType::rows)
       .def("cols", &LType::cols)
       .def("solveInPlace", &solveInPlace<LType, MatrixXs>, "X"_a)
-      .def("solveInPlace", &solveInPlace<LType, VectorXs>, "x"_a);
+      .def("solveInPlace", &solveInPlace<LType, VectorXs>, "x"_a)
+      .def(
+          "toSparse",
+          [](const LType &self) -> SparseMatrixXs {
+            return sparseLUToSparseL<SparseMatrixXs>(self.m_mapL);
+          },
+          "Returns a copy of the unit lower triangular factor L as a sparse "
+          "matrix in CSC format, with its unit diagonal stored.");
 }
 
 template <typename MatrixLType, typename MatrixUType>
 void exposeMatrixU(nb::module_ m) {
   using UType = Eigen::SparseLUMatrixUReturnType<MatrixLType, MatrixUType>;
   using Scalar = typename MatrixLType::Scalar;
+  using StorageIndex = typename MatrixLType::StorageIndex;
+  using SparseMatrixXs =
+      Eigen::SparseMatrix<Scalar, Eigen::ColMajor, StorageIndex>;
   using VectorXs = Eigen::Matrix<Scalar, Eigen::Dynamic, 1, Eigen::ColMajor>;
   using MatrixXs =
       Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::ColMajor>;
@@ -51,14 +114,22 @@ void exposeMatrixU(nb::module_ m) {
       .def("rows", &UType::rows)
       .def("cols", &UType::cols)
       .def("solveInPlace", &solveInPlace<UType, MatrixXs>, "X"_a)
-      .def("solveInPlace", &solveInPlace<UType, VectorXs>, "x"_a);
+      .def("solveInPlace", &solveInPlace<UType, VectorXs>, "x"_a)
+      .def(
+          "toSparse",
+          [](const UType &self) -> SparseMatrixXs {
+            return sparseLUToSparseU<SparseMatrixXs>(self.m_mapL, self.m_mapU);
+          },
+          "Returns a copy of the upper triangular factor U as a sparse matrix "
+          "in CSC format.");
 }
 
-template <typename _MatrixType, typename _Ordering = Eigen::COLAMDOrdering<
-                                    typename _MatrixType::StorageIndex>>
+template <typename _MatrixType,
+          typename _Ordering = RuntimeOrdering<
+              typename _MatrixType::StorageIndex, OrderingMethod::COLAMD>>
 void exposeSparseLU(nb::module_ m, const char *name) {
   using MatrixType = _MatrixType;
-  using Solver = Eigen::SparseLU<MatrixType>;
+  using Solver = Eigen::SparseLU<MatrixType, _Ordering>;
   using Scalar = typename MatrixType::Scalar;
   using RealScalar = typename MatrixType::RealScalar;
   using StorageIndex = typename MatrixType::StorageIndex;
@@ -76,6 +147,7 @@ void exposeSparseLU(nb::module_ m, const char *name) {
   if (check_registration_alias<Solver>(m)) {
     return;
   }
+  exposeOrderingMethod(m);
 
   exposeMatrixL<SCMatrix>(m);
   exposeMatrixU<SCMatrix, MappedSparseMatrix>(m);
@@ -111,31 +183,38 @@ void exposeSparseLU(nb::module_ m, const char *name) {
       "ordering methods.")
 
       .def(nb::init<>(), "Default constructor.")
-      .def(nb::init<const MatrixType &>(), "matrix"_a,
-           "Constructs a LU factorization from a given matrix.")
+      .def(
+          "__init__",
+          [](Solver *self, const MatrixType &matrix, OrderingMethod ordering) {
+            new (self) Solver();
+            OrderingScope scope(ordering);
+            self->compute(matrix);
+          },
+          "matrix"_a, "ordering"_a = _Ordering::DefaultMethod,
+          "Constructs a LU factorization from a given matrix, with the "
+          "given fill-reducing ordering.")
 
       .def(SparseSolverBaseVisitor())
 
-      .def("analyzePattern", &Solver::analyzePattern,
-           "Performs a symbolic decomposition on the sparcity of matrix.\n"
-           "This function is particularly useful when solving for several "
-           "problems having the same structure.")
-      .def("factorize", &Solver::factorize,
-           "Performs a numeric decomposition of a given matrix.\n"
-           "The given matrix must has the same sparcity than the matrix on "
-           "which the symbolic decomposition has been performed.\n"
-           "See also analyzePattern().")
-      .def("compute", &Solver::compute,
-           "Compute the symbolic and numeric factorization of the input sparse "
-           "matrix.\n\n"
-           "The input matrix should be in column-major storage.")
-
       .def(
           "matrixL", [](const Solver &self) -> LType { return self.matrixL(); },
-          "Returns an expression of the matrix L.")
+          "Returns an expression of the matrix L. Use matrixL().toSparse() to "
+          "get L as a sparse matrix.",
+          nb::keep_alive<0, 1>())
       .def(
           "matrixU", [](const Solver &self) -> UType { return self.matrixU(); },
-          "Returns an expression of the matrix U.")
+          "Returns an expression of the matrix U. Use matrixU().toSparse() to "
+          "get U as a sparse matrix.",
+          nb::keep_alive<0, 1>())
+      .def(
+          "solveLower",
+          lockShared<Solver>(
+              [](const Solver &self, const MatrixType &B) -> MatrixType {
+                return sparseRhsSolve(self, B, true);
+              }),
+          "B"_a,
+          "Returns L^-1 P_r B for a sparse right hand side B. Only the "
+          "columns of L reachable from the nonzeros of B are visited.")
 
       .def("rows", &Solver::rows, "Returns the number of rows of the matrix.")
       .def("cols", &Solver::cols, "Returns the number of cols of the matrix.")
@@ -154,9 +233,10 @@ void exposeSparseLU(nb::module_ m, const char *name) {
 
       .def(
           "setPivotThreshold",
-          [](Solver &self, const RealScalar &thresh) -> void {
-            return self.setPivotThreshold(thresh);
-          },
+          lockExclusive<Solver>(
+              [](Solver &self, const RealScalar &thresh) -> void {
+                return self.setPivotThreshold(thresh);
+              }),
           "Set the threshold used for a diagonal entry to be an acceptable "
           "pivot.")
 
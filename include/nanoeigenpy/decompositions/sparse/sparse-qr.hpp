@@ -4,6 +4,8 @@
 
 #include "nanoeigenpy/fwd.hpp"
 #include "nanoeigenpy/decompositions/sparse/sparse-solver-base.hpp"
+#include "nanoeigenpy/decompositions/sparse/orderings.hpp"
+#include "nanoeigenpy/utils/object-lock.hpp"
 #include <Eigen/SparseQR>
 
 namespace nanoeigenpy {
@@ -60,6 +62,17 @@ void exposeMatrixQ(nb::module_ m) {
             },
             "other"_a)
 
+        .def(
+            "toSparse",
+            [](const QType& self) -> QRMatrixType {
+              QRMatrixType q;
+              q = self;
+              return q;
+            },
+            "Returns a copy of Q as a sparse matrix in CSC format, formed by "
+            "applying the sparse Householder reflectors column by column. Q "
+            "is usually much denser than R.")
+
         .def("adjoint",
              [](const QType& self) -> QTransposeType { return self.adjoint(); })
 
@@ -69,8 +82,9 @@ void exposeMatrixQ(nb::module_ m) {
   }
 }
 
-template <typename _MatrixType, typename _Ordering = Eigen::COLAMDOrdering<
-                                    typename _MatrixType::StorageIndex>>
+template <typename _MatrixType,
+          typename _Ordering = RuntimeOrdering<
+              typename _MatrixType::StorageIndex, OrderingMethod::COLAMD>>
 void exposeSparseQR(nb::module_ m, const char* name) {
   using MatrixType = _MatrixType;
   using Ordering = _Ordering;
@@ -83,6 +97,7 @@ void exposeSparseQR(nb::module_ m, const char* name) {
   if (check_registration_alias<Solver>(m)) {
     return;
   }
+  exposeOrderingMethod(m);
 
   exposeMatrixQ<Solver>(m);
 
@@ -112,30 +127,25 @@ void exposeSparseQR(nb::module_ m, const char* name) {
       "factor of full rank.")
 
       .def(nb::init<>(), "Default constructor.")
-      .def(nb::init<const MatrixType&>(), "matrix"_a,
-           "Constructs a LU factorization from a given matrix.")
+      .def(
+          "__init__",
+          [](Solver* self, const MatrixType& matrix, OrderingMethod ordering) {
+            new (self) Solver();
+            OrderingScope scope(ordering);
+            self->compute(matrix);
+          },
+          "matrix"_a, "ordering"_a = _Ordering::DefaultMethod,
+          "Constructs a QR factorization from a given matrix, with the "
+          "given fill-reducing ordering.")
 
       .def(SparseSolverBaseVisitor())
 
-      .def("analyzePattern", &Solver::analyzePattern,
-           "Performs a symbolic decomposition on the sparcity of matrix.\n"
-           "This function is particularly useful when solving for several "
-           "problems having the same structure.")
-      .def("factorize", &Solver::factorize,
-           "Performs a numeric decomposition of a given matrix.\n"
-           "The given matrix must has the same sparcity than the matrix on "
-           "which the symbolic decomposition has been performed.\n"
-           "See also analyzePattern().")
-      .def("compute", &Solver::compute,
-           "Compute the symbolic and numeric factorization of the input sparse "
-           "matrix.\n\n"
-           "The input matrix should be in compressed mode "
-           "(see SparseMatrix::makeCompressed()).")
-
       .def(
           "matrixQ", [](const Solver& self) -> QType { return self.matrixQ(); },
           "Returns an expression of the matrix Q as products of sparse "
-          "Householder reflectors.")
+          "Householder reflectors. Use matrixQ().toSparse() to get Q as a "
+          "sparse matrix.",
+          nb::keep_alive<0, 1>())
       .def(
           "matrixR",
           [](const Solver& self) -> const QRMatrixType& {
@@ -164,9 +174,10 @@ void exposeSparseQR(nb::module_ m, const char* name) {
 
       .def(
           "setPivotThreshold",
-          [](Solver& self, const RealScalar& thresh) -> void {
-            return self.setPivotThreshold(thresh);
-          },
+          lockExclusive<Solver>(
+              [](Solver& self, const RealScalar& thresh) -> void {
+                return self.setPivotThreshold(thresh);
+              }),
           "Set the threshold used for a diagonal entry to be an acceptable "
           "pivot.")
 
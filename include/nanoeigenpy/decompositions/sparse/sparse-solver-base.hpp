@@ -3,6 +3,10 @@
 #pragma once
 
 #include "nanoeigenpy/fwd.hpp"
+#include "nanoeigenpy/decompositions/sparse/sparse-triangular-solve.hpp"
+#include "nanoeigenpy/utils/sparse-matrix-handle.hpp"
+#include "nanoeigenpy/utils/async.hpp"
+#include "nanoeigenpy/utils/instrumented-method.hpp"
 #include <nanobind/eigen/sparse.h>
 #include <Eigen/SparseCholesky>
 
@@ -11,11 +15,103 @@ namespace nanoeigenpy {
 /// \addtogroup sparse_solvers
 ///
 /// \brief Base visitor for all sparse matrix solvers.
+/// It adds the analyzePattern(), factorize() and compute() methods that the
+/// solver provides, with the ordering argument of the solvers using a
+/// RuntimeOrdering, and the solves. It also adds the overloads taking a
+/// SparseMatrixHandle, and the asynchronous variants of compute() and solve().
+/// All of them are counted and timed in the statistics of the module (see
+/// instrumentation).
 /// \note The use of `Eigen::Ref` in the first two overloads of \c solve helps
 /// disambiguate the dense matrix type and the sparse matrix type.
-struct SparseSolverBaseVisitor : nb::def_visitor<SparseSolverBaseVisitor> {
+/// \tparam LockSolve Whether \c solve takes the lock of the solver
+/// exclusively, for backends whose solve writes into the solver (e.g.
+/// Cholmod's workspace). Otherwise, it takes it shared, so that concurrent
+/// solves on a shared factorization run in parallel.
+template <bool LockSolve = false>
+struct SparseSolverBaseVisitor
+    : nb::def_visitor<SparseSolverBaseVisitor<LockSolve>> {
   template <typename SimplicialDerived, typename... Ts>
-  void execute(nb::class_<SimplicialDerived, Ts...> &cl) {
+  void execute(nb::class_<SimplicialDerived, Ts...> &cl) const {
+    exposeFactorization(cl);
+    exposeSolve(cl);
+    using SparseMatrixType = typename SimplicialDerived::MatrixType;
+    cl.def(SparseMatrixHandleVisitor<SparseMatrixType>())
+        .def(AsyncVisitor<SparseMatrixType, LockSolve>());
+  }
+
+ private:
+  static constexpr locks::Mode solveMode =
+      LockSolve ? locks::Mode::Exclusive : locks::Mode::Shared;
+
+  template <typename SimplicialDerived, typename... Ts>
+  static void exposeFactorization(nb::class_<SimplicialDerived, Ts...> &cl) {
+    using namespace nb::literals;
+    using Solver = SimplicialDerived;
+    using MatrixType = typename SimplicialDerived::MatrixType;
+    constexpr locks::Mode exclusive = locks::Mode::Exclusive;
+
+    if constexpr (detail::has_runtime_ordering<Solver>::value) {
+      constexpr OrderingMethod defaultOrdering =
+          Solver::OrderingType::DefaultMethod;
+      cl.def(instrumentedMethod<exclusive>(
+                 "analyzePattern",
+                 withOrdering<Solver>(
+                     [](Solver &self, const MatrixType &matrix) {
+                       self.analyzePattern(matrix);
+                     }),
+                 "matrix"_a, "ordering"_a = defaultOrdering,
+                 "Performs a symbolic decomposition on the sparcity of "
+                 "matrix, with the given fill-reducing ordering.\n"
+                 "This function is particularly useful when solving for "
+                 "several problems having the same structure."))
+          .def(computeMethod(
+              withOrdering<Solver>(
+                  [](Solver &self, const MatrixType &matrix) -> Solver & {
+                    self.compute(matrix);
+                    return self;
+                  }),
+              "matrix"_a, "ordering"_a = defaultOrdering,
+              "Computes the symbolic and numeric decompositions of a given "
+              "matrix, with the given fill-reducing ordering."));
+    } else {
+      if constexpr (detail::has_analyze_pattern<Solver, MatrixType>::value) {
+        cl.def(instrumentedMethod<exclusive>(
+            "analyzePattern",
+            [](Solver &self, const MatrixType &matrix) {
+              self.analyzePattern(matrix);
+            },
+            "matrix"_a,
+            "Performs a symbolic decomposition on the sparcity of matrix.\n"
+            "This function is particularly useful when solving for several "
+            "problems having the same structure."));
+      }
+      if constexpr (detail::has_compute<Solver, MatrixType>::value) {
+        cl.def(computeMethod(
+            [](Solver &self, const MatrixType &matrix) -> Solver & {
+              self.compute(matrix);
+              return self;
+            },
+            "matrix"_a,
+            "Computes the symbolic and numeric decompositions of a given "
+            "matrix."));
+      }
+    }
+    if constexpr (detail::has_factorize<Solver, MatrixType>::value) {
+      cl.def(instrumentedMethod<exclusive>(
+          "factorize",
+          [](Solver &self, const MatrixType &matrix) {
+            self.factorize(matrix);
+          },
+          "matrix"_a,
+          "Performs a numeric decomposition of a given matrix.\n"
+          "The given matrix must has the same sparcity than the matrix on "
+          "which the symbolic decomposition has been performed.\n"
+          "See also analyzePattern()."));
+    }
+  }
+
+  template <typename SimplicialDerived, typename... Ts>
+  static void exposeSolve(nb::class_<SimplicialDerived, Ts...> &cl) {
     using namespace nb::literals;
     using Solver = SimplicialDerived;
     static_assert(nb::is_base_of_template_v<Solver, Eigen::SparseSolverBase>,
@@ -28,27 +124,39 @@ struct SparseSolverBaseVisitor : nb::def_visitor<SparseSolverBaseVisitor> {
     using DenseMatrixXs =
         Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic, Options>;
 
-    cl.def(
-          "solve",
-          [](const Solver &self, const Eigen::Ref<DenseVectorXs const> &b)
-              -> DenseVectorXs { return self.solve(b); },
-          "b"_a,
-          "Returns the solution x of A x = b using the current decomposition "
-          "of A, where b is a right hand side vector.")
-        .def(
+    cl.def(instrumentedMethod<solveMode>(
+              "solve",
+              [](const Solver &self, const Eigen::Ref<DenseVectorXs const> &b)
+                  -> DenseVectorXs { return self.solve(b); },
+              "b"_a,
+              "Returns the solution x of A x = b using the current "
+              "decomposition of A, where b is a right hand side vector."))
+        .def(instrumentedMethod<solveMode>(
             "solve",
             [](const Solver &self, const Eigen::Ref<DenseMatrixXs const> &B)
                 -> DenseMatrixXs { return self.solve(B); },
             "B"_a,
             "Returns the solution X of A X = B using the current decomposition "
-            "of A where B is a right hand side matrix.")
-        .def(
+            "of A where B is a right hand side matrix."))
+        .def(instrumentedMethod<solveMode>(
             "solve",
             [](const Solver &self, const SparseMatrixType &B)
-                -> SparseMatrixType { return self.solve(B); },
+                -> SparseMatrixType { return sparseRhsSolve(self, B); },
+            "B"_a,
+            "Returns the solution X of A X = B using the current decomposition "
+            "of A where B is a sparse right hand side matrix. With "
+            "SimplicialLLT, SimplicialLDLT and SparseLU, only the columns of "
+            "the factors reachable from the nonzeros of B are visited."))
+        .def(instrumentedMethod<solveMode>(
+            "solve",
+            [](const Solver &self,
+               const SparseMatrixHandle<SparseMatrixType> &B)
+                -> SparseMatrixType {
+              return sparseRhsSolve(self, B.matrix());
+            },
             "B"_a,
             "Returns the solution X of A X = B using the current decomposition "
-            "of A where B is a right hand side matrix.");
+            "of A where B is a right hand side SparseMatrix."));
   }
 };
 
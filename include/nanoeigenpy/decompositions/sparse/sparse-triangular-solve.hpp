@@ -0,0 +1,501 @@
+/// Copyright 2025 INRIA
+
+#pragma once
+
+#include "nanoeigenpy/fwd.hpp"
+#include "nanoeigenpy/decompositions/sparse/symbolic-cholesky.hpp"
+#include <Eigen/SparseCholesky>
+#include <Eigen/SparseLU>
+
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace nanoeigenpy {
+
+/// \brief Solves triangular systems with a sparse right hand side (Gilbert
+/// and Peierls).
+///
+/// The nonzero pattern of the solution of T x = b is the set of the nodes
+/// reachable from the nonzeros of b in the graph of T, which has an edge
+/// j -> i for each off-diagonal nonzero T(i, j). It is computed by a depth
+/// first search, which also gives the topological order in which the columns
+/// of T are applied, so that the cost of a solve is proportional to the
+/// number of flops rather than to the size of T.
+///
+/// The matrix T is only accessed by columns through two functors:
+/// column(j, f) calls f(i, T(i, j)) for the off-diagonal nonzeros of the
+/// column j, and diagonal(j) returns T(j, j).
+template <typename _Scalar, typename _StorageIndex>
+class SparseTriangularSolver {
+ public:
+  using Scalar = _Scalar;
+  using StorageIndex = _StorageIndex;
+
+  explicit SparseTriangularSolver(Eigen::Index size)
+      : m_x(size, Scalar(0)), m_mark(size, 0) {}
+
+  /// \brief Resizes the workspace for triangular matrices of order \a size.
+  /// It is kept when the size does not change.
+  void resize(Eigen::Index size) {
+    if (Eigen::Index(m_x.size()) == size) return;
+    m_x.assign(size, Scalar(0));
+    m_mark.assign(size, 0);
+    m_stamp = 0;
+  }
+
+  /// \brief Dense workspace holding the right hand side and the solution.
+  /// It must be reset to zero on the nonzero pattern after each solve.
+  std::vector<Scalar> &values() { return m_x; }
+
+  /// \returns the nodes reachable from \a start in the graph given by
+  /// \a column, in topological order.
+  template <typename Column>
+  const std::vector<StorageIndex> &reach(const std::vector<StorageIndex> &start,
+                                         Column column) {
+    reach(start, column, Eigen::Index(m_x.size()));
+    return m_pattern;
+  }
+
+  /// \brief Same as reach(), but gives up and returns false as soon as more
+  /// than \a max_size nodes are reached, when a dense solve is cheaper.
+  template <typename Column>
+  bool reach(const std::vector<StorageIndex> &start, Column column,
+             Eigen::Index max_size) {
+    ++m_stamp;
+    m_pattern.clear();
+    m_stack.clear();
+    Eigen::Index visited = 0;
+    // A node j is pushed as j to be visited, and as -j - 1 to be finished
+    // once all its successors are finished.
+    for (StorageIndex s : start) {
+      if (m_mark[s] == m_stamp) continue;
+      m_stack.push_back(s);
+      while (!m_stack.empty()) {
+        const StorageIndex j = m_stack.back();
+        m_stack.pop_back();
+        if (j < 0) {
+          m_pattern.push_back(-j - 1);
+          continue;
+        }
+        if (m_mark[j] == m_stamp) continue;
+        if (++visited > max_size) return false;
+        m_mark[j] = m_stamp;
+        m_stack.push_back(-j - 1);
+        column(j, [this](StorageIndex i, const Scalar &) {
+          if (m_mark[i] != m_stamp) m_stack.push_back(i);
+        });
+      }
+    }
+    std::reverse(m_pattern.begin(), m_pattern.end());
+    return true;
+  }
+
+  /// \returns the pattern computed by the last call to reach().
+  const std::vector<StorageIndex> &pattern() const { return m_pattern; }
+
+  /// \brief Solves T x = b in place in values(), where \a pattern is the
+  /// result of reach().
+  template <typename Column, typename Diagonal>
+  void solve(const std::vector<StorageIndex> &pattern, Column column,
+             Diagonal diagonal) {
+    for (StorageIndex j : pattern) {
+      m_x[j] /= diagonal(j);
+      const Scalar xj = m_x[j];
+      if (xj == Scalar(0)) continue;
+      column(j, [this, &xj](StorageIndex i, const Scalar &value) {
+        m_x[i] -= value * xj;
+      });
+    }
+  }
+
+ protected:
+  std::vector<Scalar> m_x;
+  std::vector<Eigen::Index> m_mark;
+  Eigen::Index m_stamp = 0;
+  std::vector<StorageIndex> m_stack;
+  std::vector<StorageIndex> m_pattern;
+};
+
+namespace detail {
+
+/// \brief Elimination forest of a simplicial factor, and workspace of the
+/// sparse right hand side solves with it.
+///
+/// The solves with a factor reuse its forest, whose postorder is only
+/// recomputed when the parents of the nodes change, i.e. when the factor
+/// has a new pattern. The entries are per thread, so that concurrent solves
+/// do not share their workspaces.
+template <typename _Scalar, typename _StorageIndex>
+struct SimplicialSolveCache {
+  using Scalar = _Scalar;
+  using StorageIndex = _StorageIndex;
+
+  /// Solver of the last solve which used this entry.
+  const void *owner = nullptr;
+  /// Parent of each node, nodes in postorder, position of each node in the
+  /// postorder and position of its first descendant.
+  std::vector<StorageIndex> parent, post, position, first;
+  /// Parents of the factor of the current solve, compared with parent.
+  std::vector<StorageIndex> newParent;
+  SparseTriangularSolver<Scalar, StorageIndex> triangular{0};
+  std::vector<StorageIndex> start, nodes;
+  std::vector<std::pair<StorageIndex, Scalar>> buffer;
+  /// Whether the workspace of triangular is zero, which is false after a
+  /// solve interrupted by an exception.
+  bool clean = true;
+
+  /// \brief Sets the forest to newParent, and recomputes its postorder if
+  /// it changed.
+  void updateForest() {
+    if (newParent == parent) return;
+    parent.swap(newParent);
+    const Eigen::Index size = Eigen::Index(parent.size());
+    post = postorder(parent);
+    position.resize(size);
+    first.resize(size);
+    std::vector<StorageIndex> descendants(size, 1);
+    for (Eigen::Index k = 0; k < size; ++k) {
+      const StorageIndex j = post[k];
+      position[j] = StorageIndex(k);
+      first[j] = StorageIndex(k + 1 - descendants[j]);
+      if (parent[j] >= 0) descendants[parent[j]] += descendants[j];
+    }
+  }
+};
+
+/// \brief Returns the cache entry of the current thread for the solves with
+/// \a solver. The least recently assigned of a few entries is reassigned to
+/// a new solver, which bounds the memory kept by each thread.
+template <typename Scalar, typename StorageIndex>
+SimplicialSolveCache<Scalar, StorageIndex> &simplicialSolveCache(
+    const void *solver) {
+  constexpr std::size_t kEntries = 4;
+  thread_local std::array<SimplicialSolveCache<Scalar, StorageIndex>, kEntries>
+      entries;
+  thread_local std::size_t next = 0;
+  for (auto &entry : entries)
+    if (entry.owner == solver) return entry;
+  auto &entry = entries[next];
+  next = (next + 1) % kEntries;
+  entry = SimplicialSolveCache<Scalar, StorageIndex>();
+  entry.owner = solver;
+  return entry;
+}
+
+/// \brief Scatters the column \a k of \a b, permuted by \a perm (empty for
+/// the identity), into the workspace of \a solver.
+template <typename Solver, typename Rhs, typename Indices>
+void scatterColumn(Solver &solver, const Rhs &b, Eigen::Index k,
+                   const Indices &perm,
+                   std::vector<typename Solver::StorageIndex> &start) {
+  using StorageIndex = typename Solver::StorageIndex;
+  start.clear();
+  for (typename Rhs::InnerIterator it(b, k); it; ++it) {
+    const StorageIndex i =
+        perm.size() > 0 ? perm(it.index()) : StorageIndex(it.index());
+    solver.values()[i] += it.value();
+    start.push_back(i);
+  }
+}
+
+/// \brief Appends the workspace of \a solver as the column \a k of \a res,
+/// and resets it. The entry j of the workspace is stored in the row i such
+/// that \a inverse(i) == j (empty for the identity).
+template <typename ResultType, typename Solver, typename Indices>
+void gatherDenseColumn(ResultType &res, Eigen::Index k, Solver &solver,
+                       const Indices &inverse) {
+  using StorageIndex = typename Solver::StorageIndex;
+  using Scalar = typename Solver::Scalar;
+  res.startVec(k);
+  for (Eigen::Index i = 0; i < res.rows(); ++i) {
+    Scalar &value =
+        solver.values()[inverse.size() > 0 ? inverse(i) : StorageIndex(i)];
+    if (value != Scalar(0)) res.insertBackByOuterInner(k, i) = value;
+    value = Scalar(0);
+  }
+}
+
+/// \brief Appends the nonzeros of the workspace of \a solver at the
+/// positions \a entries as the column \a k of \a res, and resets them. The
+/// entry j is stored in the row \a perm(j), and \a inverse is the inverse
+/// permutation (both empty for the identity). Large columns are gathered
+/// by scanning the workspace in the order of the rows, instead of sorting.
+template <typename ResultType, typename Solver, typename Indices>
+void gatherColumn(
+    ResultType &res, Eigen::Index k, Solver &solver,
+    const std::vector<typename Solver::StorageIndex> &entries,
+    const Indices &perm, const Indices &inverse,
+    std::vector<std::pair<typename Solver::StorageIndex,
+                          typename Solver::Scalar>> &buffer) {
+  using StorageIndex = typename Solver::StorageIndex;
+  using Scalar = typename Solver::Scalar;
+  if (4 * Eigen::Index(entries.size()) > res.rows()) {
+    gatherDenseColumn(res, k, solver, inverse);
+    return;
+  }
+  buffer.clear();
+  for (StorageIndex j : entries) {
+    Scalar &value = solver.values()[j];
+    if (value != Scalar(0))
+      buffer.emplace_back(perm.size() > 0 ? perm(j) : j, value);
+    value = Scalar(0);
+  }
+  std::sort(buffer.begin(), buffer.end(),
+            [](const auto &a, const auto &b) { return a.first < b.first; });
+  res.startVec(k);
+  for (const auto &entry : buffer)
+    res.insertBackByOuterInner(k, entry.first) = entry.second;
+}
+
+template <typename SolverType, typename Rhs>
+Eigen::SparseMatrix<typename SolverType::Scalar, Eigen::ColMajor,
+                    typename SolverType::StorageIndex>
+simplicialSparseRhsSolve(const SolverType &solver,
+                         const Eigen::SparseMatrixBase<Rhs> &b,
+                         bool lower_only) {
+  using Scalar = typename SolverType::Scalar;
+  using StorageIndex = typename SolverType::StorageIndex;
+  using MatrixL = std::decay_t<decltype(solver.matrixL())>;
+  using CholMatrixType = std::decay_t<decltype(
+      std::declval<const MatrixL &>().nestedExpression())>;
+  using ResultType = Eigen::SparseMatrix<Scalar, Eigen::ColMajor, StorageIndex>;
+  constexpr bool unit_diagonal = (MatrixL::Mode & Eigen::UnitDiag) != 0;
+
+  const Eigen::Index size = solver.rows();
+  if (b.rows() != size)
+    throw std::invalid_argument(
+        "solve: the number of rows of B does not match the matrix.");
+  const MatrixL matrix_l = solver.matrixL();
+  const CholMatrixType &L = matrix_l.nestedExpression();
+  const auto &perm = solver.permutationP().indices();
+  const auto &perm_inv = solver.permutationPinv().indices();
+
+  // Off-diagonal entries of the column j, which are below the diagonal.
+  auto column = [&L](StorageIndex j, auto f) {
+    for (typename CholMatrixType::InnerIterator it(L, j); it; ++it)
+      if (it.index() > j) f(StorageIndex(it.index()), it.value());
+  };
+  // The columns of a simplicial factor are sorted, and with a simplicial
+  // LLT the diagonal is the first entry of each column.
+  auto diagonal = [&L](StorageIndex j) -> Scalar {
+    return unit_diagonal ? Scalar(1) : L.valuePtr()[L.outerIndexPtr()[j]];
+  };
+
+  // The solution of L^T x = y is nonzero on whole trees of the elimination
+  // forest: x is computed tree by tree, with the nodes of a tree stored
+  // contiguously in postorder. The forest and the workspace are kept from the
+  // previous solves with this factor.
+  auto &cache = simplicialSolveCache<Scalar, StorageIndex>(&solver);
+  if (!lower_only) {
+    // The parent of j is the first off-diagonal row of the column j of L.
+    cache.newParent.assign(size, -1);
+    for (Eigen::Index j = 0; j < size; ++j) {
+      for (typename CholMatrixType::InnerIterator it(L, j); it; ++it) {
+        if (it.index() > j) {
+          cache.newParent[j] = StorageIndex(it.index());
+          break;
+        }
+      }
+    }
+    cache.updateForest();
+  }
+  const std::vector<StorageIndex> &parent = cache.parent;
+  const std::vector<StorageIndex> &post = cache.post;
+  const std::vector<StorageIndex> &position = cache.position;
+  const std::vector<StorageIndex> &first = cache.first;
+
+  SparseTriangularSolver<Scalar, StorageIndex> &triangular = cache.triangular;
+  triangular.resize(size);
+  std::vector<Scalar> &x = triangular.values();
+  if (!cache.clean) std::fill(x.begin(), x.end(), Scalar(0));
+  cache.clean = false;
+  Eigen::Map<Eigen::Matrix<Scalar, Eigen::Dynamic, 1>> x_dense(x.data(), size);
+  std::vector<StorageIndex> &start = cache.start;
+  std::vector<StorageIndex> &nodes = cache.nodes;
+  std::vector<std::pair<StorageIndex, Scalar>> &buffer = cache.buffer;
+  const Eigen::Matrix<StorageIndex, Eigen::Dynamic, 1> no_permutation;
+  ResultType res(size, b.cols());
+  for (Eigen::Index k = 0; k < b.cols(); ++k) {
+    scatterColumn(triangular, b.derived(), k, perm, start);
+    // The columns whose solution is dense are computed by plain
+    // substitutions, which are faster.
+    if (!triangular.reach(start, column, size / 4)) {
+      solver.matrixL().solveInPlace(x_dense);
+      if (lower_only) {
+        gatherDenseColumn(res, k, triangular, no_permutation);
+        continue;
+      }
+      if constexpr (unit_diagonal) x_dense.array() /= solver.vectorD().array();
+      solver.matrixU().solveInPlace(x_dense);
+      gatherDenseColumn(res, k, triangular, perm);
+      continue;
+    }
+    const std::vector<StorageIndex> &pattern = triangular.pattern();
+    triangular.solve(pattern, column, diagonal);
+    if (lower_only) {
+      gatherColumn(res, k, triangular, pattern, no_permutation, no_permutation,
+                   buffer);
+      continue;
+    }
+
+    if constexpr (unit_diagonal) {
+      const auto &d = solver.vectorD();
+      for (StorageIndex j : pattern) x[j] /= d(j);
+    }
+    Eigen::Index touched = 0;
+    for (StorageIndex root : pattern)
+      if (parent[root] < 0) touched += position[root] + 1 - first[root];
+    if (touched > size / 4) {
+      solver.matrixU().solveInPlace(x_dense);
+      gatherDenseColumn(res, k, triangular, perm);
+      continue;
+    }
+    nodes.clear();
+    for (StorageIndex root : pattern) {
+      if (parent[root] >= 0) continue;
+      // Reverse postorder: the ancestors of a node are computed before it.
+      for (StorageIndex p = position[root]; p >= first[root]; --p) {
+        const StorageIndex j = post[p];
+        Scalar xj = x[j];
+        column(j, [&xj, &x](StorageIndex i, const Scalar &value) {
+          xj -= Eigen::numext::conj(value) * x[i];
+        });
+        x[j] = xj / Eigen::numext::conj(diagonal(j));
+        nodes.push_back(j);
+      }
+    }
+    gatherColumn(res, k, triangular, nodes, perm_inv, perm, buffer);
+  }
+  cache.clean = true;
+  res.finalize();
+  return res;
+}
+
+}  // namespace detail
+
+/// \brief Returns the solution of A X = B for a sparse \a b, by sparse
+/// triangular solves with the simplicial Cholesky factor (P A P^T = L L^T).
+///
+/// When \a lower_only is true, returns L^-1 P B instead, whose sparsity
+/// only depends on the reach of B in the graph of L. This is the building
+/// block of Schur complements B^T A^-1 B = (L^-1 P B)^T (L^-1 P B).
+template <typename MatrixType, int UpLo, typename Ordering, typename Rhs>
+Eigen::SparseMatrix<typename MatrixType::Scalar, Eigen::ColMajor,
+                    typename MatrixType::StorageIndex>
+sparseRhsSolve(const Eigen::SimplicialLLT<MatrixType, UpLo, Ordering> &solver,
+               const Eigen::SparseMatrixBase<Rhs> &b, bool lower_only = false) {
+  return detail::simplicialSparseRhsSolve(solver, b, lower_only);
+}
+
+/// \brief Returns the solution of A X = B for a sparse \a b, by sparse
+/// triangular solves with the simplicial Cholesky factor
+/// (P A P^T = L D L^T). When \a lower_only is true, returns L^-1 P B.
+template <typename MatrixType, int UpLo, typename Ordering, typename Rhs>
+Eigen::SparseMatrix<typename MatrixType::Scalar, Eigen::ColMajor,
+                    typename MatrixType::StorageIndex>
+sparseRhsSolve(const Eigen::SimplicialLDLT<MatrixType, UpLo, Ordering> &solver,
+               const Eigen::SparseMatrixBase<Rhs> &b, bool lower_only = false) {
+  return detail::simplicialSparseRhsSolve(solver, b, lower_only);
+}
+
+/// \brief Returns the solution of A X = B for a sparse \a b, by sparse
+/// triangular solves with the supernodal factors (P_r A P_c^T = L U).
+/// When \a lower_only is true, returns L^-1 P_r B.
+template <typename MatrixType, typename Ordering, typename Rhs>
+Eigen::SparseMatrix<typename MatrixType::Scalar, Eigen::ColMajor,
+                    typename MatrixType::StorageIndex>
+sparseRhsSolve(const Eigen::SparseLU<MatrixType, Ordering> &solver,
+               const Eigen::SparseMatrixBase<Rhs> &b, bool lower_only = false) {
+  using Scalar = typename MatrixType::Scalar;
+  using StorageIndex = typename MatrixType::StorageIndex;
+  using ResultType = Eigen::SparseMatrix<Scalar, Eigen::ColMajor, StorageIndex>;
+
+  const Eigen::Index size = solver.rows();
+  if (b.rows() != size)
+    throw std::invalid_argument(
+        "solve: the number of rows of B does not match the matrix.");
+  const auto matrix_l = solver.matrixL();
+  const auto matrix_u = solver.matrixU();
+  const auto &supernodes = matrix_u.m_mapL;
+  const auto &upper = matrix_u.m_mapU;
+  using SCMatrix = std::decay_t<decltype(supernodes)>;
+  using UMatrix = std::decay_t<decltype(upper)>;
+
+  // The supernodes store the columns of L and the diagonal blocks of U, the
+  // rest of U is in a column-major sparse matrix.
+  auto column_l = [&supernodes](StorageIndex j, auto f) {
+    for (typename SCMatrix::InnerIterator it(supernodes, j); it; ++it)
+      if (it.row() > j) f(StorageIndex(it.row()), it.value());
+  };
+  auto diagonal_l = [](StorageIndex) { return Scalar(1); };
+  auto column_u = [&supernodes, &upper](StorageIndex j, auto f) {
+    for (typename SCMatrix::InnerIterator it(supernodes, j); it; ++it)
+      if (it.row() < j) f(StorageIndex(it.row()), it.value());
+    for (typename UMatrix::InnerIterator it(upper, j); it; ++it)
+      f(StorageIndex(it.index()), it.value());
+  };
+  auto diagonal_u = [&supernodes](StorageIndex j) -> Scalar {
+    const StorageIndex fsupc = supernodes.supToCol()[supernodes.colToSup()[j]];
+    return supernodes.valuePtr()[supernodes.colIndexPtr()[j] + j - fsupc];
+  };
+
+  using PermutationType =
+      typename Eigen::SparseLU<MatrixType, Ordering>::PermutationType;
+  const auto &perm_r = solver.rowsPermutation().indices();
+  const auto &perm_c = solver.colsPermutation().indices();
+  const PermutationType perm_c_inv = solver.colsPermutation().inverse();
+  const Eigen::Matrix<StorageIndex, Eigen::Dynamic, 1> no_permutation;
+
+  SparseTriangularSolver<Scalar, StorageIndex> triangular(size);
+  Eigen::Map<Eigen::Matrix<Scalar, Eigen::Dynamic, 1>> x(
+      triangular.values().data(), size);
+  std::vector<StorageIndex> start;
+  std::vector<std::pair<StorageIndex, Scalar>> buffer;
+  ResultType res(size, b.cols());
+  for (Eigen::Index k = 0; k < b.cols(); ++k) {
+    detail::scatterColumn(triangular, b.derived(), k, perm_r, start);
+    // The columns whose solution is dense are computed by plain
+    // substitutions, which use the supernodes and are faster.
+    if (!triangular.reach(start, column_l, size / 4)) {
+      matrix_l.solveInPlace(x);
+      if (lower_only) {
+        detail::gatherDenseColumn(res, k, triangular, no_permutation);
+        continue;
+      }
+      matrix_u.solveInPlace(x);
+      detail::gatherDenseColumn(res, k, triangular, perm_c);
+      continue;
+    }
+    start = triangular.pattern();
+    triangular.solve(start, column_l, diagonal_l);
+    if (lower_only) {
+      detail::gatherColumn(res, k, triangular, start, no_permutation,
+                           no_permutation, buffer);
+      continue;
+    }
+    if (triangular.reach(start, column_u, size / 16)) {
+      triangular.solve(triangular.pattern(), column_u, diagonal_u);
+      detail::gatherColumn(res, k, triangular, triangular.pattern(),
+                           perm_c_inv.indices(), perm_c, buffer);
+    } else {
+      matrix_u.solveInPlace(x);
+      detail::gatherDenseColumn(res, k, triangular, perm_c);
+    }
+  }
+  res.finalize();
+  return res;
+}
+
+/// \brief Sparse right hand side solve of the solvers without a specialized
+/// path: B is solved through dense panels.
+template <typename Solver, typename Rhs>
+typename Solver::MatrixType sparseRhsSolve(
+    const Solver &solver, const Eigen::SparseMatrixBase<Rhs> &b) {
+  return solver.solve(b);
+}
+
+}  // namespace nanoeigenpy
@@ -0,0 +1,522 @@
+/// Copyright 2025 INRIA
+
+#pragma once
+
+#include "nanoeigenpy/fwd.hpp"
+#include "nanoeigenpy/decompositions/sparse/sparse-solver-base.hpp"
+#include "nanoeigenpy/decompositions/sparse/symbolic-cholesky.hpp"
+#include "nanoeigenpy/utils/object-lock.hpp"
+#include <Eigen/Cholesky>
+#include <Eigen/SparseCholesky>
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace nanoeigenpy {
+namespace nb = nanobind;
+using namespace nb::literals;
+
+/// \brief Multifrontal supernodal sparse LL^T Cholesky factorization.
+///
+/// The symbolic analysis applies the fill-reducing \a _Ordering, postorders
+/// the elimination tree and groups the columns of L with the same structure
+/// into fundamental supernodes. The numeric factorization then traverses the
+/// supernodal tree: each supernode assembles its frontal matrix from A and the
+/// update matrices of its children, and factorizes it with the dense blocked
+/// kernels of Eigen (LLT, triangular solve and rank-k update), which map to
+/// BLAS-3 operations.
+///
+/// When compiled with OpenMP, independent subtrees are factorized in parallel:
+/// every leaf starts a task, and a supernode is processed by the task that
+/// completes its last child.
+///
+/// Like SimplicialLLT, the factorized matrix is P A P^-1 = L L^T and only the
+/// \a _UpLo triangular part of A is referenced.
+template <
+    typename _MatrixType, int _UpLo = Eigen::Lower,
+    typename _Ordering = RuntimeOrdering<typename _MatrixType::StorageIndex,
+                                         OrderingMethod::AMD>>
+class SupernodalLLT : public Eigen::SparseSolverBase<
+                          SupernodalLLT<_MatrixType, _UpLo, _Ordering>> {
+  using Base = Eigen::SparseSolverBase<SupernodalLLT>;
+  using Base::m_isInitialized;
+
+ public:
+  using MatrixType = _MatrixType;
+  using OrderingType = _Ordering;
+  enum { UpLo = _UpLo };
+  using Scalar = typename MatrixType::Scalar;
+  using RealScalar = typename MatrixType::RealScalar;
+  using StorageIndex = typename MatrixType::StorageIndex;
+  using CholMatrixType =
+      Eigen::SparseMatrix<Scalar, Eigen::ColMajor, StorageIndex>;
+  using DenseMatrix = Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>;
+  using PermutationType =
+      Eigen::PermutationMatrix<Eigen::Dynamic, Eigen::Dynamic, StorageIndex>;
+  enum {
+    ColsAtCompileTime = MatrixType::ColsAtCompileTime,
+    MaxColsAtCompileTime = MatrixType::MaxColsAtCompileTime
+  };
+
+  SupernodalLLT()
+      : m_info(Eigen::Success),
+        m_analysisIsOk(false),
+        m_factorizationIsOk(false) {}
+
+  explicit SupernodalLLT(const MatrixType &matrix) : SupernodalLLT() {
+    compute(matrix);
+  }
+
+  using Base::_solve_impl;
+
+  /// \brief Computes the symbolic and numeric factorizations of \a matrix.
+  SupernodalLLT &compute(const MatrixType &matrix) {
+    analyzePattern(matrix);
+    factorize(matrix);
+    return *this;
+  }
+
+  /// \brief Computes the fill-reducing ordering, the elimination tree and the
+  /// supernodal structure of L from the sparsity pattern of \a matrix.
+  void analyzePattern(const MatrixType &matrix) {
+    eigen_assert(matrix.rows() == matrix.cols());
+    const Eigen::Index size = matrix.cols();
+    m_isInitialized = true;
+    m_info = Eigen::Success;
+    m_factorizationIsOk = false;
+
+    // Fill-reducing ordering, as in SimplicialCholeskyBase::ordering.
+    PermutationType p;
+    {
+      CholMatrixType c;
+      c = matrix.template selfadjointView<UpLo>();
+      PermutationType pinv;
+      OrderingType ordering;
+      ordering(c, pinv);
+      if (pinv.size() > 0)
+        p = pinv.inverse();
+      else
+        p.setIdentity(size);
+    }
+
+    // Postorder the elimination tree so that the columns of a supernode and
+    // the supernodes of a subtree are contiguous.
+    CholMatrixType upper;
+    std::vector<StorageIndex> parent;
+    permutedUpper(matrix, p, upper);
+    detail::eliminationTree(upper, parent);
+    const std::vector<StorageIndex> post = detail::postorder(parent);
+    m_P.resize(size);
+    for (Eigen::Index k = 0; k < size; ++k)
+      m_P.indices()(post[k]) = StorageIndex(k);
+    m_P = PermutationType(m_P * p);
+    m_Pinv = m_P.inverse();
+    permutedUpper(matrix, m_P, upper);
+    detail::eliminationTree(upper, parent);
+    const std::vector<StorageIndex> colCount =
+        detail::columnCounts(upper, parent);
+
+    // Fundamental supernodes: column j extends the supernode of column j - 1
+    // when it is the only child of j and L(:, j) has the same structure.
+    std::vector<StorageIndex> childCount(size, 0);
+    for (Eigen::Index j = 0; j < size; ++j)
+      if (parent[j] >= 0) ++childCount[parent[j]];
+    m_superStart.clear();
+    std::vector<StorageIndex> superOf(size);
+    for (Eigen::Index j = 0; j < size; ++j) {
+      if (j == 0 || parent[j - 1] != j || childCount[j] != 1 ||
+          colCount[j - 1] != colCount[j] + 1)
+        m_superStart.push_back(StorageIndex(j));
+      superOf[j] = StorageIndex(m_superStart.size() - 1);
+    }
+    const Eigen::Index nsuper = Eigen::Index(m_superStart.size());
+    m_superStart.push_back(StorageIndex(size));
+    m_superParent.assign(nsuper, -1);
+    for (Eigen::Index s = 0; s < nsuper; ++s) {
+      const StorageIndex last = m_superStart[s + 1] - 1;
+      if (parent[last] >= 0) m_superParent[s] = superOf[parent[last]];
+    }
+
+    // Children of each supernode, in increasing order.
+    m_children.assign(nsuper + 1, 0);
+    for (Eigen::Index s = 0; s < nsuper; ++s)
+      if (m_superParent[s] >= 0) ++m_children[m_superParent[s] + 1];
+    for (Eigen::Index s = 0; s < nsuper; ++s)
+      m_children[s + 1] += m_children[s];
+    m_childIdx.resize(m_children[nsuper]);
+    {
+      std::vector<StorageIndex> next(m_children.begin(), m_children.end() - 1);
+      for (Eigen::Index s = 0; s < nsuper; ++s)
+        if (m_superParent[s] >= 0)
+          m_childIdx[next[m_superParent[s]]++] = StorageIndex(s);
+    }
+
+    // Row structure of the supernodes, in increasing order of the rows.
+    m_rowPtr.assign(nsuper + 1, 0);
+    m_valuePtr.assign(nsuper + 1, 0);
+    for (Eigen::Index s = 0; s < nsuper; ++s) {
+      const StorageIndex nrows = colCount[m_superStart[s]];
+      m_rowPtr[s + 1] = m_rowPtr[s] + nrows;
+      m_valuePtr[s + 1] =
+          m_valuePtr[s] +
+          Eigen::Index(nrows) * (m_superStart[s + 1] - m_superStart[s]);
+    }
+    m_rowIdx.resize(m_rowPtr[nsuper]);
+    std::vector<StorageIndex> flag(size, -1);
+    const CholMatrixType lower = upper.transpose();
+    for (Eigen::Index s = 0; s < nsuper; ++s) {
+      const StorageIndex first = m_superStart[s];
+      const StorageIndex last = m_superStart[s + 1] - 1;
+      StorageIndex *rows = m_rowIdx.data() + m_rowPtr[s];
+      Eigen::Index count = 0;
+      for (StorageIndex j = first; j <= last; ++j) {
+        rows[count++] = j;
+        flag[j] = StorageIndex(s);
+      }
+      for (StorageIndex j = first; j <= last; ++j) {
+        for (typename CholMatrixType::InnerIterator it(lower, j); it; ++it) {
+          const StorageIndex i = it.index();
+          if (i > last && flag[i] != s) {
+            rows[count++] = i;
+            flag[i] = StorageIndex(s);
+          }
+        }
+      }
+      // The rows of the children below this supernode; the children are
+      // numbered before their parent by the postordering.
+      for (StorageIndex k = m_children[s]; k < m_children[s + 1]; ++k) {
+        const StorageIndex c = m_childIdx[k];
+        for (StorageIndex k = m_rowPtr[c]; k < m_rowPtr[c + 1]; ++k) {
+          const StorageIndex i = m_rowIdx[k];
+          if (i > last && flag[i] != s) {
+            rows[count++] = i;
+            flag[i] = StorageIndex(s);
+          }
+        }
+      }
+      eigen_assert(count == m_rowPtr[s + 1] - m_rowPtr[s]);
+      std::sort(rows + (last - first + 1), rows + count);
+    }
+
+    m_values.resize(m_valuePtr[nsuper]);
+    m_analysisIsOk = true;
+  }
+
+  /// \brief Performs the numeric factorization of \a matrix, which must have
+  /// the sparsity pattern given to analyzePattern().
+  void factorize(const MatrixType &matrix) {
+    eigen_assert(m_analysisIsOk && "You must first call analyzePattern()");
+    eigen_assert(matrix.rows() == rows() && matrix.cols() == cols());
+    CholMatrixType upper;
+    permutedUpper(matrix, m_P, upper);
+    const CholMatrixType lower = upper.transpose();
+
+    const Eigen::Index nsuper = supernodes();
+    std::vector<DenseMatrix> updates(nsuper);
+    std::atomic<bool> failed(false);
+    const auto process = [&](StorageIndex s) {
+      if (!failed.load(std::memory_order_relaxed) &&
+          !factorizeSupernode(lower, s, updates))
+        failed.store(true, std::memory_order_relaxed);
+    };
+
+#ifdef _OPENMP
+    std::unique_ptr<std::atomic<StorageIndex>[]> pending(
+        new std::atomic<StorageIndex>[nsuper]);
+    for (Eigen::Index s = 0; s < nsuper; ++s)
+      pending[s].store(m_children[s + 1] - m_children[s]);
+#pragma omp parallel
+#pragma omp single
+    for (Eigen::Index leaf = 0; leaf < nsuper; ++leaf) {
+      if (m_children[leaf + 1] != m_children[leaf]) continue;
+#pragma omp task firstprivate(leaf) shared(pending, process)
+      {
+        // Walk up the tree while this task completes the last child.
+        StorageIndex s = StorageIndex(leaf);
+        for (;;) {
+          process(s);
+          s = m_superParent[s];
+          if (s < 0 || pending[s].fetch_sub(1, std::memory_order_acq_rel) != 1)
+            break;
+        }
+      }
+    }
+#else
+    // Supernodes are numbered in postorder.
+    for (Eigen::Index s = 0; s < nsuper; ++s) process(StorageIndex(s));
+#endif
+
+    m_info = failed.load() ? Eigen::NumericalIssue : Eigen::Success;
+    m_factorizationIsOk = true;
+  }
+
+  Eigen::Index rows() const { return m_P.size(); }
+  Eigen::Index cols() const { return m_P.size(); }
+
+  /// \returns Success if the factorization succeeded, NumericalIssue if the
+  /// matrix is not positive definite.
+  Eigen::ComputationInfo info() const {
+    eigen_assert(m_isInitialized && "Decomposition is not initialized.");
+    return m_info;
+  }
+
+  /// \returns the fill-reducing permutation P, including the postordering.
+  const PermutationType &permutationP() const { return m_P; }
+  /// \returns the inverse permutation P^-1.
+  const PermutationType &permutationPinv() const { return m_Pinv; }
+
+  /// \returns the number of supernodes.
+  Eigen::Index supernodes() const {
+    return m_superStart.empty() ? 0 : Eigen::Index(m_superStart.size()) - 1;
+  }
+
+  /// \returns the number of nonzeros of L, counting the dense triangles of the
+  /// supernodes only once.
+  Eigen::Index nonZerosL() const {
+    Eigen::Index nnz = 0;
+    for (Eigen::Index s = 0; s < supernodes(); ++s) {
+      const Eigen::Index ncols = m_superStart[s + 1] - m_superStart[s];
+      const Eigen::Index nrows = m_rowPtr[s + 1] - m_rowPtr[s];
+      nnz += ncols * nrows - ncols * (ncols - 1) / 2;
+    }
+    return nnz;
+  }
+
+  /// \returns the lower triangular factor L as a sparse matrix.
+  CholMatrixType matrixL() const {
+    eigen_assert(m_factorizationIsOk && "The decomposition is not computed");
+    CholMatrixType l(rows(), cols());
+    l.reserve(nonZerosL());
+    for (Eigen::Index s = 0; s < supernodes(); ++s) {
+      const Eigen::Index ncols = m_superStart[s + 1] - m_superStart[s];
+      const Eigen::Index nrows = m_rowPtr[s + 1] - m_rowPtr[s];
+      const auto block = supernodeBlock(s);
+      for (Eigen::Index j = 0; j < ncols; ++j) {
+        l.startVec(m_superStart[s] + j);
+        for (Eigen::Index k = j; k < nrows; ++k)
+          l.insertBack(m_rowIdx[m_rowPtr[s] + k], m_superStart[s] + j) =
+              block(k, j);
+      }
+    }
+    l.finalize();
+    return l;
+  }
+
+  /// \returns the determinant of the underlying matrix.
+  Scalar determinant() const {
+    eigen_assert(m_factorizationIsOk && "The decomposition is not computed");
+    Scalar det(1);
+    for (Eigen::Index s = 0; s < supernodes(); ++s)
+      det *= supernodeBlock(s).diagonal().prod();
+    return Eigen::numext::abs2(det);
+  }
+
+  template <typename Rhs, typename Dest>
+  void _solve_impl(const Eigen::MatrixBase<Rhs> &b,
+                   Eigen::MatrixBase<Dest> &dest) const {
+    eigen_assert(m_factorizationIsOk &&
+                 "The decomposition is not in a valid state for solving, you "
+                 "must first call either compute() or symbolic()/numeric()");
+    eigen_assert(rows() == b.rows());
+    if (m_info != Eigen::Success) return;
+
+    dest = m_P * b;
+    DenseMatrix gathered;
+    for (Eigen::Index s = 0; s < supernodes(); ++s) {
+      const Eigen::Index ncols = m_superStart[s + 1] - m_superStart[s];
+      const Eigen::Index nrows = m_rowPtr[s + 1] - m_rowPtr[s];
+      const auto block = supernodeBlock(s);
+      auto xs = dest.middleRows(m_superStart[s], ncols);
+      block.topRows(ncols).template triangularView<Eigen::Lower>().solveInPlace(
+          xs);
+      if (nrows == ncols) continue;
+      gathered.noalias() = block.bottomRows(nrows - ncols) * xs;
+      for (Eigen::Index k = 0; k < nrows - ncols; ++k)
+        dest.row(m_rowIdx[m_rowPtr[s] + ncols + k]) -= gathered.row(k);
+    }
+    for (Eigen::Index s = supernodes() - 1; s >= 0; --s) {
+      const Eigen::Index ncols = m_superStart[s + 1] - m_superStart[s];
+      const Eigen::Index nrows = m_rowPtr[s + 1] - m_rowPtr[s];
+      const auto block = supernodeBlock(s);
+      auto xs = dest.middleRows(m_superStart[s], ncols);
+      if (nrows > ncols) {
+        gathered.resize(nrows - ncols, dest.cols());
+        for (Eigen::Index k = 0; k < nrows - ncols; ++k)
+          gathered.row(k) = dest.row(m_rowIdx[m_rowPtr[s] + ncols + k]);
+        xs.noalias() -= block.bottomRows(nrows - ncols).adjoint() * gathered;
+      }
+      block.topRows(ncols)
+          .template triangularView<Eigen::Lower>()
+          .adjoint()
+          .solveInPlace(xs);
+    }
+    dest = m_Pinv * dest;
+  }
+
+ protected:
+  using ConstBlock = Eigen::Map<const DenseMatrix>;
+
+  /// \returns the dense nrows-by-ncols block of L of the supernode \a s.
+  ConstBlock supernodeBlock(Eigen::Index s) const {
+    return ConstBlock(m_values.data() + m_valuePtr[s],
+                      m_rowPtr[s + 1] - m_rowPtr[s],
+                      m_superStart[s + 1] - m_superStart[s]);
+  }
+
+  /// \brief Stores the upper triangular part of P A P^-1 in \a upper.
+  static void permutedUpper(const MatrixType &matrix, const PermutationType &p,
+                            CholMatrixType &upper) {
+    upper.resize(matrix.rows(), matrix.cols());
+    upper.template selfadjointView<Eigen::Upper>() =
+        matrix.template selfadjointView<UpLo>().twistedBy(p);
+  }
+
+  /// \brief Assembles and factorizes the frontal matrix of the supernode \a s,
+  /// and leaves its update matrix in \a updates for the parent.
+  bool factorizeSupernode(const CholMatrixType &lower, StorageIndex s,
+                          std::vector<DenseMatrix> &updates) {
+    const StorageIndex first = m_superStart[s];
+    const Eigen::Index ncols = m_superStart[s + 1] - first;
+    const Eigen::Index nrows = m_rowPtr[s + 1] - m_rowPtr[s];
+    const StorageIndex *rows = m_rowIdx.data() + m_rowPtr[s];
+    const StorageIndex *rowsEnd = rows + nrows;
+
+    DenseMatrix front = DenseMatrix::Zero(nrows, nrows);
+    for (Eigen::Index j = 0; j < ncols; ++j) {
+      for (typename CholMatrixType::InnerIterator it(lower, first + j); it;
+           ++it)
+        front(std::lower_bound(rows, rowsEnd, it.index()) - rows, j) +=
+            it.value();
+    }
+
+    // Extend-add of the update matrices of the children. Both row lists are
+    // sorted, so the relative indices are found by a merge.
+    std::vector<Eigen::Index> relative;
+    for (StorageIndex k = m_children[s]; k < m_children[s + 1]; ++k) {
+      const StorageIndex c = m_childIdx[k];
+      DenseMatrix &update = updates[c];
+      const Eigen::Index ncrows = update.rows();
+      const StorageIndex *crows = m_rowIdx.data() + m_rowPtr[c + 1] - ncrows;
+      relative.resize(ncrows);
+      for (Eigen::Index i = 0, r = 0; i < ncrows; ++i) {
+        while (rows[r] != crows[i]) ++r;
+        relative[i] = r;
+      }
+      for (Eigen::Index j = 0; j < ncrows; ++j)
+        for (Eigen::Index i = j; i < ncrows; ++i)
+          front(relative[i], relative[j]) += update(i, j);
+      update.resize(0, 0);
+    }
+
+    auto f11 = front.topLeftCorner(ncols, ncols);
+    Eigen::LLT<Eigen::Ref<DenseMatrix>> llt(f11);
+    if (llt.info() != Eigen::Success) return false;
+    const Eigen::Index nupdate = nrows - ncols;
+    if (nupdate > 0) {
+      auto f21 = front.bottomLeftCorner(nupdate, ncols);
+      f11.template triangularView<Eigen::Lower>()
+          .adjoint()
+          .template solveInPlace<Eigen::OnTheRight>(f21);
+      DenseMatrix &update = updates[s];
+      update = front.bottomRightCorner(nupdate, nupdate);
+      update.template selfadjointView<Eigen::Lower>().rankUpdate(f21,
+                                                                 Scalar(-1));
+    }
+    Eigen::Map<DenseMatrix>(m_values.data() + m_valuePtr[s], nrows, ncols) =
+        front.leftCols(ncols);
+    return true;
+  }
+
+  PermutationType m_P;
+  PermutationType m_Pinv;
+  // Supernode s spans the columns [m_superStart[s], m_superStart[s + 1]) and
+  // the rows m_rowIdx[m_rowPtr[s]..m_rowPtr[s + 1]); its dense column-major
+  // block of L starts at m_values[m_valuePtr[s]].
+  std::vector<StorageIndex> m_superStart;
+  std::vector<StorageIndex> m_superParent;
+  std::vector<StorageIndex> m_children;
+  std::vector<StorageIndex> m_childIdx;
+  std::vector<StorageIndex> m_rowPtr;
+  std::vector<StorageIndex> m_rowIdx;
+  std::vector<Eigen::Index> m_valuePtr;
+  std::vector<Scalar> m_values;
+  Eigen::ComputationInfo m_info;
+  bool m_analysisIsOk;
+  bool m_factorizationIsOk;
+};
+
+template <
+    typename _MatrixType, int _UpLo = Eigen::Lower,
+    typename _Ordering = RuntimeOrdering<typename _MatrixType::StorageIndex,
+                                         OrderingMethod::AMD>>
+void exposeSupernodalLLT(nb::module_ m, const char *name) {
+  using MatrixType = _MatrixType;
+  using Solver = SupernodalLLT<MatrixType, _UpLo, _Ordering>;
+
+  if (check_registration_alias<Solver>(m)) {
+    return;
+  }
+  exposeOrderingMethod(m);
+  nb::class_<Solver>(
+      m, name,
+      "A direct sparse supernodal LLT Cholesky factorization.\n\n"
+      "This class provides a multifrontal supernodal LL^T Cholesky "
+      "factorization of sparse matrices that are selfadjoint and positive "
+      "definite, without depending on CHOLMOD. The columns of L sharing the "
+      "same structure are grouped into supernodes, which are factorized with "
+      "dense blocked kernels. When the module is compiled with OpenMP, the "
+      "independent subtrees of the elimination tree are factorized in "
+      "parallel.\n\n"
+      "In order to reduce the fill-in, a symmetric permutation P is applied "
+      "prior to the factorization such that the factorized matrix is P A "
+      "P^-1.")
+
+      .def(nb::init<>(), "Default constructor.")
+      .def(
+          "__init__",
+          [](Solver *self, const MatrixType &matrix, OrderingMethod ordering) {
+            new (self) Solver();
+            OrderingScope scope(ordering);
+            self->compute(matrix);
+          },
+          "matrix"_a, "ordering"_a = _Ordering::DefaultMethod,
+          "Constructs a LLT factorization from a given matrix, with the "
+          "given fill-reducing ordering.")
+
+      .def(SparseSolverBaseVisitor())
+
+      .def(
+          "matrixL",
+          [](const Solver &self) -> MatrixType { return self.matrixL(); },
+          "Returns the lower triangular matrix L.")
+      .def(
+          "matrixU",
+          [](const Solver &self) -> MatrixType {
+            return self.matrixL().adjoint();
+          },
+          "Returns the upper triangular matrix U.")
+      .def("determinant", &Solver::determinant,
+           "Returns the determinant of the underlying matrix from the "
+           "current factorization.")
+      .def("permutationP", &Solver::permutationP,
+           "Returns the permutation P.", nb::rv_policy::copy)
+      .def("permutationPinv", &Solver::permutationPinv,
+           "Returns the inverse P^-1 of the permutation P.",
+           nb::rv_policy::copy)
+      .def("supernodes", &Solver::supernodes,
+           "Returns the number of supernodes of the factor.")
+      .def("nonZerosL", &Solver::nonZerosL,
+           "Returns the number of nonzeros of the factor L.")
+
+      .def("rows", &Solver::rows)
+      .def("cols", &Solver::cols)
+      .def("info", &Solver::info,
+           "NumericalIssue if the matrix is not positive definite. Returns "
+           "Success otherwise.")
+
+      .def(IdVisitor());
+}
+
+}  // namespace nanoeigenpy
@@ -0,0 +1,182 @@
+/// Copyright 2025 INRIA
+
+#pragma once
+
+#include "nanoeigenpy/fwd.hpp"
+#include "nanoeigenpy/decompositions/sparse/orderings.hpp"
+#include "nanoeigenpy/utils/sparse-matrix-handle.hpp"
+#include <nanobind/eigen/sparse.h>
+#include <Eigen/SparseCore>
+
+#include <algorithm>
+#include <vector>
+
+namespace nanoeigenpy {
+namespace nb = nanobind;
+using namespace nb::literals;
+
+namespace detail {
+
+/// \brief Computes the elimination tree from the upper triangular part of a
+/// symmetric matrix (Liu's algorithm with path compression).
+template <typename UpperMatrix, typename StorageIndex>
+void eliminationTree(const UpperMatrix &upper,
+                     std::vector<StorageIndex> &parent) {
+  const Eigen::Index size = upper.cols();
+  parent.assign(size, -1);
+  std::vector<StorageIndex> ancestor(size, -1);
+  for (Eigen::Index k = 0; k < size; ++k) {
+    for (typename UpperMatrix::InnerIterator it(upper, k); it; ++it) {
+      StorageIndex i = StorageIndex(it.index());
+      while (i >= 0 && i < k) {
+        const StorageIndex next = ancestor[i];
+        ancestor[i] = StorageIndex(k);
+        if (next < 0) parent[i] = StorageIndex(k);
+        i = next;
+      }
+    }
+  }
+}
+
+/// \returns the nodes of the forest \a parent in postorder.
+template <typename StorageIndex>
+std::vector<StorageIndex> postorder(const std::vector<StorageIndex> &parent) {
+  const Eigen::Index size = Eigen::Index(parent.size());
+  std::vector<StorageIndex> head(size, -1), next(size, -1), stack;
+  for (Eigen::Index j = size - 1; j >= 0; --j) {
+    if (parent[j] < 0) continue;
+    next[j] = head[parent[j]];
+    head[parent[j]] = StorageIndex(j);
+  }
+  std::vector<StorageIndex> post;
+  post.reserve(size);
+  for (Eigen::Index root = 0; root < size; ++root) {
+    if (parent[root] >= 0) continue;
+    stack.push_back(StorageIndex(root));
+    while (!stack.empty()) {
+      const StorageIndex p = stack.back();
+      const StorageIndex child = head[p];
+      if (child < 0) {
+        stack.pop_back();
+        post.push_back(p);
+      } else {
+        head[p] = next[child];
+        stack.push_back(child);
+      }
+    }
+  }
+  return post;
+}
+
+/// \returns the number of nonzeros of each column of the Cholesky factor,
+/// diagonal included, by traversing the row subtrees of the elimination tree.
+template <typename UpperMatrix, typename StorageIndex>
+std::vector<StorageIndex> columnCounts(
+    const UpperMatrix &upper, const std::vector<StorageIndex> &parent) {
+  const Eigen::Index size = upper.cols();
+  std::vector<StorageIndex> count(size, 1);
+  std::vector<StorageIndex> flag(size, -1);
+  for (Eigen::Index k = 0; k < size; ++k) {
+    flag[k] = StorageIndex(k);
+    for (typename UpperMatrix::InnerIterator it(upper, k); it; ++it) {
+      for (StorageIndex i = StorageIndex(it.index()); i < k && flag[i] != k;
+           i = parent[i]) {
+        ++count[i];
+        flag[i] = StorageIndex(k);
+      }
+    }
+  }
+  return count;
+}
+
+}  // namespace detail
+
+/// \brief Predicted size and cost of a sparse Cholesky factorization.
+struct CholeskyFillStatistics {
+  /// Number of nonzeros of the factor L, diagonal included.
+  Eigen::Index nonZerosL = 0;
+  /// Floating point operations of the numeric factorization, estimated as
+  /// the sum of the squared column counts of L.
+  double flops = 0;
+  /// Height of the elimination tree, which bounds the parallelism.
+  Eigen::Index treeHeight = 0;
+};
+
+/// \brief Runs the symbolic analysis of the Cholesky factorization of the
+/// selfadjoint \a matrix (only its lower triangular part is referenced) with
+/// the fill-reducing ordering \a method, without factorizing it.
+template <typename MatrixType>
+CholeskyFillStatistics choleskyFillStatistics(const MatrixType &matrix,
+                                              OrderingMethod method) {
+  using Scalar = typename MatrixType::Scalar;
+  using StorageIndex = typename MatrixType::StorageIndex;
+  using CholMatrixType =
+      Eigen::SparseMatrix<Scalar, Eigen::ColMajor, StorageIndex>;
+  using PermutationType =
+      Eigen::PermutationMatrix<Eigen::Dynamic, Eigen::Dynamic, StorageIndex>;
+  eigen_assert(matrix.rows() == matrix.cols());
+
+  CholMatrixType full;
+  full = matrix.template selfadjointView<Eigen::Lower>();
+  full.makeCompressed();
+  PermutationType pinv;
+  computeOrdering(method, full, pinv);
+  const PermutationType p = pinv.inverse();
+  CholMatrixType upper(matrix.rows(), matrix.cols());
+  upper.template selfadjointView<Eigen::Upper>() =
+      full.template selfadjointView<Eigen::Lower>().twistedBy(p);
+
+  std::vector<StorageIndex> parent;
+  detail::eliminationTree(upper, parent);
+  const std::vector<StorageIndex> count = detail::columnCounts(upper, parent);
+
+  CholeskyFillStatistics stats;
+  std::vector<Eigen::Index> height(count.size(), 1);
+  for (std::size_t j = 0; j < count.size(); ++j) {
+    stats.nonZerosL += count[j];
+    stats.flops += double(count[j]) * double(count[j]);
+    // The parent of a node always has a larger index.
+    if (parent[j] >= 0)
+      height[parent[j]] = (std::max)(height[parent[j]], height[j] + 1);
+    stats.treeHeight = (std::max)(stats.treeHeight, height[j]);
+  }
+  return stats;
+}
+
+template <typename MatrixType>
+void exposeCholeskyFillStatistics(nb::module_ m) {
+  exposeOrderingMethod(m);
+  if (!check_registration_alias<CholeskyFillStatistics>(m)) {
+    nb::class_<CholeskyFillStatistics>(
+        m, "CholeskyFillStatistics",
+        "Predicted size and cost of a sparse Cholesky factorization.")
+        .def_ro("nonZerosL", &CholeskyFillStatistics::nonZerosL,
+                "Number of nonzeros of the factor L, diagonal included.")
+        .def_ro("flops", &CholeskyFillStatistics::flops,
+                "Floating point operations of the numeric factorization, "
+                "estimated as the sum of the squared column counts of L.")
+        .def_ro("treeHeight", &CholeskyFillStatistics::treeHeight,
+                "Height of the elimination tree.");
+  }
+
+  m.def(
+      "choleskyFillStatistics",
+      [](const MatrixType &matrix, OrderingMethod method) {
+        return choleskyFillStatistics(matrix, method);
+      },
+      "matrix"_a, "ordering"_a = OrderingMethod::AMD,
+      "Predicts the number of nonzeros of L and the flops of the sparse "
+      "Cholesky factorization of a selfadjoint matrix with the given "
+      "fill-reducing ordering, without factorizing it. Only the lower "
+      "triangular part of the matrix is referenced.");
+  m.def(
+      "choleskyFillStatistics",
+      [](const SparseMatrixHandle<MatrixType> &matrix, OrderingMethod method) {
+        return choleskyFillStatistics(matrix.matrix(), method);
+      },
+      "matrix"_a, "ordering"_a = OrderingMethod::AMD,
+      "Predicts the number of nonzeros of L and the flops of the sparse "
+      "Cholesky factorization of a SparseMatrix, without copying it.");
+}
+
+}  // namespace nanoeigenpy
@@ -3,6 +3,8 @@
 #pragma once
 
 #include "nanoeigenpy/fwd.hpp"
+#include "nanoeigenpy/utils/views.hpp"
+#include "nanoeigenpy/utils/object-lock.hpp"
 #include <Eigen/SVD>
 
 namespace nanoeigenpy {
@@ -20,21 +22,21 @@ struct SVDBaseVisitor : nb::def_visitor<SVDBaseVisitor> {
 
     cl.def(nb::init<>(), "Default constructor.")
 
-        .def(
-            "matrixU",
-            [](const Derived &c) -> MatrixType { return c.matrixU(); },
-            "Returns the U matrix")
-        .def(
-            "matrixV",
-            [](const Derived &c) -> MatrixType { return c.matrixV(); },
-            "Returns the U matrix")
+        .def("matrixU", copyOrViewOf<Derived>(&SVDBase::matrixU),
+             "copy"_a = false,
+             "Returns a read-only view of the U matrix. With copy=True, "
+             "returns instead a copy.")
+        .def("matrixV", copyOrViewOf<Derived>(&SVDBase::matrixV),
+             "copy"_a = false,
+             "Returns a read-only view of the V matrix. With copy=True, "
+             "returns instead a copy.")
 
-        .def("singularValues", &SVDBase::singularValues,
+        .def("singularValues",
+             readOnlyViewOf<Derived>(&SVDBase::singularValues),
              "For the SVD decomposition of a n-by-p matrix, letting "
              "\a m be the minimum of \a n and \a p, the returned vector "
              "has size \a m.  Singular values are always sorted in decreasing "
-             "order.",
-             nb::rv_policy::reference_internal)
+             "order. Returns a read-only view.")
         .def("nonzeroSingularValues", &SVDBase::nonzeroSingularValues,
              "Returns the number of singular values that are not exactly 0.")
         .def("rank", &SVDBase::rank,
@@ -42,9 +44,9 @@ struct SVDBaseVisitor : nb::def_visitor<SVDBaseVisitor> {
 
         .def(
             "setThreshold",
-            [](Derived &c, const RealScalar &threshold) {
+            lockExclusive<Derived>([](Derived &c, const RealScalar &threshold) {
               return c.setThreshold(threshold);
-            },
+            }),
             "threshold"_a,
             "Allows to prescribe a threshold to be used by certain methods, "
             "such as rank(), who need to determine when pivots are to be "
@@ -55,7 +57,8 @@ struct SVDBaseVisitor : nb::def_visitor<SVDBaseVisitor> {
             nb::rv_policy::reference)
         .def(
             "setThreshold",
-            [](Derived &c) { return c.setThreshold(Eigen::Default); },
+            lockExclusive<Derived>(
+                [](Derived &c) { return c.setThreshold(Eigen::Default); }),
             "Allows to come back to the default behavior, letting Eigen use "
             "its default formula for determining the threshold.",
             nb::rv_policy::reference)
@@ -9,4 +9,5 @@
 #include "nanoeigenpy/geometry/scaling.hpp"
 #include "nanoeigenpy/geometry/translation.hpp"
 #include "nanoeigenpy/geometry/quaternion.hpp"
+#include "nanoeigenpy/geometry/rotation-conversions.hpp"
 #include "nanoeigenpy/geometry/jacobi-rotation.hpp"
@@ -0,0 +1,300 @@
+/// Copyright 2025 INRIA
+
+#pragma once
+
+#include <nanobind/nanobind.h>
+#include <nanobind/ndarray.h>
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+
+#include <cmath>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+
+namespace nanoeigenpy {
+namespace nb = nanobind;
+
+/// \returns the unit quaternion of the rotation matrix \p R, with w >= 0.
+///
+/// Shepperd's method: the quaternion is recovered from the largest of
+/// 4w^2 = 1 + trace(R), 4x^2 = 1 + 2 R(0,0) - trace(R), ... so that the
+/// square root is taken of a number at least 1 and the other components are
+/// divided by a component at least 1/2, whatever the rotation.
+template <typename Derived>
+Eigen::Quaternion<typename Derived::Scalar> quaternionFromRotationMatrix(
+    const Eigen::MatrixBase<Derived> &R) {
+  using Scalar = typename Derived::Scalar;
+  using std::sqrt;
+  const Scalar trace = R(0, 0) + R(1, 1) + R(2, 2);
+  Eigen::Quaternion<Scalar> q;
+  if (trace >= R(0, 0) && trace >= R(1, 1) && trace >= R(2, 2)) {
+    const Scalar s = sqrt(Scalar(1) + trace) * Scalar(2);  // s = 4w
+    q.w() = Scalar(0.25) * s;
+    q.x() = (R(2, 1) - R(1, 2)) / s;
+    q.y() = (R(0, 2) - R(2, 0)) / s;
+    q.z() = (R(1, 0) - R(0, 1)) / s;
+  } else if (R(0, 0) >= R(1, 1) && R(0, 0) >= R(2, 2)) {
+    const Scalar s =
+        sqrt(Scalar(1) + R(0, 0) - R(1, 1) - R(2, 2)) * Scalar(2);  // s = 4x
+    q.w() = (R(2, 1) - R(1, 2)) / s;
+    q.x() = Scalar(0.25) * s;
+    q.y() = (R(0, 1) + R(1, 0)) / s;
+    q.z() = (R(0, 2) + R(2, 0)) / s;
+  } else if (R(1, 1) >= R(2, 2)) {
+    const Scalar s =
+        sqrt(Scalar(1) - R(0, 0) + R(1, 1) - R(2, 2)) * Scalar(2);  // s = 4y
+    q.w() = (R(0, 2) - R(2, 0)) / s;
+    q.x() = (R(0, 1) + R(1, 0)) / s;
+    q.y() = Scalar(0.25) * s;
+    q.z() = (R(1, 2) + R(2, 1)) / s;
+  } else {
+    const Scalar s =
+        sqrt(Scalar(1) - R(0, 0) - R(1, 1) + R(2, 2)) * Scalar(2);  // s = 4z
+    q.w() = (R(1, 0) - R(0, 1)) / s;
+    q.x() = (R(0, 2) + R(2, 0)) / s;
+    q.y() = (R(1, 2) + R(2, 1)) / s;
+    q.z() = Scalar(0.25) * s;
+  }
+  if (q.w() < Scalar(0)) q.coeffs() = -q.coeffs();
+  q.normalize();
+  return q;
+}
+
+/// \returns the rotation vector (angle times unit axis) of the quaternion
+/// \p q, whose angle is in [0, pi].
+template <typename Scalar>
+Eigen::Matrix<Scalar, 3, 1> angleAxisFromQuaternion(
+    const Eigen::Quaternion<Scalar> &q) {
+  const Eigen::AngleAxis<Scalar> aa(q.normalized());
+  return aa.angle() * aa.axis();
+}
+
+/// \returns the quaternion of the rotation vector \p v.
+template <typename Derived>
+Eigen::Quaternion<typename Derived::Scalar> quaternionFromAngleAxis(
+    const Eigen::MatrixBase<Derived> &v) {
+  using Scalar = typename Derived::Scalar;
+  const Scalar angle = v.norm();
+  if (angle == Scalar(0)) return Eigen::Quaternion<Scalar>::Identity();
+  return Eigen::Quaternion<Scalar>(
+      Eigen::AngleAxis<Scalar>(angle, v / angle));
+}
+
+/// \returns the rotation R = R_a0(e[0]) R_a1(e[1]) R_a2(e[2]) of the Euler
+/// angles \p e around the axes a0, a1, a2, as in Eigen::MatrixBase::
+/// eulerAngles.
+template <typename Derived>
+Eigen::Matrix<typename Derived::Scalar, 3, 3> rotationMatrixFromEulerAngles(
+    const Eigen::MatrixBase<Derived> &e, Eigen::Index a0, Eigen::Index a1,
+    Eigen::Index a2) {
+  using Scalar = typename Derived::Scalar;
+  using AngleAxis = Eigen::AngleAxis<Scalar>;
+  using Vector3 = Eigen::Matrix<Scalar, 3, 1>;
+  return (AngleAxis(e[0], Vector3::Unit(a0)) *
+          AngleAxis(e[1], Vector3::Unit(a1)) *
+          AngleAxis(e[2], Vector3::Unit(a2)))
+      .toRotationMatrix();
+}
+
+namespace detail {
+
+/// Number of rotations from which the batched conversions are split across
+/// the threads.
+constexpr Eigen::Index kParallelRotations = 4096;
+
+/// \brief Calls f(k) for k in [0, n). When the module is compiled with
+/// OpenMP, large batches are split across the threads set by setNbThreads().
+template <typename F>
+void forEachRotation(Eigen::Index n, const F &f) {
+#ifdef _OPENMP
+  const int threads = n >= kParallelRotations ? Eigen::nbThreads() : 1;
+#pragma omp parallel for num_threads(threads) schedule(static)
+  for (Eigen::Index k = 0; k < n; ++k) f(k);
+#else
+  for (Eigen::Index k = 0; k < n; ++k) f(k);
+#endif
+}
+
+inline void checkEulerAxes(Eigen::Index a0, Eigen::Index a1, Eigen::Index a2) {
+  const auto valid = [](Eigen::Index a) { return a >= 0 && a <= 2; };
+  if (!valid(a0) || !valid(a1) || !valid(a2) || a0 == a1 || a1 == a2)
+    throw std::invalid_argument(
+        "The Euler axes must be in {0, 1, 2}, with a0 != a1 and a1 != a2.");
+}
+
+/// \brief Applies \p convert to the \p n rotations of \p in, made of
+/// \p inSize coefficients each, and returns the n rotations of \p outSize
+/// coefficients written by convert(in, out) in an array of the given shape.
+///
+/// The GIL is released during the conversions.
+template <typename Scalar, std::size_t Ndim, typename Convert>
+nb::ndarray<nb::numpy, Scalar> convertRotations(
+    const Scalar *in, std::size_t n, std::size_t inSize, std::size_t outSize,
+    const std::size_t (&shape)[Ndim], const Convert &convert) {
+  std::unique_ptr<Scalar[]> out(new Scalar[n * outSize]);
+  {
+    nb::gil_scoped_release release;
+    Scalar *data = out.get();
+    forEachRotation(Eigen::Index(n), [&](Eigen::Index k) {
+      convert(in + k * inSize, data + k * outSize);
+    });
+  }
+  nb::capsule owner(out.get(), [](void *p) noexcept {
+    delete[] static_cast<Scalar *>(p);
+  });
+  return nb::ndarray<nb::numpy, Scalar>(out.release(), Ndim, shape, owner);
+}
+
+}  // namespace detail
+
+/// \brief Exposes the conversions between the representations of batches of
+/// 3D rotations, stored in C-contiguous arrays: (N, 3, 3) rotation matrices,
+/// (N, 4) quaternions with the coefficients (x, y, z, w) of
+/// Quaternion.coeffs(), and (N, 3) rotation vectors or Euler angles.
+template <typename Scalar>
+void exposeRotationConversions(nb::module_ m) {
+  using namespace nb::literals;
+  using Matrices = nb::ndarray<const Scalar, nb::shape<-1, 3, 3>,
+                               nb::c_contig, nb::device::cpu>;
+  using Quaternions = nb::ndarray<const Scalar, nb::shape<-1, 4>, nb::c_contig,
+                                  nb::device::cpu>;
+  using Vectors = nb::ndarray<const Scalar, nb::shape<-1, 3>, nb::c_contig,
+                              nb::device::cpu>;
+  using Matrix3 = Eigen::Matrix<Scalar, 3, 3, Eigen::RowMajor>;
+  using Vector3 = Eigen::Matrix<Scalar, 3, 1>;
+  using Quaternion = Eigen::Quaternion<Scalar>;
+  using Result = nb::ndarray<nb::numpy, Scalar>;
+
+  m.def(
+      "matricesToQuaternions",
+      [](const Matrices &R) -> Result {
+        const std::size_t n = R.shape(0);
+        const std::size_t shape[2] = {n, 4};
+        return detail::convertRotations(
+            R.data(), n, 9, 4, shape, [](const Scalar *in, Scalar *out) {
+              Eigen::Map<Quaternion> result(out);
+              result =
+                  quaternionFromRotationMatrix(Eigen::Map<const Matrix3>(in));
+            });
+      },
+      "R"_a,
+      "Converts the (N, 3, 3) rotation matrices R to (N, 4) unit quaternions "
+      "(x, y, z, w) with w >= 0, with Shepperd's method.");
+  m.def(
+      "quaternionsToMatrices",
+      [](const Quaternions &q) -> Result {
+        const std::size_t n = q.shape(0);
+        const std::size_t shape[3] = {n, 3, 3};
+        return detail::convertRotations(
+            q.data(), n, 4, 9, shape, [](const Scalar *in, Scalar *out) {
+              Eigen::Map<Matrix3> result(out);
+              result = Eigen::Map<const Quaternion>(in)
+                           .normalized()
+                           .toRotationMatrix();
+            });
+      },
+      "q"_a,
+      "Converts the (N, 4) quaternions q (x, y, z, w), which are normalized, "
+      "to (N, 3, 3) rotation matrices.");
+
+  m.def(
+      "matricesToAngleAxis",
+      [](const Matrices &R) -> Result {
+        const std::size_t n = R.shape(0);
+        const std::size_t shape[2] = {n, 3};
+        return detail::convertRotations(
+            R.data(), n, 9, 3, shape, [](const Scalar *in, Scalar *out) {
+              Eigen::Map<Vector3> result(out);
+              result = angleAxisFromQuaternion(
+                  quaternionFromRotationMatrix(Eigen::Map<const Matrix3>(in)));
+            });
+      },
+      "R"_a,
+      "Converts the (N, 3, 3) rotation matrices R to (N, 3) rotation vectors, "
+      "the unit axes scaled by the angles in [0, pi].");
+  m.def(
+      "angleAxisToMatrices",
+      [](const Vectors &v) -> Result {
+        const std::size_t n = v.shape(0);
+        const std::size_t shape[3] = {n, 3, 3};
+        return detail::convertRotations(
+            v.data(), n, 3, 9, shape, [](const Scalar *in, Scalar *out) {
+              Eigen::Map<Matrix3> result(out);
+              result = quaternionFromAngleAxis(Eigen::Map<const Vector3>(in))
+                           .toRotationMatrix();
+            });
+      },
+      "v"_a,
+      "Converts the (N, 3) rotation vectors v, the rotation axes scaled by "
+      "the angles, to (N, 3, 3) rotation matrices.");
+
+  m.def(
+      "quaternionsToAngleAxis",
+      [](const Quaternions &q) -> Result {
+        const std::size_t n = q.shape(0);
+        const std::size_t shape[2] = {n, 3};
+        return detail::convertRotations(
+            q.data(), n, 4, 3, shape, [](const Scalar *in, Scalar *out) {
+              Eigen::Map<Vector3> result(out);
+              result = angleAxisFromQuaternion<Scalar>(
+                  Eigen::Map<const Quaternion>(in));
+            });
+      },
+      "q"_a,
+      "Converts the (N, 4) quaternions q (x, y, z, w) to (N, 3) rotation "
+      "vectors, the unit axes scaled by the angles in [0, pi].");
+  m.def(
+      "angleAxisToQuaternions",
+      [](const Vectors &v) -> Result {
+        const std::size_t n = v.shape(0);
+        const std::size_t shape[2] = {n, 4};
+        return detail::convertRotations(
+            v.data(), n, 3, 4, shape, [](const Scalar *in, Scalar *out) {
+              Eigen::Map<Quaternion> result(out);
+              result = quaternionFromAngleAxis(Eigen::Map<const Vector3>(in));
+            });
+      },
+      "v"_a,
+      "Converts the (N, 3) rotation vectors v to (N, 4) unit quaternions "
+      "(x, y, z, w).");
+
+  m.def(
+      "matricesToEulerAngles",
+      [](const Matrices &R, Eigen::Index a0, Eigen::Index a1,
+         Eigen::Index a2) -> Result {
+        detail::checkEulerAxes(a0, a1, a2);
+        const std::size_t n = R.shape(0);
+        const std::size_t shape[2] = {n, 3};
+        return detail::convertRotations(
+            R.data(), n, 9, 3, shape, [=](const Scalar *in, Scalar *out) {
+              Eigen::Map<Vector3> result(out);
+              result = Eigen::Map<const Matrix3>(in).eulerAngles(a0, a1, a2);
+            });
+      },
+      "R"_a, "a0"_a = 2, "a1"_a = 1, "a2"_a = 0,
+      "Converts the (N, 3, 3) rotation matrices R to (N, 3) Euler angles "
+      "(e0, e1, e2) such that R = R_a0(e0) R_a1(e1) R_a2(e2), where R_a is a "
+      "rotation around the axis a (0 for x, 1 for y, 2 for z). The default "
+      "axes are the yaw, pitch and roll. As Matrix.eulerAngles in Eigen, e0 "
+      "is in [0, pi] and e1, e2 in [-pi, pi].");
+  m.def(
+      "eulerAnglesToMatrices",
+      [](const Vectors &e, Eigen::Index a0, Eigen::Index a1,
+         Eigen::Index a2) -> Result {
+        detail::checkEulerAxes(a0, a1, a2);
+        const std::size_t n = e.shape(0);
+        const std::size_t shape[3] = {n, 3, 3};
+        return detail::convertRotations(
+            e.data(), n, 3, 9, shape, [=](const Scalar *in, Scalar *out) {
+              Eigen::Map<Matrix3> result(out);
+              result = rotationMatrixFromEulerAngles(
+                  Eigen::Map<const Vector3>(in), a0, a1, a2);
+            });
+      },
+      "e"_a, "a0"_a = 2, "a1"_a = 1, "a2"_a = 0,
+      "Converts the (N, 3) Euler angles e to the (N, 3, 3) rotation matrices "
+      "R_a0(e0) R_a1(e1) R_a2(e2).");
+}
+
+}  // namespace nanoeigenpy
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "nanoeigenpy/fwd.hpp"
+#include "nanoeigenpy/utils/object-lock.hpp"
 #include <Eigen/IterativeLinearSolvers>
 
 namespace nanoeigenpy {
@@ -21,18 +22,24 @@ struct PreconditionerBaseVisitor
         .def(nb::init<MatrixType>(), "A"_a)
         .def("info", &Preconditioner::info,
              "Returns success if the Preconditioner has been well initialized.")
-        .def("solve", &solve, "b"_a,
+        .def("solve", lockShared<Preconditioner>(&solve), "b"_a,
              "Returns the solution A * z = b where the preconditioner is an "
              "estimate of A^-1.")
 
-        .def("compute", &Preconditioner::template compute<MatrixType>, "mat"_a,
-             "Initialize the preconditioner from the matrix value.",
-             nb::rv_policy::reference)
-        .def("factorize", &Preconditioner::template factorize<MatrixType>,
-             "mat"_a,
-             "Initialize the preconditioner from the matrix value, i.e "
-             "factorize the mat given as input to approximate its inverse.",
-             nb::rv_policy::reference);
+        .def(
+            "compute",
+            lockExclusive<Preconditioner>(
+                &Preconditioner::template compute<MatrixType>),
+            "mat"_a, "Initialize the preconditioner from the matrix value.",
+            nb::rv_policy::reference)
+        .def(
+            "factorize",
+            lockExclusive<Preconditioner>(
+                &Preconditioner::template factorize<MatrixType>),
+            "mat"_a,
+            "Initialize the preconditioner from the matrix value, i.e "
+            "factorize the mat given as input to approximate its inverse.",
+            nb::rv_policy::reference);
   }
 
  private:
@@ -4,6 +4,7 @@
 
 #include "nanoeigenpy/fwd.hpp"
 #include "nanoeigenpy/solvers/basic-preconditioners.hpp"
+#include "nanoeigenpy/utils/object-lock.hpp"
 #include <Eigen/IterativeLinearSolvers>
 
 namespace nanoeigenpy {
@@ -24,10 +25,11 @@ struct BFGSPreconditionerBaseVisitor
              "Returns the number of cols in the preconditioner.")
         .def("dim", &Preconditioner::dim,
              "Returns the dimension of the BFGS preconditioner.")
-        .def("update", &Preconditioner::update, "s"_a, "y"_a,
-             "Update the BFGS estimate of the matrix A.",
+        .def("update", lockExclusive<Preconditioner>(&Preconditioner::update),
+             "s"_a, "y"_a, "Update the BFGS estimate of the matrix A.",
              nb::rv_policy::reference)
-        .def("reset", &Preconditioner::reset, "Reset the BFGS estimate.");
+        .def("reset", lockExclusive<Preconditioner>(&Preconditioner::reset),
+             "Reset the BFGS estimate.");
   }
 
   static void expose(nb::module_& m, const char* name) {
@@ -53,8 +55,8 @@ struct LimitedBFGSPreconditionerBaseVisitor
     using namespace nb::literals;
     cl.def(PreconditionerBaseVisitor<Preconditioner>())
         .def(BFGSPreconditionerBaseVisitor<Preconditioner>())
-        .def("resize", &Preconditioner::resize, "dim"_a,
-             "Resizes the preconditionner with size dim.",
+        .def("resize", lockExclusive<Preconditioner>(&Preconditioner::resize),
+             "dim"_a, "Resizes the preconditionner with size dim.",
              nb::rv_policy::reference);
   }
 
@@ -3,6 +3,8 @@
 #pragma once
 
 #include "nanoeigenpy/fwd.hpp"
+#include "nanoeigenpy/utils/sparse-matrix-handle.hpp"
+#include "nanoeigenpy/utils/object-lock.hpp"
 
 namespace nanoeigenpy {
 namespace nb = nanobind;
@@ -64,49 +66,56 @@ void exposeIncompleteLUT(nb::module_ m, const char* name) {
 
       .def(
           "analyzePattern",
-          [](Solver& self, const MatrixType& amat) {
+          lockExclusive<Solver>([](Solver& self, const MatrixType& amat) {
             self.analyzePattern(amat);
-          },
+          }),
           "matrix"_a)
       .def(
           "factorize",
-          [](Solver& self, const MatrixType& amat) { self.factorize(amat); },
+          lockExclusive<Solver>([](Solver& self, const MatrixType& amat) {
+            self.factorize(amat);
+          }),
           "matrix"_a)
       .def(
           "compute",
-          [](Solver& self, const MatrixType& amat) -> Solver& {
-            return self.compute(amat);
-          },
+          lockExclusive<Solver>(
+              [](Solver& self, const MatrixType& amat) -> Solver& {
+                return self.compute(amat);
+              }),
           "matrix"_a, nb::rv_policy::reference)
 
-      .def("setDroptol", &Solver::setDroptol)
-      .def("setFillfactor", &Solver::setFillfactor)
+      .def("setDroptol", lockExclusive<Solver>(&Solver::setDroptol))
+      .def("setFillfactor", lockExclusive<Solver>(&Solver::setFillfactor))
 
       .def(
           "solve",
-          [](const Solver& self, const Eigen::Ref<DenseVectorXs const>& b)
-              -> DenseVectorXs { return self.solve(b); },
+          lockShared<Solver>(
+              [](const Solver& self, const Eigen::Ref<DenseVectorXs const>& b)
+                  -> DenseVectorXs { return self.solve(b); }),
           "b"_a,
           "Returns the solution x of A x = b using the current decomposition "
           "of A, where b is a right hand side vector.")
       .def(
           "solve",
-          [](const Solver& self, const Eigen::Ref<DenseMatrixXs const>& B)
-              -> DenseMatrixXs { return self.solve(B); },
+          lockShared<Solver>(
+              [](const Solver& self, const Eigen::Ref<DenseMatrixXs const>& B)
+                  -> DenseMatrixXs { return self.solve(B); }),
           "B"_a,
           "Returns the solution X of A X = B using the current decomposition "
           "of A where B is a right hand side matrix.")
       .def(
           "solve",
-          [](const Solver& self, const MatrixType& B) -> MatrixType {
-            DenseMatrixXs B_dense = DenseMatrixXs(B);
-            DenseMatrixXs X_dense = self.solve(B_dense);
-            return MatrixType(X_dense.sparseView());
-          },
+          lockShared<Solver>(
+              [](const Solver& self, const MatrixType& B) -> MatrixType {
+                DenseMatrixXs B_dense = DenseMatrixXs(B);
+                DenseMatrixXs X_dense = self.solve(B_dense);
+                return MatrixType(X_dense.sparseView());
+              }),
           "B"_a,
           "Returns the solution X of A X = B using the current decomposition "
           "of A where B is a right hand side matrix.")
 
+      .def(SparseMatrixHandleVisitor<MatrixType>())
       .def(IdVisitor());
 }
 
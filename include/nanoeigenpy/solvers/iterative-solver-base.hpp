@@ -3,9 +3,28 @@
 #pragma once
 
 #include "nanoeigenpy/fwd.hpp"
+#include "nanoeigenpy/utils/async.hpp"
+#include "nanoeigenpy/utils/instrumented-method.hpp"
+
+#include <algorithm>
 
 namespace nanoeigenpy {
 
+namespace detail {
+/// \brief Access to the protected iteration counters of an Eigen iterative
+/// solver, through a derived class as for CholmodBaseAccessor.
+template <typename IterativeSolver>
+struct IterativeSolverAccessor : Eigen::IterativeSolverBase<IterativeSolver> {
+  using Base = Eigen::IterativeSolverBase<IterativeSolver>;
+  static Eigen::Index& maxIterations(Base& solver) {
+    return solver.*(&IterativeSolverAccessor::m_maxIterations);
+  }
+  static Eigen::Index& iterations(Base& solver) {
+    return solver.*(&IterativeSolverAccessor::m_iterations);
+  }
+};
+}  // namespace detail
+
 template <typename IterativeSolver>
 struct IterativeSolverVisitor
     : nb::def_visitor<IterativeSolverVisitor<IterativeSolver>> {
@@ -25,66 +44,87 @@ struct IterativeSolverVisitor
   void execute(nb::class_<IterativeSolver, Ts...>& cl) {
     using IS = IterativeSolver;
     using namespace nb::literals;
+    constexpr locks::Mode exclusive = locks::Mode::Exclusive;
+    solveAsyncStats = methodStats(cl, "solveAsync");
     cl  //
-        .def("solve", &solve<VectorType>,
-             "Returns the solution x of Ax = b using the current decomposition "
-             "of A.")
-        .def("solve", &solve<DenseMatrix>,
-             "Returns the solution x of Ax = b using the current decomposition "
-             "of A.")
-        .def("error", &IS::error,
+        .def(instrumentedMethod<exclusive>(
+            "solve", &solve<VectorType>,
+            "Returns the solution x of Ax = b using the current decomposition "
+            "of A."))
+        .def(instrumentedMethod<exclusive>(
+            "solve", &solve<DenseMatrix>,
+            "Returns the solution x of Ax = b using the current decomposition "
+            "of A."))
+        .def("error", lockShared<IS>(&IS::error),
              "Returns the tolerance error reached during the last solve.\n"
              "It is a close approximation of the true relative residual error "
              "|Ax-b|/|b|.")
-        .def("info", &IS::info,
+        .def("info", lockShared<IS>(&IS::info),
              "Returns success if the iterations converged, and NoConvergence "
              "otherwise.")
         .def(
-            "iterations", &IS::iterations,
+            "iterations", lockShared<IS>(&IS::iterations),
             "Returns the number of iterations performed during the last solve.")
         .def("maxIterations", &IS::maxIterations,
              "Returns the max number of iterations.\n"
              "It is either the value setted by setMaxIterations or, by "
              "default, twice the number of columns of the matrix.")
-        .def("setMaxIterations", &IS::setMaxIterations,
+        .def("setMaxIterations", lockExclusive<IS>(&IS::setMaxIterations),
              "Sets the max number of iterations.\n"
              "Default is twice the number of columns of the matrix.",
              nb::rv_policy::reference)
         .def("tolerance", &IS::tolerance,
              "Returns he tolerance threshold used by the stopping criteria.")
-        .def("setTolerance", &IS::setTolerance,
+        .def("setTolerance", lockExclusive<IS>(&IS::setTolerance),
              "Sets the tolerance threshold used by the stopping criteria.\n"
              "This value is used as an upper bound to the relative residual "
              "error: |Ax-b|/|b|. The default value is the machine precision.",
              nb::rv_policy::reference)
-        .def("analyzePattern", &analyzePattern, "A"_a,
-             "Initializes the iterative solver for the sparsity pattern of the "
-             "matrix A for further solving Ax=b problems.\n"
-             "Currently, this function mostly calls analyzePattern on the "
-             "preconditioner.\n"
-             "In the future we might, for instance, implement column "
-             "reordering for faster matrix vector products.",
-             nb::rv_policy::reference)
-        .def("factorize", &factorize, "A"_a,
-             "Initializes the iterative solver with the numerical values of "
-             "the matrix A for further solving Ax=b problems.\n"
-             "Currently, this function mostly calls factorize on the "
-             "preconditioner.",
-             nb::rv_policy::reference)
-        .def("compute", &compute, "A"_a,
-             "Initializes the iterative solver with the numerical values of "
-             "the matrix A for further solving Ax=b problems.\n"
-             "Currently, this function mostly calls factorize on the "
-             "preconditioner.\n"
-             "In the future we might, for instance, implement column "
-             "reordering for faster matrix vector products.",
-             nb::rv_policy::reference)
-        .def("solveWithGuess", &solveWithGuess<VectorType>, "b"_a, "x_0"_a,
-             "Returns the solution x of Ax = b using the current decomposition "
-             "of A and x0 as an initial solution.")
-        .def("solveWithGuess", &solveWithGuess<DenseMatrix>, "b"_a, "x_0"_a,
-             "Returns the solution x of Ax = b using the current decomposition "
-             "of A and x0 as an initial solution.")
+        .def(instrumentedMethod<exclusive>(
+            "analyzePattern", &analyzePattern, "A"_a,
+            "Initializes the iterative solver for the sparsity pattern of the "
+            "matrix A for further solving Ax=b problems.\n"
+            "Currently, this function mostly calls analyzePattern on the "
+            "preconditioner.\n"
+            "In the future we might, for instance, implement column "
+            "reordering for faster matrix vector products.",
+            nb::rv_policy::reference))
+        .def(instrumentedMethod<exclusive>(
+            "factorize", &factorize, "A"_a,
+            "Initializes the iterative solver with the numerical values of "
+            "the matrix A for further solving Ax=b problems.\n"
+            "Currently, this function mostly calls factorize on the "
+            "preconditioner.",
+            nb::rv_policy::reference))
+        .def(computeMethod(
+            &compute, "A"_a,
+            "Initializes the iterative solver with the numerical values of "
+            "the matrix A for further solving Ax=b problems.\n"
+            "Currently, this function mostly calls factorize on the "
+            "preconditioner.\n"
+            "In the future we might, for instance, implement column "
+            "reordering for faster matrix vector products."))
+        .def(instrumentedMethod<exclusive>(
+            "solveWithGuess", &solveWithGuess<VectorType>, "b"_a, "x_0"_a,
+            "Returns the solution x of Ax = b using the current decomposition "
+            "of A and x0 as an initial solution."))
+        .def(instrumentedMethod<exclusive>(
+            "solveWithGuess", &solveWithGuess<DenseMatrix>, "b"_a, "x_0"_a,
+            "Returns the solution x of Ax = b using the current decomposition "
+            "of A and x0 as an initial solution."))
+        .def("solveAsync", &solveAsync<VectorType>, "b"_a,
+             "check_interval"_a = 100,
+             "Schedules solve(b) on the internal thread pool, and returns a "
+             "nanoeigenpy.Future of the solution.\n"
+             "The solve runs by batches of check_interval iterations, each "
+             "one restarting from the current iterate, and cancelling the "
+             "future interrupts it between two batches. A nonpositive "
+             "check_interval runs a single uninterruptible solve. The other "
+             "calls of the solver wait for the solve once it started.")
+        .def("solveAsync", &solveAsync<DenseMatrix>, "B"_a,
+             "check_interval"_a = 100,
+             "Schedules solve(B) on the internal thread pool, and returns a "
+             "nanoeigenpy.Future of the solution. See solveAsync(b).")
         .def(
             "preconditioner",
             [](IterativeSolver& self) -> Preconditioner& {
@@ -96,6 +136,9 @@ struct IterativeSolverVisitor
   }
 
  private:
+  /// Statistics of solveAsync(), whose tasks only time their kernel.
+  static inline instrumentation::MethodStats* solveAsyncStats = nullptr;
+
   static IterativeSolver& factorize(IterativeSolver& self,
                                     Eigen::Ref<const MatrixType> m) {
     return self.factorize(m);
@@ -116,6 +159,44 @@ struct IterativeSolverVisitor
     return self.solve(b);
   }
 
+  /// Solves by batches of \a checkInterval iterations, checking the
+  /// cancellation flag between two batches.
+  template <typename T>
+  static nb::object solveAsync(nb::pointer_and_handle<IterativeSolver> self,
+                               T b, Eigen::Index checkInterval) {
+    return launchAsync<locks::Mode::Exclusive>(
+        self, checkInterval > 0,
+        [b = std::move(b), checkInterval](
+            IterativeSolver& solver, const std::atomic<bool>& cancelled) -> T {
+          instrumentation::KernelScope scope(solveAsyncStats, solver, b);
+          using Accessor = detail::IterativeSolverAccessor<IterativeSolver>;
+          if (checkInterval <= 0) return solver.solve(b);
+
+          Eigen::Index& maxIterations = Accessor::maxIterations(solver);
+          const Eigen::Index savedMaxIterations = maxIterations;
+          const Eigen::Index budget = solver.maxIterations();
+          T x = T::Zero(solver.cols(), b.cols());
+          Eigen::Index iterations = 0;
+          try {
+            for (;;) {
+              maxIterations = std::min(checkInterval, budget - iterations);
+              x = solver.solveWithGuess(b, x);
+              iterations += solver.iterations();
+              if (solver.info() != Eigen::NoConvergence ||
+                  solver.iterations() == 0 || iterations >= budget)
+                break;
+              if (cancelled) throw detail::AsyncCancelled();
+            }
+          } catch (...) {
+            maxIterations = savedMaxIterations;
+            throw;
+          }
+          maxIterations = savedMaxIterations;
+          Accessor::iterations(solver) = iterations;
+          return x;
+        });
+  }
+
   template <typename T>
   static T solveWithGuess(const IterativeSolver& self, Eigen::Ref<const T> b,
                           Eigen::Ref<const T> x0) {
@@ -0,0 +1,369 @@
+/// Copyright 2025 INRIA
+
+#pragma once
+
+#include "nanoeigenpy/fwd.hpp"
+#include "nanoeigenpy/utils/sparse-matrix-handle.hpp"
+#include "nanoeigenpy/utils/instrumentation.hpp"
+#include "nanoeigenpy/utils/object-lock.hpp"
+#include "nanoeigenpy/utils/views.hpp"
+#include <nanobind/eigen/dense.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace nanoeigenpy {
+namespace nb = nanobind;
+using namespace nb::literals;
+
+namespace detail {
+
+/// \brief Fixed-size pool of worker threads running the asynchronous
+/// computations.
+///
+/// The workers are detached and the pool is never destroyed: joining them
+/// when the module is unloaded could deadlock with a task waiting for the
+/// GIL during the interpreter shutdown.
+class ThreadPool {
+ public:
+  explicit ThreadPool(std::size_t size) {
+    for (std::size_t k = 0; k < size; ++k)
+      std::thread([this] { run(); }).detach();
+  }
+
+  void push(std::function<void()> task) {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_tasks.push_back(std::move(task));
+    }
+    m_condition.notify_one();
+  }
+
+ private:
+  void run() {
+    for (;;) {
+      std::function<void()> task;
+      {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_condition.wait(lock, [this] { return !m_tasks.empty(); });
+        task = std::move(m_tasks.front());
+        m_tasks.pop_front();
+      }
+      task();
+    }
+  }
+
+  std::mutex m_mutex;
+  std::condition_variable m_condition;
+  std::deque<std::function<void()>> m_tasks;
+};
+
+inline ThreadPool &asyncThreadPool() {
+  static ThreadPool *pool =
+      new ThreadPool(std::max(1u, std::thread::hardware_concurrency()));
+  return *pool;
+}
+
+/// \brief Thrown by an interruptible task which noticed that its future was
+/// cancelled.
+struct AsyncCancelled {};
+
+/// \brief Cancellation state of an interruptible task, shared by the task
+/// and its future.
+class AsyncState {
+ public:
+  /// Set when the running task must stop, checked by the task.
+  const std::atomic<bool> &cancelled() const { return m_cancelled; }
+
+  /// \brief Asks the running task to stop.
+  /// \returns false if it already ended, in which case it is not cancelled.
+  bool interrupt() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_finished) return false;
+    m_cancelled = true;
+    return true;
+  }
+
+  /// \brief Marks the end of the task.
+  /// \returns whether it was interrupted, in which case its result is
+  /// discarded.
+  bool finish() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_finished = true;
+    return m_cancelled;
+  }
+
+ private:
+  std::mutex m_mutex;
+  std::atomic<bool> m_cancelled{false};
+  bool m_finished = false;
+};
+
+inline AsyncState &asyncState(nb::handle future) {
+  return **static_cast<std::shared_ptr<AsyncState> *>(
+      nb::cast<nb::capsule>(future.attr("_async_state")).data());
+}
+
+/// \brief Python objects held by a task, which are only released with the
+/// GIL held.
+struct AsyncTask {
+  nb::object self;
+  nb::object future;
+
+  void release() {
+    self.reset();
+    future.reset();
+  }
+  ~AsyncTask() {
+    // The interpreter was finalized before the task ended: leak them.
+    self.release();
+    future.release();
+  }
+};
+
+}  // namespace detail
+
+/// \returns nanoeigenpy.Future, the subclass of concurrent.futures.Future
+/// returned by the asynchronous methods.
+///
+/// Its cancel() also interrupts a running interruptible task (an iterative
+/// solve), which then ends with a CancelledError, and is cancelled() as soon
+/// as cancel() returned True. It can be awaited from asyncio.
+inline nb::handle asyncFutureType() {
+  static nb::handle type = [] {
+    nb::object base = nb::module_::import_("concurrent.futures").attr("Future");
+    nb::dict ns;
+    ns["__module__"] = "nanoeigenpy";
+    ns["__doc__"] =
+        "Result of an asynchronous computation of nanoeigenpy, run on an "
+        "internal thread pool. It is a concurrent.futures.Future, which can "
+        "also be awaited.";
+    ns["cancel"] = nb::cpp_function(
+        [base](nb::handle self) -> bool {
+          if (nb::cast<bool>(base.attr("cancel")(self))) return true;
+          return nb::cast<bool>(self.attr("_interruptible")) &&
+                 nb::cast<bool>(self.attr("running")()) &&
+                 detail::asyncState(self).interrupt();
+        },
+        nb::is_method(), nb::name("cancel"),
+        "Cancels the computation if it has not started yet, or interrupts it "
+        "if it is an iterative solve. Returns False if it cannot be "
+        "cancelled.");
+    ns["cancelled"] = nb::cpp_function(
+        [base](nb::handle self) -> bool {
+          return nb::cast<bool>(base.attr("cancelled")(self)) ||
+                 detail::asyncState(self).cancelled();
+        },
+        nb::is_method(), nb::name("cancelled"),
+        "Returns True if the computation was cancelled, including an "
+        "iterative solve interrupted by cancel() which has not stopped yet.");
+    ns["__await__"] = nb::cpp_function(
+        [](nb::handle self) {
+          return nb::module_::import_("asyncio")
+              .attr("wrap_future")(self)
+              .attr("__await__")();
+        },
+        nb::is_method(), nb::name("__await__"));
+    return nb::handle(reinterpret_cast<PyObject *>(&PyType_Type))(
+               "Future", nb::make_tuple(base), ns)
+        .release();
+  }();
+  return type;
+}
+
+/// \brief Runs work(solver, cancelled) on the internal thread pool, without
+/// the GIL, and returns a nanoeigenpy.Future of its result.
+///
+/// The task holds the lock of the solver in the given \a mode while running
+/// \a work, like the synchronous method, so that the solver can be used
+/// concurrently. The future holds a reference to \a self until the task
+/// ends, and the arguments of the task are owned by \a work. The result of a
+/// task returning void is \a self. If \a interruptible is true, \a work
+/// should check the flag regularly and throw detail::AsyncCancelled when it
+/// is set.
+template <locks::Mode mode, typename Solver, typename Work>
+nb::object launchAsync(nb::pointer_and_handle<Solver> self, bool interruptible,
+                       Work &&work) {
+  using Result = std::invoke_result_t<std::decay_t<Work> &, Solver &,
+                                      const std::atomic<bool> &>;
+
+  nb::object future = asyncFutureType()();
+  using State = std::shared_ptr<detail::AsyncState>;
+  State state = std::make_shared<detail::AsyncState>();
+  future.attr("_async_state") =
+      nb::capsule(new State(state), [](void *p) noexcept {
+        delete static_cast<State *>(p);
+      });
+  future.attr("_interruptible") = interruptible;
+
+  auto task = std::make_shared<detail::AsyncTask>();
+  task->self = nb::borrow(self.h);
+  task->future = future;
+  Solver *solver = self.p;
+
+  detail::asyncThreadPool().push(
+      [task, state, solver, work = std::forward<Work>(work)]() mutable {
+        if (!nb::is_alive()) return;
+        {
+          nb::gil_scoped_acquire gil;
+          if (!nb::cast<bool>(
+                  task->future.attr("set_running_or_notify_cancel")())) {
+            task->release();
+            return;
+          }
+        }
+
+        std::function<nb::object()> result;  // called with the GIL held
+        bool cancelled = false;
+        std::string error;
+        try {
+          locks::ObjectLock<mode> lock(solver);
+          if constexpr (std::is_void_v<Result>) {
+            work(*solver, state->cancelled());
+            result = [task] { return task->self; };
+          } else {
+            auto value =
+                std::make_shared<Result>(work(*solver, state->cancelled()));
+            result = [value] { return nb::cast(std::move(*value)); };
+          }
+        } catch (const detail::AsyncCancelled &) {
+          cancelled = true;
+        } catch (const std::exception &e) {
+          error = e.what();
+          if (error.empty()) error = "Asynchronous computation failed.";
+        }
+        // A task interrupted after its last check of the flag is cancelled
+        // too, since cancel() returned True.
+        if (state->finish()) cancelled = true;
+
+        if (!nb::is_alive()) return;
+        nb::gil_scoped_acquire gil;
+        try {
+          if (cancelled)
+            task->future.attr("set_exception")(
+                nb::module_::import_("concurrent.futures")
+                    .attr("CancelledError")());
+          else if (!error.empty())
+            task->future.attr("set_exception")(
+                nb::handle(PyExc_RuntimeError)(error.c_str()));
+          else
+            task->future.attr("set_result")(result());
+        } catch (nb::python_error &e) {
+          e.discard_as_unraisable(task->future);
+        }
+        result = nullptr;
+        task->release();
+      });
+  return future;
+}
+
+/// \brief Adds computeAsync(), when the solver has compute(), and
+/// solveAsync(), which run on the internal thread pool. computeAsync() takes
+/// the ordering argument of compute() for the solvers using a
+/// RuntimeOrdering.
+///
+/// The tasks take the lock of the solver like compute() and solve(): \c
+/// solveAsync takes it exclusively if \a LockSolve is true. Like compute(),
+/// computeAsync() moves the factors viewed by NumPy arrays to their views.
+/// The kernels of the tasks are timed in the statistics of the methods, and
+/// traced (see instrumentation::KernelScope).
+template <typename MatrixType, bool LockSolve = false>
+struct AsyncVisitor : nb::def_visitor<AsyncVisitor<MatrixType, LockSolve>> {
+  template <typename Solver, typename... Ts>
+  void execute(nb::class_<Solver, Ts...> &cl) {
+    using Scalar = typename MatrixType::Scalar;
+    using DenseVector = Eigen::Matrix<Scalar, Eigen::Dynamic, 1>;
+    using DenseMatrix = Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>;
+    using Handle = nb::pointer_and_handle<Solver>;
+    constexpr locks::Mode solveMode =
+        LockSolve ? locks::Mode::Exclusive : locks::Mode::Shared;
+
+    if constexpr (detail::has_runtime_ordering<Solver>::value) {
+      // The OrderingScope is opened by the task, on the thread where the
+      // solver constructs its ordering functor.
+      instrumentation::MethodStats *stats = methodStats(cl, "computeAsync");
+      cl.def(
+          "computeAsync",
+          [stats](Handle self, MatrixType matrix, OrderingMethod ordering) {
+            return launchAsync<locks::Mode::Exclusive>(
+                self, false,
+                [stats, matrix = std::move(matrix), ordering](
+                    Solver &solver, const std::atomic<bool> &) {
+                  views::detachViews(&solver);
+                  instrumentation::KernelScope scope(stats, solver, matrix);
+                  OrderingScope orderingScope(ordering);
+                  solver.compute(matrix);
+                });
+          },
+          "matrix"_a, "ordering"_a = Solver::OrderingType::DefaultMethod,
+          "Schedules compute(matrix, ordering) on the internal thread pool, "
+          "and returns a nanoeigenpy.Future whose result is the "
+          "decomposition itself. The matrix is copied. The other calls of "
+          "the decomposition wait for the computation once it started.");
+    } else if constexpr (detail::has_compute<Solver, MatrixType>::value) {
+      instrumentation::MethodStats *stats = methodStats(cl, "computeAsync");
+      cl.def(
+          "computeAsync",
+          [stats](Handle self, MatrixType matrix) {
+            return launchAsync<locks::Mode::Exclusive>(
+                self, false,
+                [stats, matrix = std::move(matrix)](
+                    Solver &solver, const std::atomic<bool> &) {
+                  views::detachViews(&solver);
+                  instrumentation::KernelScope scope(stats, solver, matrix);
+                  solver.compute(matrix);
+                });
+          },
+          "matrix"_a,
+          "Schedules compute(matrix) on the internal thread pool, and "
+          "returns a nanoeigenpy.Future whose result is the decomposition "
+          "itself. The matrix is copied. The other calls of the "
+          "decomposition wait for the computation once it started.");
+    }
+
+    instrumentation::MethodStats *stats = methodStats(cl, "solveAsync");
+    cl.def(
+          "solveAsync",
+          [stats](Handle self, DenseVector b) {
+            return launchAsync<solveMode>(
+                self, false,
+                [stats, b = std::move(b)](Solver &solver,
+                                          const std::atomic<bool> &) {
+                  instrumentation::KernelScope scope(stats, solver, b);
+                  return DenseVector(solver.solve(b));
+                });
+          },
+          "b"_a,
+          "Schedules solve(b) on the internal thread pool, and returns a "
+          "nanoeigenpy.Future of the solution. The right hand side is "
+          "copied.")
+        .def(
+            "solveAsync",
+            [stats](Handle self, DenseMatrix B) {
+              return launchAsync<solveMode>(
+                  self, false,
+                  [stats, B = std::move(B)](Solver &solver,
+                                            const std::atomic<bool> &) {
+                    instrumentation::KernelScope scope(stats, solver, B);
+                    return DenseMatrix(solver.solve(B));
+                  });
+            },
+            "B"_a,
+            "Schedules solve(B) on the internal thread pool, and returns a "
+            "nanoeigenpy.Future of the solution. The right hand side is "
+            "copied.");
+  }
+};
+
+inline void exposeAsync(nb::module_ m) { m.attr("Future") = asyncFutureType(); }
+
+}  // namespace nanoeigenpy
@@ -0,0 +1,702 @@
+/// Copyright 2025 INRIA
+
+#pragma once
+
+#include <nanobind/nanobind.h>
+#include <nanobind/stl/string.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <ostream>
+#include <stdexcept>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace nanoeigenpy {
+namespace nb = nanobind;
+
+/// \brief Opt-in call counters, timers and trace of the instrumented methods.
+///
+/// The time of a call from Python is split between the conversion of its
+/// arguments, the Eigen kernel and the conversion of its result. The
+/// instrumented methods wrap their implementation with instrument() and take
+/// the InstrumentedCall extra, which marks the begin and the end of the call.
+/// When tracing, the kernels are also recorded as events in a ring buffer of
+/// the thread running them. When the module is built with allocation tracking,
+/// the heap allocations of the kernels can also be counted. When the
+/// instrumentation is disabled, a call only reads an atomic flag and a
+/// thread-local state.
+namespace instrumentation {
+
+using Clock = std::chrono::steady_clock;
+
+inline std::int64_t nanoseconds(Clock::duration d) {
+  return static_cast<std::int64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(d).count());
+}
+
+/// \brief Heap allocations of the running kernel, counted by the allocation
+/// functions of the module (see src/allocation-hooks.cpp).
+struct AllocationCounters {
+  std::uint64_t count = 0;
+  std::uint64_t bytes = 0;
+  /// Bytes allocated minus bytes freed since the start of the kernel.
+  std::int64_t live = 0;
+  /// Maximum of live.
+  std::int64_t peak = 0;
+
+  void allocate(std::size_t size) {
+    ++count;
+    bytes += size;
+    live += static_cast<std::int64_t>(size);
+    peak = std::max(peak, live);
+  }
+
+  void deallocate(std::size_t size) { live -= static_cast<std::int64_t>(size); }
+};
+
+/// \returns the counters of the kernel running on this thread, or null when
+/// its allocations are not tracked.
+inline AllocationCounters *&currentAllocations() {
+  static thread_local AllocationCounters *counters = nullptr;
+  return counters;
+}
+
+/// \brief Accumulated statistics of one method, over all its overloads.
+struct MethodStats {
+  explicit MethodStats(std::string name) : name(std::move(name)) {}
+
+  /// Qualified name, e.g. "SparseLU.factorize".
+  const std::string name;
+  std::atomic<std::uint64_t> calls{0};
+  std::atomic<std::uint64_t> conversionNs{0};
+  std::atomic<std::uint64_t> kernelNs{0};
+  std::atomic<std::uint64_t> resultNs{0};
+  std::atomic<std::uint64_t> allocations{0};
+  std::atomic<std::uint64_t> allocatedBytes{0};
+  /// Maximum over the calls of their peak of live bytes.
+  std::atomic<std::uint64_t> peakBytes{0};
+
+  void record(Clock::duration conversion, Clock::duration kernel,
+              Clock::duration result) {
+    calls.fetch_add(1, std::memory_order_relaxed);
+    conversionNs.fetch_add(nanoseconds(conversion), std::memory_order_relaxed);
+    kernelNs.fetch_add(nanoseconds(kernel), std::memory_order_relaxed);
+    resultNs.fetch_add(nanoseconds(result), std::memory_order_relaxed);
+  }
+
+  void recordAllocations(const AllocationCounters &counters) {
+    allocations.fetch_add(counters.count, std::memory_order_relaxed);
+    allocatedBytes.fetch_add(counters.bytes, std::memory_order_relaxed);
+    const std::uint64_t peak = static_cast<std::uint64_t>(counters.peak);
+    std::uint64_t previous = peakBytes.load(std::memory_order_relaxed);
+    while (previous < peak &&
+           !peakBytes.compare_exchange_weak(previous, peak,
+                                            std::memory_order_relaxed)) {
+    }
+  }
+
+  void reset() {
+    calls = 0;
+    conversionNs = 0;
+    kernelNs = 0;
+    resultNs = 0;
+    allocations = 0;
+    allocatedBytes = 0;
+    peakBytes = 0;
+  }
+};
+
+/// \brief Instrumentation features, enabled independently.
+enum Mode : unsigned { Stats = 1u, Trace = 2u, Allocations = 4u };
+
+/// \returns whether the allocation functions of the module count the
+/// allocations (the BUILD_WITH_ALLOCATION_TRACKING CMake option).
+constexpr bool allocationTrackingAvailable() {
+#ifdef NANOEIGENPY_WITH_ALLOCATION_TRACKING
+  return true;
+#else
+  return false;
+#endif
+}
+
+inline std::atomic<unsigned> &modeFlags() {
+  static std::atomic<unsigned> flags{0};
+  return flags;
+}
+
+inline unsigned modes() { return modeFlags().load(std::memory_order_relaxed); }
+
+inline void setMode(Mode mode, bool enabled) {
+  if (enabled)
+    modeFlags().fetch_or(mode);
+  else
+    modeFlags().fetch_and(~unsigned(mode));
+}
+
+inline bool enabled() { return (modes() & Stats) != 0; }
+
+/// \brief Statistics of all the instrumented methods, by qualified name
+/// (e.g. "SparseLU.factorize"). The entries are never removed, so that the
+/// bindings and the trace events can keep pointers to them.
+struct Registry {
+  std::mutex mutex;
+  std::map<std::string, std::unique_ptr<MethodStats>> methods;
+
+  static Registry &instance() {
+    static Registry *registry = new Registry();
+    return *registry;
+  }
+
+  MethodStats *get(const std::string &name) {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::unique_ptr<MethodStats> &stats = methods[name];
+    if (!stats) stats = std::make_unique<MethodStats>(name);
+    return stats.get();
+  }
+};
+
+/// \brief Kernel of an instrumented method, with the shape of the matrix it
+/// was called with (-1 if the method takes no matrix).
+struct TraceEvent {
+  const MethodStats *method;
+  Clock::time_point begin;
+  Clock::time_point end;
+  std::int64_t rows;
+  std::int64_t cols;
+  std::int64_t nonZeros;
+};
+
+/// \brief Ring buffer of the trace events of one thread.
+///
+/// Only its thread pushes events, without locking: when the buffer is full,
+/// the oldest events are overwritten. Each slot is a seqlock, so that
+/// events() can be called from another thread while events are pushed: it
+/// skips the events overwritten during the copy.
+class TraceBuffer {
+ public:
+  TraceBuffer(std::size_t capacity, unsigned generation, int thread)
+      : generation(generation),
+        thread(thread),
+        m_capacity(std::max<std::size_t>(capacity, 1)),
+        m_slots(new Slot[m_capacity]) {}
+
+  void push(const TraceEvent &event) {
+    const std::size_t head = m_head.load(std::memory_order_relaxed);
+    Slot &slot = m_slots[head % m_capacity];
+    slot.sequence.store(2 * head + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.method.store(event.method, std::memory_order_relaxed);
+    slot.begin.store(event.begin.time_since_epoch().count(),
+                     std::memory_order_relaxed);
+    slot.end.store(event.end.time_since_epoch().count(),
+                   std::memory_order_relaxed);
+    slot.rows.store(event.rows, std::memory_order_relaxed);
+    slot.cols.store(event.cols, std::memory_order_relaxed);
+    slot.nonZeros.store(event.nonZeros, std::memory_order_relaxed);
+    slot.sequence.store(2 * head + 2, std::memory_order_release);
+    m_head.store(head + 1, std::memory_order_release);
+  }
+
+  /// \returns the events kept in the buffer, from the oldest.
+  std::vector<TraceEvent> events() const {
+    const std::size_t head = m_head.load(std::memory_order_acquire);
+    const std::size_t first = head > m_capacity ? head - m_capacity : 0;
+    std::vector<TraceEvent> result;
+    result.reserve(head - first);
+    for (std::size_t k = first; k < head; ++k) {
+      const Slot &slot = m_slots[k % m_capacity];
+      // The slot holds the event k if its sequence is the same before and
+      // after the copy.
+      const std::size_t sequence = 2 * k + 2;
+      if (slot.sequence.load(std::memory_order_acquire) != sequence) continue;
+      TraceEvent event{
+          slot.method.load(std::memory_order_relaxed),
+          Clock::time_point(
+              Clock::duration(slot.begin.load(std::memory_order_relaxed))),
+          Clock::time_point(
+              Clock::duration(slot.end.load(std::memory_order_relaxed))),
+          slot.rows.load(std::memory_order_relaxed),
+          slot.cols.load(std::memory_order_relaxed),
+          slot.nonZeros.load(std::memory_order_relaxed)};
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (slot.sequence.load(std::memory_order_relaxed) != sequence) continue;
+      result.push_back(event);
+    }
+    return result;
+  }
+
+  /// \returns the number of events overwritten since the start.
+  std::size_t dropped() const {
+    const std::size_t head = m_head.load(std::memory_order_acquire);
+    return head > m_capacity ? head - m_capacity : 0;
+  }
+
+  /// Tracing session of the buffer.
+  const unsigned generation;
+  /// Sequential id of the thread.
+  const int thread;
+
+ private:
+  /// \brief Event of the buffer, whose fields are atomic so that they can be
+  /// read while they are written.
+  struct Slot {
+    /// 2 k + 1 while the event k is written, 2 k + 2 once it is written.
+    std::atomic<std::size_t> sequence{0};
+    std::atomic<const MethodStats *> method{nullptr};
+    std::atomic<Clock::rep> begin{0};
+    std::atomic<Clock::rep> end{0};
+    std::atomic<std::int64_t> rows{0};
+    std::atomic<std::int64_t> cols{0};
+    std::atomic<std::int64_t> nonZeros{0};
+  };
+
+  std::size_t m_capacity;
+  std::unique_ptr<Slot[]> m_slots;
+  std::atomic<std::size_t> m_head{0};
+};
+
+/// \brief Ring buffers of the threads which ran instrumented kernels since
+/// the last start().
+struct Tracer {
+  std::mutex mutex;
+  std::vector<std::shared_ptr<TraceBuffer>> buffers;
+  std::atomic<unsigned> generation{0};
+  std::size_t capacity = 0;
+  Clock::time_point origin = Clock::now();
+
+  static Tracer &instance() {
+    static Tracer *tracer = new Tracer();
+    return *tracer;
+  }
+
+  /// Discards the recorded events and starts recording up to
+  /// \a eventsPerThread events per thread.
+  void start(std::size_t eventsPerThread) {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      buffers.clear();
+      capacity = eventsPerThread;
+      origin = Clock::now();
+      generation.fetch_add(1, std::memory_order_release);
+    }
+    setMode(Trace, true);
+  }
+
+  /// \returns the buffers of the current session, and its start time in
+  /// \a origin.
+  std::vector<std::shared_ptr<TraceBuffer>> snapshot(
+      Clock::time_point &origin) {
+    std::lock_guard<std::mutex> lock(mutex);
+    origin = this->origin;
+    return buffers;
+  }
+
+  /// \returns the buffer of the calling thread for the current session,
+  /// registering it on the first event of the thread.
+  TraceBuffer &threadBuffer() {
+    static std::atomic<int> nextThread{0};
+    static thread_local int thread = nextThread.fetch_add(1);
+    static thread_local std::shared_ptr<TraceBuffer> buffer;
+    if (!buffer ||
+        buffer->generation != generation.load(std::memory_order_acquire)) {
+      std::lock_guard<std::mutex> lock(mutex);
+      buffer = std::make_shared<TraceBuffer>(
+          capacity, generation.load(std::memory_order_relaxed), thread);
+      buffers.push_back(buffer);
+    }
+    return *buffer;
+  }
+};
+
+/// \brief Timestamps of the call from Python running on this thread.
+struct CallState {
+  bool started = false;
+  Clock::time_point start;
+  Clock::time_point kernelStart;
+  Clock::time_point kernelEnd;
+  /// Set by the kernel, when it ends.
+  MethodStats *method = nullptr;
+};
+
+inline CallState &currentCall() {
+  static thread_local CallState state;
+  return state;
+}
+
+/// \brief nanobind call policy, invoked before the conversion of the
+/// arguments and after the conversion of the result.
+struct CallPolicy {
+  static void precall(PyObject **, size_t, nb::detail::cleanup_list *) {
+    if (!enabled()) return;
+    CallState &call = currentCall();
+    call.started = true;
+    call.method = nullptr;
+    call.start = Clock::now();
+  }
+
+  static void postcall(PyObject **, size_t, nb::handle) {
+    CallState &call = currentCall();
+    if (call.method != nullptr) {
+      call.method->record(call.kernelStart - call.start,
+                          call.kernelEnd - call.kernelStart,
+                          Clock::now() - call.kernelEnd);
+    }
+    call.started = false;
+    call.method = nullptr;
+  }
+};
+
+namespace detail {
+
+template <typename T, typename = void>
+struct has_shape : std::false_type {};
+template <typename T>
+struct has_shape<T, std::void_t<decltype(std::declval<const T &>().rows()),
+                                decltype(std::declval<const T &>().cols())>>
+    : std::true_type {};
+
+template <typename T, typename = void>
+struct has_non_zeros : std::false_type {};
+template <typename T>
+struct has_non_zeros<
+    T, std::void_t<decltype(std::declval<const T &>().nonZeros())>>
+    : std::true_type {};
+
+/// Records the shape of \a operand, the first argument after the solver.
+template <typename Self, typename Operand, typename... Args>
+void operandShape(TraceEvent &event, const Self &, const Operand &operand,
+                  const Args &...) {
+  if constexpr (has_shape<Operand>::value) {
+    event.rows = static_cast<std::int64_t>(operand.rows());
+    event.cols = static_cast<std::int64_t>(operand.cols());
+    if constexpr (has_non_zeros<Operand>::value)
+      event.nonZeros = static_cast<std::int64_t>(operand.nonZeros());
+  }
+}
+
+template <typename... Args>
+void operandShape(TraceEvent &, const Args &...) {}
+
+}  // namespace detail
+
+/// \brief Times the Eigen kernel of an instrumented method, called with
+/// \a args (the solver and its arguments).
+///
+/// Outside of a call from Python, e.g. in an asynchronous task, only the
+/// kernel is timed. The allocations of a nested kernel also count in the
+/// enclosing one, but those of other threads (e.g. OpenMP) are not counted.
+class KernelScope {
+ public:
+  template <typename... Args>
+  explicit KernelScope(MethodStats *stats, const Args &...args)
+      : m_stats(stats), m_modes(modes()) {
+    if (m_modes == 0) return;
+    if (m_modes & Trace) {
+      m_event = TraceEvent{stats, {}, {}, -1, -1, -1};
+      detail::operandShape(m_event, args...);
+    }
+    if (m_modes & Allocations) {
+      m_enclosing = currentAllocations();
+      currentAllocations() = &m_allocations;
+    }
+    m_start = Clock::now();
+  }
+
+  ~KernelScope() {
+    if (m_modes == 0) return;
+    const Clock::time_point end = Clock::now();
+    if (m_modes & Allocations) {
+      currentAllocations() = m_enclosing;
+      if (m_enclosing) {
+        m_enclosing->count += m_allocations.count;
+        m_enclosing->bytes += m_allocations.bytes;
+        m_enclosing->peak = std::max(m_enclosing->peak,
+                                     m_enclosing->live + m_allocations.peak);
+        m_enclosing->live += m_allocations.live;
+      }
+      m_stats->recordAllocations(m_allocations);
+    }
+    if (m_modes & Trace) {
+      m_event.begin = m_start;
+      m_event.end = end;
+      Tracer::instance().threadBuffer().push(m_event);
+    }
+    if (!(m_modes & Stats)) return;
+    CallState &call = currentCall();
+    if (call.started && call.method == nullptr) {
+      call.kernelStart = m_start;
+      call.kernelEnd = end;
+      call.method = m_stats;
+    } else {
+      m_stats->record(Clock::duration::zero(), end - m_start,
+                      Clock::duration::zero());
+    }
+  }
+
+  KernelScope(const KernelScope &) = delete;
+  KernelScope &operator=(const KernelScope &) = delete;
+
+ private:
+  MethodStats *m_stats;
+  unsigned m_modes;
+  Clock::time_point m_start;
+  TraceEvent m_event;
+  AllocationCounters m_allocations;
+  AllocationCounters *m_enclosing = nullptr;
+};
+
+namespace detail {
+
+/// \brief Wraps a callable in a lambda with the same signature, timing its
+/// calls as the kernel of a method.
+template <typename Signature>
+struct Timed;
+
+template <typename Return, typename... Args>
+struct Timed<Return(Args...)> {
+  template <typename F>
+  static auto wrap(MethodStats *stats, F f) {
+    return [stats, f](Args... args) -> Return {
+      KernelScope scope(stats, args...);
+      return f(std::forward<Args>(args)...);
+    };
+  }
+};
+
+template <typename Class, typename F, typename = void>
+struct signature;
+
+template <typename Class, typename Return, typename... Args>
+struct signature<Class, Return (*)(Args...)> {
+  using type = Return(Args...);
+};
+
+template <typename Class, typename Return, typename C, typename... Args>
+struct signature<Class, Return (C::*)(Args...)> {
+  using type = Return(Class &, Args...);
+};
+
+template <typename Class, typename Return, typename C, typename... Args>
+struct signature<Class, Return (C::*)(Args...) const> {
+  using type = Return(const Class &, Args...);
+};
+
+/// Lambdas, with the signature of their call operator.
+template <typename Class, typename F>
+struct signature<Class, F, std::void_t<decltype(&F::operator())>> {
+  template <typename Call>
+  struct call;
+  template <typename Return, typename Lambda, typename... Args>
+  struct call<Return (Lambda::*)(Args...) const> {
+    using type = Return(Args...);
+  };
+  using type = typename call<decltype(&F::operator())>::type;
+};
+
+}  // namespace detail
+
+}  // namespace instrumentation
+
+/// \brief Extra of the instrumented methods, which times the conversion of
+/// their arguments and of their result.
+using InstrumentedCall = nb::call_policy<instrumentation::CallPolicy>;
+
+/// \returns the statistics of the method \a name of the class bound by \a cl.
+template <typename Class, typename... Ts>
+instrumentation::MethodStats *methodStats(const nb::class_<Class, Ts...> &cl,
+                                          const char *name) {
+  return instrumentation::Registry::instance().get(
+      nb::cast<std::string>(cl.attr("__name__")) + "." + name);
+}
+
+/// \returns \a f, a function, lambda or member function of \a Class, with its
+/// calls counted and timed in the statistics of "<className>.<name>". The
+/// method must also be defined with InstrumentedCall.
+template <typename Class, typename F>
+auto instrument(const std::string &className, const char *name, F f) {
+  // Qualified, since nanoeigenpy::detail would make detail ambiguous.
+  namespace detail = instrumentation::detail;
+  instrumentation::MethodStats *stats =
+      instrumentation::Registry::instance().get(className + "." + name);
+  using Signature = typename detail::signature<Class, F>::type;
+  if constexpr (std::is_member_function_pointer_v<F>) {
+    return detail::Timed<Signature>::wrap(
+        stats, [f](auto &self, auto &&...args) -> decltype(auto) {
+          return (self.*f)(std::forward<decltype(args)>(args)...);
+        });
+  } else {
+    return detail::Timed<Signature>::wrap(stats, f);
+  }
+}
+
+/// \brief Overload for the methods of the class bound by \a cl.
+template <typename Class, typename... Ts, typename F>
+auto instrument(const nb::class_<Class, Ts...> &cl, const char *name, F f) {
+  return instrument<Class>(nb::cast<std::string>(cl.attr("__name__")), name,
+                           f);
+}
+
+namespace instrumentation {
+
+/// \brief Writes the recorded events in the Chrome trace event format, as
+/// complete ("X") events, which chrome://tracing and ui.perfetto.dev load.
+inline void writeChromeTrace(std::ostream &out) {
+  Clock::time_point origin;
+  const std::vector<std::shared_ptr<TraceBuffer>> buffers =
+      Tracer::instance().snapshot(origin);
+  auto microseconds = [](Clock::duration d) {
+    return std::to_string(double(nanoseconds(d)) * 1e-3);
+  };
+  out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  bool first = true;
+  for (const std::shared_ptr<TraceBuffer> &buffer : buffers) {
+    for (const TraceEvent &event : buffer->events()) {
+      out << (first ? "\n" : ",\n") << "{\"name\":\"" << event.method->name
+          << "\",\"cat\":\"nanoeigenpy\",\"ph\":\"X\",\"pid\":0"
+          << ",\"tid\":" << buffer->thread
+          << ",\"ts\":" << microseconds(event.begin - origin)
+          << ",\"dur\":" << microseconds(event.end - event.begin)
+          << ",\"args\":{\"rows\":" << event.rows << ",\"cols\":" << event.cols
+          << ",\"nonZeros\":" << event.nonZeros << "}}";
+      first = false;
+    }
+  }
+  out << "\n]}\n";
+}
+
+}  // namespace instrumentation
+
+inline void exposeInstrumentation(nb::module_ m) {
+  using namespace nb::literals;
+  using namespace instrumentation;
+
+  m.def(
+      "setStatsEnabled",
+      [](bool enabled, bool trackAllocations) {
+        if (enabled && trackAllocations && !allocationTrackingAvailable())
+          throw std::runtime_error(
+              "nanoeigenpy was built without allocation tracking "
+              "(BUILD_WITH_ALLOCATION_TRACKING).");
+        setMode(Allocations, enabled && trackAllocations);
+        setMode(Stats, enabled);
+      },
+      "enabled"_a, "track_allocations"_a = false,
+      "Enables or disables the call counters and timers of the instrumented "
+      "methods (the compute() methods of the decompositions, and the "
+      "analyzePattern(), factorize() and solve() methods of the sparse and "
+      "iterative solvers). They are disabled by default. With "
+      "track_allocations, the heap allocations of the Eigen kernels are also "
+      "counted, which requires a build with allocation tracking.");
+  m.def("allocationTrackingAvailable", &allocationTrackingAvailable,
+        "Returns whether the module was built with allocation tracking.");
+  m.def("statsEnabled", &instrumentation::enabled,
+        "Returns whether the instrumented methods are counted and timed.");
+  m.def(
+      "stats",
+      []() {
+        auto seconds = [](const std::atomic<std::uint64_t> &ns) {
+          return double(ns.load(std::memory_order_relaxed)) * 1e-9;
+        };
+        nb::dict result;
+        Registry &registry = Registry::instance();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        for (const auto &[name, stats] : registry.methods) {
+          const std::uint64_t calls = stats->calls.load();
+          if (calls == 0) continue;
+          const double conversion = seconds(stats->conversionNs);
+          const double kernel = seconds(stats->kernelNs);
+          const double output = seconds(stats->resultNs);
+          nb::dict entry;
+          entry["calls"] = calls;
+          entry["conversion"] = conversion;
+          entry["kernel"] = kernel;
+          entry["result"] = output;
+          entry["total"] = conversion + kernel + output;
+          entry["allocations"] = stats->allocations.load();
+          entry["allocated"] = stats->allocatedBytes.load();
+          entry["peak"] = stats->peakBytes.load();
+          result[name.c_str()] = entry;
+        }
+        return result;
+      },
+      "Returns the statistics of the instrumented methods called since the "
+      "last resetStats(), as a dict from \"<class>.<method>\" to a dict of "
+      "the number of calls and of the time in seconds spent in the "
+      "conversion of the arguments (\"conversion\"), the Eigen kernel "
+      "(\"kernel\") and the conversion of the result (\"result\"), and "
+      "their sum (\"total\"). The calls run asynchronously only count the "
+      "kernel. When the allocations are tracked, it also has the number of "
+      "heap allocations of the kernel (\"allocations\"), the bytes they "
+      "allocated (\"allocated\") and the maximum over the calls of the peak "
+      "of bytes live during the kernel (\"peak\").");
+  m.def(
+      "resetStats",
+      []() {
+        Registry &registry = Registry::instance();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        for (const auto &entry : registry.methods) entry.second->reset();
+      },
+      "Resets the statistics of the instrumented methods.");
+
+  m.def(
+      "startTracing",
+      [](std::size_t eventsPerThread) {
+        Tracer::instance().start(eventsPerThread);
+      },
+      "events_per_thread"_a = 65536,
+      "Discards the recorded trace and starts recording the kernels of the "
+      "instrumented methods, with their thread and the shape of their matrix "
+      "argument. Each thread keeps its last events_per_thread events in a "
+      "ring buffer.");
+  m.def(
+      "stopTracing", []() { setMode(Trace, false); },
+      "Stops recording the trace. The recorded events are kept.");
+  m.def(
+      "traceEvents",
+      []() {
+        Clock::time_point origin;
+        const std::vector<std::shared_ptr<TraceBuffer>> buffers =
+            Tracer::instance().snapshot(origin);
+        nb::list result;
+        for (const std::shared_ptr<TraceBuffer> &buffer : buffers) {
+          for (const TraceEvent &event : buffer->events()) {
+            nb::dict entry;
+            entry["name"] = event.method->name;
+            entry["thread"] = buffer->thread;
+            entry["begin"] = double(nanoseconds(event.begin - origin)) * 1e-9;
+            entry["end"] = double(nanoseconds(event.end - origin)) * 1e-9;
+            entry["rows"] = event.rows;
+            entry["cols"] = event.cols;
+            entry["nonZeros"] = event.nonZeros;
+            result.append(entry);
+          }
+        }
+        return result;
+      },
+      "Returns the recorded events, as a list of dicts with the qualified "
+      "name of the method, a sequential id of the thread, the begin and end "
+      "times in seconds since startTracing(), and the shape and number of "
+      "nonzeros of the matrix argument (-1 if there is none).");
+  m.def(
+      "dumpTrace",
+      [](const std::string &path) {
+        std::ofstream file(path, std::ios::trunc);
+        if (!file) throw std::runtime_error("Unable to open file " + path);
+        writeChromeTrace(file);
+        if (!file) throw std::runtime_error("Unable to write file " + path);
+      },
+      "path"_a,
+      "Writes the recorded events to a Chrome trace JSON file, which can be "
+      "opened in chrome://tracing or https://ui.perfetto.dev.");
+}
+
+}  // namespace nanoeigenpy
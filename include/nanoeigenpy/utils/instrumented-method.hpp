@@ -0,0 +1,114 @@
+/// Copyright 2025 INRIA
+
+#pragma once
+
+#include "nanoeigenpy/fwd.hpp"
+#include "nanoeigenpy/utils/instrumentation.hpp"
+#include "nanoeigenpy/utils/object-lock.hpp"
+#include "nanoeigenpy/utils/views.hpp"
+
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace nanoeigenpy {
+
+namespace detail {
+
+/// \brief Wraps a callable, whose first argument is the object, in a lambda
+/// with the same signature which first moves the viewed factors of the object
+/// to their views (see views::detachViews).
+template <typename Signature>
+struct DetachingViews;
+
+template <typename Return, typename Self, typename... Args>
+struct DetachingViews<Return(Self, Args...)> {
+  template <typename F>
+  static auto wrap(F f) {
+    return [f](Self self, Args... args) -> Return {
+      views::detachViews(&self);
+      return f(std::forward<Self>(self), std::forward<Args>(args)...);
+    };
+  }
+};
+
+}  // namespace detail
+
+/// \brief Defines the method \a name of a class, implemented by \a f (a
+/// function, lambda or member function of the class), which holds the lock
+/// of the object in \a mode during its calls, and whose calls are counted and
+/// timed in the statistics of "<Class>.<name>" (see instrumentation).
+///
+/// The compute, analyzePattern, factorize and solve methods of the solvers
+/// are all defined by this visitor, through instrumentedMethod() or the
+/// visitors of the solvers, rather than by wrapping their implementation in
+/// each binding. The \a extra (argument names, docstring, return value
+/// policy) are passed to nb::class_::def. If \a DetachViews is true, the
+/// method first moves the factors viewed by NumPy arrays out of the object,
+/// since it may resize them.
+template <locks::Mode mode, bool DetachViews, typename F, typename... Extra>
+struct InstrumentedMethodVisitor
+    : nb::def_visitor<
+          InstrumentedMethodVisitor<mode, DetachViews, F, Extra...>> {
+  InstrumentedMethodVisitor(const char *name, F f, Extra... extra)
+      : m_name(name), m_f(std::move(f)), m_extra(std::move(extra)...) {}
+
+  template <typename Class, typename... Ts>
+  void execute(nb::class_<Class, Ts...> &cl) const {
+    std::apply(
+        [&](const Extra &...extra) {
+          cl.def(m_name,
+                 locks::detail::locked<mode, Class>(
+                     instrument(cl, m_name, detaching<Class>())),
+                 extra..., InstrumentedCall());
+        },
+        m_extra);
+  }
+
+ private:
+  template <typename Class>
+  auto detaching() const {
+    if constexpr (DetachViews) {
+      static_assert(!std::is_member_function_pointer_v<F>,
+                    "compute() must be implemented by a function.");
+      using Signature =
+          typename instrumentation::detail::signature<Class, F>::type;
+      return detail::DetachingViews<Signature>::wrap(m_f);
+    } else {
+      return m_f;
+    }
+  }
+
+  const char *m_name;
+  F m_f;
+  std::tuple<Extra...> m_extra;
+};
+
+/// \returns the visitor defining the instrumented method \a name (see
+/// InstrumentedMethodVisitor).
+template <locks::Mode mode, typename F, typename... Extra>
+InstrumentedMethodVisitor<mode, false, F, Extra...> instrumentedMethod(
+    const char *name, F f, Extra... extra) {
+  return {name, std::move(f), std::move(extra)...};
+}
+
+/// \returns the visitor defining an overload of compute(), which takes the
+/// lock of the object exclusively, moves the factors viewed by NumPy arrays
+/// out of the object and returns the object itself.
+template <typename F, typename... Extra>
+InstrumentedMethodVisitor<locks::Mode::Exclusive, true, F, Extra...,
+                          nb::rv_policy>
+computeMethod(F f, Extra... extra) {
+  return {"compute", std::move(f), std::move(extra)...,
+          nb::rv_policy::reference};
+}
+
+/// \returns the visitor defining an overload of solve(), which takes the lock
+/// of the object shared, so that concurrent solves run in parallel.
+template <typename F, typename... Extra>
+auto solveMethod(F f, Extra... extra) {
+  return instrumentedMethod<locks::Mode::Shared>("solve", std::move(f),
+                                                 std::move(extra)...);
+}
+
+}  // namespace nanoeigenpy
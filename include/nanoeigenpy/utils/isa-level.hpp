@@ -0,0 +1,102 @@
+/// Copyright 2025 INRIA
+
+#pragma once
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#endif
+
+namespace nanoeigenpy {
+
+/// \brief x86-64 microarchitecture levels, as defined by the x86-64 psABI.
+/// Each level includes the previous one:
+/// - v2: SSE3, SSSE3, SSE4.1, SSE4.2, POPCNT,
+/// - v3: AVX, AVX2, FMA, BMI1, BMI2,
+/// - v4: AVX-512 F, BW, CD, DQ and VL.
+enum class IsaLevel { Unknown = 0, X86_64 = 1, V2 = 2, V3 = 3, V4 = 4 };
+
+/// \returns the name of \a level, e.g. "x86-64-v3", or "" for Unknown.
+inline const char *isaLevelName(IsaLevel level) {
+  switch (level) {
+    case IsaLevel::X86_64:
+      return "x86-64";
+    case IsaLevel::V2:
+      return "x86-64-v2";
+    case IsaLevel::V3:
+      return "x86-64-v3";
+    case IsaLevel::V4:
+      return "x86-64-v4";
+    default:
+      return "";
+  }
+}
+
+/// \returns the level targeted by the compiler for this translation unit.
+constexpr IsaLevel compiledIsaLevel() {
+#if defined(__AVX512F__) && defined(__AVX512BW__) && defined(__AVX512CD__) && \
+    defined(__AVX512DQ__) && defined(__AVX512VL__)
+  return IsaLevel::V4;
+#elif defined(__AVX2__) && defined(__FMA__) && defined(__BMI2__)
+  return IsaLevel::V3;
+#elif defined(__SSE4_2__) && defined(__POPCNT__)
+  return IsaLevel::V2;
+#elif defined(__x86_64__) || defined(_M_X64)
+#if defined(_MSC_VER) && defined(__AVX2__)
+  // MSVC defines neither __FMA__ nor __BMI2__, which /arch:AVX2 implies.
+  return IsaLevel::V3;
+#else
+  return IsaLevel::X86_64;
+#endif
+#else
+  return IsaLevel::Unknown;
+#endif
+}
+
+/// \returns the highest level supported by the CPU and the operating system,
+/// or Unknown on other architectures.
+inline IsaLevel cpuIsaLevel() {
+#if (defined(__GNUC__) || defined(__clang__)) && \
+    (defined(__x86_64__) || defined(__i386__))
+  __builtin_cpu_init();
+  if (!(__builtin_cpu_supports("ssse3") && __builtin_cpu_supports("sse4.2") &&
+        __builtin_cpu_supports("popcnt")))
+    return IsaLevel::X86_64;
+  if (!(__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma") &&
+        __builtin_cpu_supports("bmi") && __builtin_cpu_supports("bmi2")))
+    return IsaLevel::V2;
+  if (!(__builtin_cpu_supports("avx512f") &&
+        __builtin_cpu_supports("avx512bw") &&
+        __builtin_cpu_supports("avx512cd") &&
+        __builtin_cpu_supports("avx512dq") &&
+        __builtin_cpu_supports("avx512vl")))
+    return IsaLevel::V3;
+  return IsaLevel::V4;
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+  int regs[4];
+  __cpuid(regs, 0);
+  const int max_leaf = regs[0];
+  __cpuid(regs, 1);
+  const unsigned ecx1 = static_cast<unsigned>(regs[2]);
+  const bool v2 = (ecx1 & (1u << 9)) && (ecx1 & (1u << 19)) &&
+                  (ecx1 & (1u << 20)) && (ecx1 & (1u << 23));
+  if (!v2) return IsaLevel::X86_64;
+  // AVX requires the OS to save the YMM (and ZMM) registers.
+  const bool osxsave = (ecx1 & (1u << 27)) != 0;
+  const unsigned long long xcr0 = osxsave ? _xgetbv(0) : 0;
+  if (max_leaf < 7 || (xcr0 & 0x6) != 0x6) return IsaLevel::V2;
+  __cpuidex(regs, 7, 0);
+  const unsigned ebx7 = static_cast<unsigned>(regs[1]);
+  const bool v3 = (ecx1 & (1u << 12)) && (ecx1 & (1u << 28)) &&
+                  (ebx7 & (1u << 3)) && (ebx7 & (1u << 5)) &&
+                  (ebx7 & (1u << 8));
+  if (!v3) return IsaLevel::V2;
+  const bool v4 = (xcr0 & 0xe6) == 0xe6 && (ebx7 & (1u << 16)) &&
+                  (ebx7 & (1u << 17)) && (ebx7 & (1u << 28)) &&
+                  (ebx7 & (1u << 30)) && (ebx7 & (1u << 31));
+  return v4 ? IsaLevel::V4 : IsaLevel::V3;
+#else
+  return IsaLevel::Unknown;
+#endif
+}
+
+}  // namespace nanoeigenpy
@@ -0,0 +1,196 @@
+/// Copyright 2025 INRIA
+
+#pragma once
+
+#include "nanoeigenpy/fwd.hpp"
+#include "nanoeigenpy/utils/instrumentation.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace nanoeigenpy {
+namespace nb = nanobind;
+
+/// \brief Readers/writer locks of the bound decompositions and solvers.
+///
+/// The methods which modify an object (compute, factorize, the set*
+/// methods...) take its lock exclusively, and its solves take it shared: a
+/// compute waits for the solves in progress on the same object, while
+/// concurrent solves still run in parallel. The asynchronous tasks take the
+/// same locks on the thread pool.
+///
+/// The locks are indexed by the address of the C++ object, and only exist
+/// while they are held or waited for.
+namespace locks {
+
+enum class Mode { Shared, Exclusive };
+
+namespace detail {
+
+struct Entry {
+  std::shared_mutex mutex;
+  /// Number of threads holding or waiting for the lock.
+  std::size_t users = 0;
+};
+
+/// \brief Locks of the objects whose address falls in the same shard.
+class Shard {
+ public:
+  Entry *acquire(const void *object) {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    Entry *&entry = m_entries[object];
+    if (entry == nullptr) {
+      if (m_free.empty()) {
+        m_storage.push_back(std::make_unique<Entry>());
+        m_free.push_back(m_storage.back().get());
+      }
+      entry = m_free.back();
+      m_free.pop_back();
+    }
+    ++entry->users;
+    return entry;
+  }
+
+  void release(const void *object, Entry *entry) {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    if (--entry->users > 0) return;
+    m_entries.erase(object);
+    m_free.push_back(entry);
+  }
+
+ private:
+  std::mutex m_mutex;
+  std::unordered_map<const void *, Entry *> m_entries;
+  /// Entries of the locks no longer used, recycled for other objects.
+  std::vector<Entry *> m_free;
+  std::vector<std::unique_ptr<Entry>> m_storage;
+};
+
+inline Shard &shard(const void *object) {
+  constexpr std::size_t kShards = 64;
+  // Never destroyed, since the tasks of the thread pool may still use them.
+  static Shard *shards = new Shard[kShards];
+  const std::uintptr_t address = reinterpret_cast<std::uintptr_t>(object);
+  return shards[((address >> 4) ^ (address >> 12)) % kShards];
+}
+
+}  // namespace detail
+
+/// \brief Holds the lock of an object, shared or exclusively, until its
+/// destruction.
+template <Mode mode>
+class ObjectLock {
+ public:
+  /// \brief Blocks until the lock of \a object is acquired.
+  ///
+  /// If \a releaseGil is true, the GIL (or the thread state of a
+  /// free-threaded interpreter), which must be held, is released while
+  /// waiting, so that the holder of the lock can finish a call from Python.
+  explicit ObjectLock(const void *object, bool releaseGil = false)
+      : m_object(object),
+        m_entry(detail::shard(object).acquire(object)) {
+    if (tryLock()) return;
+    if (releaseGil) {
+      nb::gil_scoped_release release;
+      lock();
+    } else {
+      lock();
+    }
+  }
+
+  ~ObjectLock() {
+    if constexpr (mode == Mode::Exclusive)
+      m_entry->mutex.unlock();
+    else
+      m_entry->mutex.unlock_shared();
+    detail::shard(m_object).release(m_object, m_entry);
+  }
+
+  ObjectLock(const ObjectLock &) = delete;
+  ObjectLock &operator=(const ObjectLock &) = delete;
+
+ private:
+  bool tryLock() {
+    if constexpr (mode == Mode::Exclusive)
+      return m_entry->mutex.try_lock();
+    else
+      return m_entry->mutex.try_lock_shared();
+  }
+
+  void lock() {
+    if constexpr (mode == Mode::Exclusive)
+      m_entry->mutex.lock();
+    else
+      m_entry->mutex.lock_shared();
+  }
+
+  const void *m_object;
+  detail::Entry *m_entry;
+};
+
+using SharedLock = ObjectLock<Mode::Shared>;
+using ExclusiveLock = ObjectLock<Mode::Exclusive>;
+
+namespace detail {
+
+/// \brief Wraps a callable, whose first argument is the object, in a lambda
+/// with the same signature which holds the lock of the object during the
+/// call.
+template <Mode mode, typename Signature>
+struct Locked;
+
+template <Mode mode, typename Return, typename Self, typename... Args>
+struct Locked<mode, Return(Self, Args...)> {
+  static_assert(std::is_reference_v<Self>,
+                "The object must be passed by reference.");
+
+  template <typename F>
+  static auto wrap(F f) {
+    return [f](Self self, Args... args) -> Return {
+      ObjectLock<mode> lock(&self, true);
+      return f(std::forward<Self>(self), std::forward<Args>(args)...);
+    };
+  }
+};
+
+template <Mode mode, typename Class, typename F>
+auto locked(F f) {
+  using Signature =
+      typename instrumentation::detail::signature<Class, F>::type;
+  if constexpr (std::is_member_function_pointer_v<F>) {
+    return Locked<mode, Signature>::wrap(
+        [f](auto &self, auto &&...args) -> decltype(auto) {
+          return (self.*f)(std::forward<decltype(args)>(args)...);
+        });
+  } else {
+    return Locked<mode, Signature>::wrap(f);
+  }
+}
+
+}  // namespace detail
+
+}  // namespace locks
+
+/// \returns \a f, a function, lambda or member function of \a Class, which
+/// takes the lock of the object exclusively during its calls. For the
+/// methods which modify the object.
+template <typename Class, typename F>
+auto lockExclusive(F f) {
+  return locks::detail::locked<locks::Mode::Exclusive, Class>(f);
+}
+
+/// \returns \a f, a function, lambda or member function of \a Class, which
+/// takes the lock of the object shared during its calls. For the solves,
+/// which can run concurrently but not during a modification of the object.
+template <typename Class, typename F>
+auto lockShared(F f) {
+  return locks::detail::locked<locks::Mode::Shared, Class>(f);
+}
+
+}  // namespace nanoeigenpy
@@ -0,0 +1,297 @@
+/// Copyright 2025 INRIA
+
+#pragma once
+
+#include "nanoeigenpy/fwd.hpp"
+#include "nanoeigenpy/decompositions/sparse/orderings.hpp"
+#include "nanoeigenpy/utils/instrumented-method.hpp"
+#include <nanobind/eigen/dense.h>
+#include <nanobind/eigen/sparse.h>
+#include <nanobind/ndarray.h>
+#include <nanobind/stl/pair.h>
+#include <Eigen/SparseCore>
+
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace nanoeigenpy {
+namespace nb = nanobind;
+using namespace nb::literals;
+
+/// \brief Sparse matrix owned by C++ and shared with Python.
+///
+/// Passing a scipy.sparse matrix to a function taking an Eigen::SparseMatrix
+/// copies its three arrays at every call. A SparseMatrixHandle is converted
+/// once and then passed by reference to the sparse solvers. Its sparsity
+/// pattern is fixed, but its values can be updated in place through a NumPy
+/// view, e.g. before a new factorize().
+template <typename _MatrixType>
+class SparseMatrixHandle {
+ public:
+  using MatrixType = _MatrixType;
+  using Scalar = typename MatrixType::Scalar;
+  using StorageIndex = typename MatrixType::StorageIndex;
+
+  explicit SparseMatrixHandle(const MatrixType &matrix) : m_matrix(matrix) {
+    m_matrix.makeCompressed();
+  }
+
+  /// \brief Builds the matrix from compressed arrays (CSC for a column-major
+  /// MatrixType, CSR for a row-major one).
+  /// \throws std::invalid_argument if the arrays are inconsistent, or if the
+  /// indices of a column are out of range, unsorted or repeated.
+  SparseMatrixHandle(Eigen::Index rows, Eigen::Index cols,
+                     const Eigen::Ref<const Eigen::Matrix<Scalar, -1, 1>> &data,
+                     const Eigen::Ref<const Eigen::Matrix<StorageIndex, -1, 1>>
+                         &indices,
+                     const Eigen::Ref<const Eigen::Matrix<StorageIndex, -1, 1>>
+                         &indptr) {
+    const Eigen::Index outer = MatrixType::IsRowMajor ? rows : cols;
+    const Eigen::Index inner = MatrixType::IsRowMajor ? cols : rows;
+    if (rows < 0 || cols < 0 || indptr.size() != outer + 1)
+      throw std::invalid_argument(
+          "SparseMatrix: indptr must have one more entry than the number of "
+          "columns.");
+    if (data.size() != indices.size() || indptr(0) != 0 ||
+        indptr(outer) != data.size())
+      throw std::invalid_argument(
+          "SparseMatrix: data and indices must have indptr[-1] entries.");
+    for (Eigen::Index j = 0; j < outer; ++j)
+      if (indptr(j) > indptr(j + 1))
+        throw std::invalid_argument("SparseMatrix: indptr must be sorted.");
+    // Eigen's lookups and products assume sorted indices without duplicates.
+    for (Eigen::Index j = 0; j < outer; ++j) {
+      for (Eigen::Index k = indptr(j); k < indptr(j + 1); ++k) {
+        if (indices(k) < 0 || indices(k) >= inner)
+          throw std::invalid_argument("SparseMatrix: index out of range.");
+        if (k > indptr(j) && indices(k) <= indices(k - 1))
+          throw std::invalid_argument(
+              "SparseMatrix: the indices of each column must be sorted and "
+              "unique.");
+      }
+    }
+
+    m_matrix = Eigen::Map<const MatrixType>(
+        rows, cols, data.size(), indptr.data(), indices.data(), data.data());
+  }
+
+  MatrixType &matrix() { return m_matrix; }
+  const MatrixType &matrix() const { return m_matrix; }
+
+  Eigen::Index rows() const { return m_matrix.rows(); }
+  Eigen::Index cols() const { return m_matrix.cols(); }
+  Eigen::Index nonZeros() const { return m_matrix.nonZeros(); }
+
+ protected:
+  MatrixType m_matrix;
+};
+
+namespace detail {
+
+template <typename Solver, typename MatrixType, typename = void>
+struct has_compute : std::false_type {};
+template <typename Solver, typename MatrixType>
+struct has_compute<Solver, MatrixType,
+                   std::void_t<decltype(std::declval<Solver &>().compute(
+                       std::declval<const MatrixType &>()))>>
+    : std::true_type {};
+
+template <typename Solver, typename MatrixType, typename = void>
+struct has_analyze_pattern : std::false_type {};
+template <typename Solver, typename MatrixType>
+struct has_analyze_pattern<
+    Solver, MatrixType,
+    std::void_t<decltype(std::declval<Solver &>().analyzePattern(
+        std::declval<const MatrixType &>()))>> : std::true_type {};
+
+template <typename Solver, typename MatrixType, typename = void>
+struct has_factorize : std::false_type {};
+template <typename Solver, typename MatrixType>
+struct has_factorize<Solver, MatrixType,
+                     std::void_t<decltype(std::declval<Solver &>().factorize(
+                         std::declval<const MatrixType &>()))>>
+    : std::true_type {};
+
+}  // namespace detail
+
+/// \brief Adds the overloads of the constructor, compute(), analyzePattern()
+/// and factorize() taking a SparseMatrixHandle instead of a scipy matrix,
+/// for the methods that the solver provides, with the ordering argument of
+/// the solvers using a RuntimeOrdering. They are instrumented as the
+/// overloads taking a scipy matrix.
+template <typename _MatrixType>
+struct SparseMatrixHandleVisitor
+    : nb::def_visitor<SparseMatrixHandleVisitor<_MatrixType>> {
+  template <typename Solver, typename... Ts>
+  void execute(nb::class_<Solver, Ts...> &cl) {
+    using MatrixType = _MatrixType;
+    using Handle = SparseMatrixHandle<MatrixType>;
+
+    if constexpr (detail::has_runtime_ordering<Solver>::value) {
+      // Same signatures as the overloads taking a scipy matrix.
+      constexpr OrderingMethod defaultOrdering =
+          Solver::OrderingType::DefaultMethod;
+      cl.def(
+          "__init__",
+          [](Solver *self, const Handle &matrix, OrderingMethod ordering) {
+            new (self) Solver();
+            OrderingScope scope(ordering);
+            self->compute(matrix.matrix());
+          },
+          "matrix"_a, "ordering"_a = defaultOrdering);
+      cl.def(computeMethod(
+                [](Solver &self, const Handle &matrix,
+                   OrderingMethod ordering) -> Solver & {
+                  OrderingScope scope(ordering);
+                  self.compute(matrix.matrix());
+                  return self;
+                },
+                "matrix"_a, "ordering"_a = defaultOrdering))
+          .def(instrumentedMethod<locks::Mode::Exclusive>(
+              "analyzePattern",
+              [](Solver &self, const Handle &matrix, OrderingMethod ordering) {
+                OrderingScope scope(ordering);
+                self.analyzePattern(matrix.matrix());
+              },
+              "matrix"_a, "ordering"_a = defaultOrdering));
+    } else {
+      if constexpr (std::is_constructible_v<Solver, const MatrixType &>) {
+        cl.def(
+            "__init__",
+            [](Solver *self, const Handle &matrix) {
+              new (self) Solver(matrix.matrix());
+            },
+            "matrix"_a);
+      }
+      if constexpr (detail::has_compute<Solver, MatrixType>::value) {
+        cl.def(computeMethod(
+            [](Solver &self, const Handle &matrix) -> Solver & {
+              self.compute(matrix.matrix());
+              return self;
+            },
+            "matrix"_a));
+      }
+      if constexpr (detail::has_analyze_pattern<Solver, MatrixType>::value) {
+        cl.def(instrumentedMethod<locks::Mode::Exclusive>(
+            "analyzePattern",
+            [](Solver &self, const Handle &matrix) {
+              self.analyzePattern(matrix.matrix());
+            },
+            "matrix"_a));
+      }
+    }
+    if constexpr (detail::has_factorize<Solver, MatrixType>::value) {
+      cl.def(instrumentedMethod<locks::Mode::Exclusive>(
+          "factorize",
+          [](Solver &self, const Handle &matrix) {
+            self.factorize(matrix.matrix());
+          },
+          "matrix"_a));
+    }
+  }
+};
+
+template <typename _MatrixType>
+void exposeSparseMatrixHandle(nb::module_ m, const char *name) {
+  using MatrixType = _MatrixType;
+  using Handle = SparseMatrixHandle<MatrixType>;
+  using Scalar = typename MatrixType::Scalar;
+  using StorageIndex = typename MatrixType::StorageIndex;
+  using Vector = Eigen::Matrix<Scalar, Eigen::Dynamic, 1>;
+  using Matrix = Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>;
+  using IndexVector = Eigen::Matrix<StorageIndex, Eigen::Dynamic, 1>;
+  using ValuesArray = nb::ndarray<nb::numpy, Scalar, nb::ndim<1>>;
+  using IndexArray = nb::ndarray<nb::numpy, const StorageIndex, nb::ndim<1>>;
+
+  if (check_registration_alias<Handle>(m)) {
+    return;
+  }
+  nb::class_<Handle>(
+      m, name,
+      "Sparse matrix stored on the C++ side.\n\n"
+      "The sparse solvers accept a SparseMatrix wherever they accept a "
+      "scipy.sparse matrix. A scipy matrix is converted at every call, "
+      "whereas a SparseMatrix is converted once and then passed by "
+      "reference. Its sparsity pattern is fixed, but its nonzero values can "
+      "be updated in place through the writable values array.")
+
+      .def(nb::init<const MatrixType &>(), "matrix"_a,
+           "Copies a scipy.sparse matrix.")
+      .def(
+          "__init__",
+          [](Handle *self, const Eigen::Ref<const Vector> &data,
+             const Eigen::Ref<const IndexVector> &indices,
+             const Eigen::Ref<const IndexVector> &indptr,
+             const std::pair<Eigen::Index, Eigen::Index> &shape) {
+            new (self)
+                Handle(shape.first, shape.second, data, indices, indptr);
+          },
+          "data"_a, "indices"_a, "indptr"_a, "shape"_a,
+          "Builds the matrix from CSC arrays, as scipy.sparse.csc_matrix(("
+          "data, indices, indptr), shape). The row indices of each column "
+          "must be sorted and unique (see scipy's sum_duplicates()), a "
+          "ValueError is raised otherwise.")
+
+      .def("rows", &Handle::rows, "Returns the number of rows.")
+      .def("cols", &Handle::cols, "Returns the number of columns.")
+      .def("nonZeros", &Handle::nonZeros,
+           "Returns the number of stored nonzeros.")
+      .def_prop_ro("shape",
+                   [](const Handle &self) {
+                     return std::make_pair(self.rows(), self.cols());
+                   })
+
+      .def_prop_ro(
+          "values",
+          [](Handle &self) {
+            return ValuesArray(self.matrix().valuePtr(),
+                               {size_t(self.nonZeros())}, nb::handle());
+          },
+          nb::rv_policy::reference_internal,
+          "Writable view of the nonzero values, in the CSC order.")
+      .def_prop_ro(
+          "indices",
+          [](const Handle &self) {
+            return IndexArray(self.matrix().innerIndexPtr(),
+                              {size_t(self.nonZeros())}, nb::handle());
+          },
+          nb::rv_policy::reference_internal,
+          "Read-only view of the row indices.")
+      .def_prop_ro(
+          "indptr",
+          [](const Handle &self) {
+            return IndexArray(self.matrix().outerIndexPtr(),
+                              {size_t(self.matrix().outerSize() + 1)},
+                              nb::handle());
+          },
+          nb::rv_policy::reference_internal,
+          "Read-only view of the column pointers.")
+
+      .def(
+          "toScipy", [](const Handle &self) { return self.matrix(); },
+          "Returns a copy of the matrix as a scipy.sparse matrix.")
+
+      .def(
+          "__matmul__",
+          [](const Handle &self, const Eigen::Ref<const Vector> &x) -> Vector {
+            if (x.size() != self.cols())
+              throw std::invalid_argument(
+                  "SparseMatrix: dimension mismatch in matrix product.");
+            return self.matrix() * x;
+          },
+          "x"_a)
+      .def(
+          "__matmul__",
+          [](const Handle &self, const Eigen::Ref<const Matrix> &x) -> Matrix {
+            if (x.rows() != self.cols())
+              throw std::invalid_argument(
+                  "SparseMatrix: dimension mismatch in matrix product.");
+            return self.matrix() * x;
+          },
+          "X"_a)
+
+      .def(IdVisitor());
+}
+
+}  // namespace nanoeigenpy
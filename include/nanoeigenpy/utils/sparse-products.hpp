@@ -0,0 +1,149 @@
+/// Copyright 2025 INRIA
+
+#pragma once
+
+#include "nanoeigenpy/fwd.hpp"
+#include "nanoeigenpy/utils/sparse-matrix-handle.hpp"
+#include <nanobind/eigen/dense.h>
+#include <nanobind/eigen/sparse.h>
+#include <Eigen/SparseCore>
+
+#include <stdexcept>
+
+namespace nanoeigenpy {
+namespace nb = nanobind;
+using namespace nb::literals;
+
+/// \brief Computes y = alpha * A * x + beta * y.
+///
+/// With a row-major sparse matrix, Eigen splits the rows of A across the
+/// OpenMP threads (see Eigen::setNbThreads) once A has more than 20000
+/// nonzeros. With a row-major x, each thread accumulates whole rows of the
+/// result, which is the efficient layout for SpMM.
+///
+/// As in BLAS, y is not read when beta is zero.
+template <typename SparseType, typename RhsType, typename DestType>
+void sparseDenseProduct(const Eigen::SparseMatrixBase<SparseType> &a,
+                        const Eigen::MatrixBase<RhsType> &x,
+                        const Eigen::MatrixBase<DestType> &y,
+                        const typename DestType::Scalar &alpha,
+                        const typename DestType::Scalar &beta) {
+  using Scalar = typename DestType::Scalar;
+  DestType &dest = const_cast<DestType &>(y.derived());
+  if (a.cols() != x.rows() || a.rows() != dest.rows() ||
+      x.cols() != dest.cols())
+    throw std::invalid_argument(
+        "sparseDenseProduct: the dimensions of A, x and y do not match.");
+  if (static_cast<const void *>(x.derived().data()) ==
+      static_cast<const void *>(dest.data()))
+    throw std::invalid_argument(
+        "sparseDenseProduct: x and y must not overlap.");
+
+  if (beta == Scalar(0))
+    dest.setZero();
+  else if (beta != Scalar(1))
+    dest *= beta;
+  dest.noalias() += alpha * a.derived() * x.derived();
+}
+
+template <typename Scalar>
+void exposeSparseProducts(nb::module_ m) {
+  using SparseMatrix = Eigen::SparseMatrix<Scalar, Eigen::RowMajor>;
+  using Handle = SparseMatrixHandle<Eigen::SparseMatrix<Scalar>>;
+  using Vector = Eigen::Matrix<Scalar, Eigen::Dynamic, 1>;
+  using Matrix = Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic,
+                               Eigen::RowMajor>;
+
+  // A SparseMatrix handle is used in place, in its CSC format.
+  m.def(
+      "spmv",
+      [](const Handle &a, const Eigen::Ref<const Vector> &x,
+         const Scalar &alpha, const Scalar &beta, Eigen::Ref<Vector> out) {
+        sparseDenseProduct(a.matrix(), x, out, alpha, beta);
+      },
+      "A"_a, "x"_a, "alpha"_a = Scalar(1), "beta"_a = Scalar(0), nb::kw_only(),
+      "out"_a,
+      "Computes out = alpha * A @ x + beta * out in place, where A is a "
+      "SparseMatrix (CSC format), without copying it. The product runs on a "
+      "single thread.");
+  m.def(
+      "spmv",
+      [](const Handle &a, const Eigen::Ref<const Vector> &x,
+         const Scalar &alpha) -> Vector {
+        Vector y(a.rows());
+        sparseDenseProduct(a.matrix(), x, y, alpha, Scalar(0));
+        return y;
+      },
+      "A"_a, "x"_a, "alpha"_a = Scalar(1),
+      "Returns alpha * A @ x, where A is a SparseMatrix (CSC format).");
+  m.def(
+      "spmm",
+      [](const Handle &a, const Eigen::Ref<const Matrix> &x,
+         const Scalar &alpha, const Scalar &beta, Eigen::Ref<Matrix> out) {
+        sparseDenseProduct(a.matrix(), x, out, alpha, beta);
+      },
+      "A"_a, "X"_a, "alpha"_a = Scalar(1), "beta"_a = Scalar(0), nb::kw_only(),
+      "out"_a,
+      "Computes out = alpha * A @ X + beta * out in place, where A is a "
+      "SparseMatrix (CSC format), without copying it. The product runs on a "
+      "single thread.");
+  m.def(
+      "spmm",
+      [](const Handle &a, const Eigen::Ref<const Matrix> &x,
+         const Scalar &alpha) -> Matrix {
+        Matrix y(a.rows(), x.cols());
+        sparseDenseProduct(a.matrix(), x, y, alpha, Scalar(0));
+        return y;
+      },
+      "A"_a, "X"_a, "alpha"_a = Scalar(1),
+      "Returns alpha * A @ X, where A is a SparseMatrix (CSC format).");
+
+  m.def(
+      "spmv",
+      [](const SparseMatrix &a, const Eigen::Ref<const Vector> &x,
+         const Scalar &alpha, const Scalar &beta, Eigen::Ref<Vector> out) {
+        sparseDenseProduct(a, x, out, alpha, beta);
+      },
+      "A"_a, "x"_a, "alpha"_a = Scalar(1), "beta"_a = Scalar(0), nb::kw_only(),
+      "out"_a,
+      "Computes out = alpha * A @ x + beta * out in place, where A is a "
+      "sparse matrix in CSR format. out must be a contiguous writable array "
+      "and is not read when beta is zero.\n\n"
+      "The rows of A are split across the threads set by setNbThreads() when "
+      "the module is compiled with OpenMP.");
+  m.def(
+      "spmv",
+      [](const SparseMatrix &a, const Eigen::Ref<const Vector> &x,
+         const Scalar &alpha) -> Vector {
+        Vector y(a.rows());
+        sparseDenseProduct(a, x, y, alpha, Scalar(0));
+        return y;
+      },
+      "A"_a, "x"_a, "alpha"_a = Scalar(1),
+      "Returns alpha * A @ x, where A is a sparse matrix in CSR format.");
+
+  m.def(
+      "spmm",
+      [](const SparseMatrix &a, const Eigen::Ref<const Matrix> &x,
+         const Scalar &alpha, const Scalar &beta, Eigen::Ref<Matrix> out) {
+        sparseDenseProduct(a, x, out, alpha, beta);
+      },
+      "A"_a, "X"_a, "alpha"_a = Scalar(1), "beta"_a = Scalar(0), nb::kw_only(),
+      "out"_a,
+      "Computes out = alpha * A @ X + beta * out in place, where A is a "
+      "sparse matrix in CSR format. X and out are row-major (C-contiguous) "
+      "arrays, so that each thread computes whole rows of the result. out is "
+      "not read when beta is zero.");
+  m.def(
+      "spmm",
+      [](const SparseMatrix &a, const Eigen::Ref<const Matrix> &x,
+         const Scalar &alpha) -> Matrix {
+        Matrix y(a.rows(), x.cols());
+        sparseDenseProduct(a, x, y, alpha, Scalar(0));
+        return y;
+      },
+      "A"_a, "X"_a, "alpha"_a = Scalar(1),
+      "Returns alpha * A @ X, where A is a sparse matrix in CSR format.");
+}
+
+}  // namespace nanoeigenpy
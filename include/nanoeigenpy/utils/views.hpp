@@ -0,0 +1,252 @@
+/// Copyright 2025 INRIA
+
+#pragma once
+
+#include "nanoeigenpy/utils/object-lock.hpp"
+#include <nanobind/nanobind.h>
+#include <nanobind/ndarray.h>
+#include <Eigen/Core>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace nanoeigenpy {
+namespace nb = nanobind;
+
+/// \brief Read-only NumPy views of the factors stored by the decompositions.
+///
+/// The accessors of the factors return views of the storage of the
+/// decomposition rather than copies. The viewed factors are registered with
+/// the decomposition: while views of them are alive, compute() first moves
+/// their storage, in O(1), to the views, and computes the new factors in new
+/// storage. A view thus keeps the factor it was taken from, and never
+/// dangles. The in-place updates of a factor (e.g. rankUpdate) are seen by
+/// its views.
+///
+/// The registered factors are indexed by the address of the C++ object, and
+/// only exist while views of them are alive.
+namespace views {
+namespace detail {
+
+/// \brief Storage of the viewed factors of an object, shared by their views.
+class Exports {
+ public:
+  explicit Exports(const void *object) : m_object(object) {}
+  ~Exports();
+
+  Exports(const Exports &) = delete;
+  Exports &operator=(const Exports &) = delete;
+
+  /// \brief Registers \a factor, a member of the object, viewed by a new
+  /// view.
+  template <typename PlainObject>
+  void add(const PlainObject &factor) {
+    for (const Factor &f : m_factors)
+      if (f.address == &factor) return;
+    m_factors.push_back({&factor, &retire<PlainObject>});
+  }
+
+  /// \brief Moves the storage of the registered factors out of the object,
+  /// which is locked exclusively.
+  void detach() {
+    for (const Factor &f : m_factors) m_retired.push_back(f.retire(f.address));
+    m_factors.clear();
+  }
+
+ private:
+  struct Factor {
+    const void *address;
+    std::shared_ptr<void> (*retire)(const void *);
+  };
+
+  /// Swaps the factor with an empty matrix, which compute() resizes like
+  /// the factors of a new decomposition.
+  template <typename PlainObject>
+  static std::shared_ptr<void> retire(const void *address) {
+    auto storage = std::make_shared<PlainObject>();
+    storage->swap(*const_cast<PlainObject *>(
+        static_cast<const PlainObject *>(address)));
+    return storage;
+  }
+
+  const void *m_object;
+  std::vector<Factor> m_factors;
+  std::vector<std::shared_ptr<void>> m_retired;
+};
+
+class Registry {
+ public:
+  static Registry &instance() {
+    // Never destroyed, since the views may outlive the module.
+    static Registry *registry = new Registry();
+    return *registry;
+  }
+
+  /// \returns the storage shared by the views of the factors of \a object,
+  /// after registering \a factor.
+  template <typename PlainObject>
+  std::shared_ptr<Exports> add(const void *object,
+                               const PlainObject &factor) {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    std::weak_ptr<Exports> &entry = m_entries[object];
+    std::shared_ptr<Exports> exports = entry.lock();
+    if (exports == nullptr) {
+      exports = std::make_shared<Exports>(object);
+      entry = exports;
+      m_size.store(m_entries.size(), std::memory_order_relaxed);
+    }
+    exports->add(factor);
+    return exports;
+  }
+
+  /// \brief Moves the viewed factors of \a object to their views.
+  ///
+  /// \returns the storage of the views, if any, which must be released
+  /// after the registry.
+  std::shared_ptr<Exports> detach(const void *object) {
+    // The views of the object were registered before it was locked.
+    if (m_size.load(std::memory_order_relaxed) == 0) return nullptr;
+    std::lock_guard<std::mutex> guard(m_mutex);
+    auto it = m_entries.find(object);
+    if (it == m_entries.end()) return nullptr;
+    std::shared_ptr<Exports> exports = it->second.lock();
+    m_entries.erase(it);
+    m_size.store(m_entries.size(), std::memory_order_relaxed);
+    if (exports != nullptr) exports->detach();
+    return exports;
+  }
+
+  /// \brief Forgets \a object once its last view is destroyed, unless new
+  /// views were registered since its factors were detached.
+  void remove(const void *object) {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    auto it = m_entries.find(object);
+    if (it == m_entries.end() || !it->second.expired()) return;
+    m_entries.erase(it);
+    m_size.store(m_entries.size(), std::memory_order_relaxed);
+  }
+
+ private:
+  Registry() = default;
+
+  std::mutex m_mutex;
+  std::unordered_map<const void *, std::weak_ptr<Exports>> m_entries;
+  /// Number of entries, checked by detach() without the mutex.
+  std::atomic<std::size_t> m_size{0};
+};
+
+inline Exports::~Exports() { Registry::instance().remove(m_object); }
+
+/// \brief Owner of a view: the storage of the viewed factor, and the object,
+/// which holds the factor until it is detached.
+struct Owner {
+  std::shared_ptr<Exports> exports;
+  nb::object object;
+};
+
+/// \returns the matrix storing the coefficients of \a matrix, which is a
+/// plain matrix or a view of one (transpose, diagonal...).
+template <typename Derived>
+const auto &storageOf(const Eigen::DenseBase<Derived> &matrix) {
+  using PlainObject = typename Derived::PlainObject;
+  if constexpr (std::is_base_of_v<Eigen::PlainObjectBase<PlainObject>,
+                                  Derived>) {
+    return matrix.derived();
+  } else {
+    return storageOf(matrix.derived().nestedExpression());
+  }
+}
+
+}  // namespace detail
+
+/// \brief Moves the viewed factors of \a object out of it, before a
+/// computation which may resize them. \a object must be locked exclusively.
+inline void detachViews(const void *object) {
+  detail::Registry::instance().detach(object);
+}
+
+}  // namespace views
+
+/// \returns a read-only NumPy array viewing the coefficients of \p matrix, a
+/// factor stored by the object \p self or a view of it, which is registered
+/// with the object (see views). The shared lock of the object must be held.
+template <typename Class, typename Derived>
+nb::object readOnlyView(nb::pointer_and_handle<Class> self,
+                        const Eigen::DenseBase<Derived> &matrix) {
+  using Scalar = typename Derived::Scalar;
+  using Array = nb::ndarray<nb::numpy, const Scalar>;
+  using Owner = views::detail::Owner;
+  const Derived &m = matrix.derived();
+  nb::object owner = nb::capsule(
+      new Owner{views::detail::Registry::instance().add(
+                    self.p, views::detail::storageOf(m)),
+                nb::borrow(self.h)},
+      [](void *p) noexcept { delete static_cast<Owner *>(p); });
+  if constexpr (Derived::IsVectorAtCompileTime) {
+    const std::size_t shape[1] = {std::size_t(m.size())};
+    const std::int64_t strides[1] = {std::int64_t(m.innerStride())};
+    return nb::cast(Array(m.data(), 1, shape, owner, strides),
+                    nb::rv_policy::reference);
+  } else {
+    const std::size_t shape[2] = {std::size_t(m.rows()),
+                                  std::size_t(m.cols())};
+    const std::int64_t strides[2] = {std::int64_t(m.rowStride()),
+                                     std::int64_t(m.colStride())};
+    return nb::cast(Array(m.data(), 2, shape, owner, strides),
+                    nb::rv_policy::reference);
+  }
+}
+
+/// \returns a read-only view of the transpose of \p matrix, e.g. of the
+/// factor U = L^T of a Cholesky decomposition storing L.
+template <typename Class, typename Derived>
+nb::object readOnlyTransposeView(nb::pointer_and_handle<Class> self,
+                                 const Eigen::DenseBase<Derived> &matrix) {
+  if constexpr (Eigen::NumTraits<typename Derived::Scalar>::IsComplex) {
+    throw std::invalid_argument(
+        "The adjoint of a complex factor is not stored by the decomposition: "
+        "use copy=True.");
+  } else {
+    return readOnlyView(self, matrix.derived().transpose());
+  }
+}
+
+/// \returns a method of Class returning a read-only view of the result of
+/// the const member function \p f, which returns a factor stored by the
+/// object. \p f may be declared by a base of Class.
+template <typename Class, typename Base, typename Ret>
+auto readOnlyViewOf(Ret (Base::*f)() const) {
+  using Type = std::decay_t<Ret>;
+  static_assert(std::is_reference_v<Ret> ||
+                    !std::is_same_v<Type, typename Type::PlainObject>,
+                "The member function must not return a temporary matrix.");
+  return [f](nb::pointer_and_handle<Class> self) -> nb::object {
+    locks::SharedLock lock(self.p, true);
+    return readOnlyView(self, (self.p->*f)());
+  };
+}
+
+/// \returns a method of Class, taking a \c copy argument, which returns a
+/// read-only view of the result of the const member function \p f, or a copy
+/// of it if \c copy is true (see readOnlyViewOf).
+template <typename Class, typename Base, typename Ret>
+auto copyOrViewOf(Ret (Base::*f)() const) {
+  using Type = std::decay_t<Ret>;
+  using PlainObject = typename Type::PlainObject;
+  static_assert(std::is_reference_v<Ret> || !std::is_same_v<Type, PlainObject>,
+                "The member function must not return a temporary matrix.");
+  return [f](nb::pointer_and_handle<Class> self, bool copy) -> nb::object {
+    locks::SharedLock lock(self.p, true);
+    if (copy) return nb::cast(PlainObject((self.p->*f)()));
+    return readOnlyView(self, (self.p->*f)());
+  };
+}
+
+}  // namespace nanoeigenpy
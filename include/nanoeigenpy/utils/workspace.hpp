@@ -0,0 +1,351 @@
+/// Copyright 2025 INRIA
+
+#pragma once
+
+#include <nanobind/nanobind.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <functional>
+#include <limits>
+#include <new>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#ifdef NANOEIGENPY_WITH_WORKSPACES
+// The allocation functions bypassing the wrappers of src/allocation-hooks.cpp,
+// with which the module is linked when built with the workspaces.
+extern "C" void *__real_malloc(std::size_t size);
+extern "C" void __real_free(void *ptr);
+#endif
+
+namespace nanoeigenpy {
+namespace nb = nanobind;
+
+/// \returns whether the allocation functions of the module can serve the
+/// temporaries from the workspaces (the BUILD_WITH_WORKSPACES CMake option).
+constexpr bool workspacesAvailable() {
+#ifdef NANOEIGENPY_WITH_WORKSPACES
+  return true;
+#else
+  return false;
+#endif
+}
+
+#ifdef NANOEIGENPY_WITH_WORKSPACES
+
+namespace detail {
+
+/// \brief Allocator of the bookkeeping of the workspaces, which must not go
+/// through the wrapped allocation functions.
+template <typename T>
+struct RealAllocator {
+  using value_type = T;
+
+  RealAllocator() = default;
+  template <typename U>
+  RealAllocator(const RealAllocator<U> &) {}
+
+  T *allocate(std::size_t n) {
+    if (n > std::numeric_limits<std::size_t>::max() / sizeof(T))
+      throw std::bad_alloc();
+    void *ptr = __real_malloc(n * sizeof(T));
+    if (ptr == nullptr) throw std::bad_alloc();
+    return static_cast<T *>(ptr);
+  }
+
+  void deallocate(T *ptr, std::size_t) { __real_free(ptr); }
+
+  template <typename U>
+  bool operator==(const RealAllocator<U> &) const {
+    return true;
+  }
+  template <typename U>
+  bool operator!=(const RealAllocator<U> &) const {
+    return false;
+  }
+};
+
+}  // namespace detail
+
+/// \brief Cache of the heap blocks allocated by the kernels of one thread.
+///
+/// While a workspace is installed on a thread (see WorkspaceScope), the
+/// allocation functions of the module serve the requests from the blocks of
+/// the workspace freed earlier with the same size, and the blocks freed are
+/// kept in the workspace instead of being returned to the system. Repeated
+/// computations of the same size hence allocate nothing after the first one.
+///
+/// All the blocks are allocated with malloc: the blocks still in use when the
+/// workspace is uninstalled, e.g. the members of a decomposition resized by
+/// the computation, are given up by the workspace and freed normally later.
+/// The free blocks of the sizes least recently used are then freed, while
+/// the workspace keeps more than its limit.
+class Workspace {
+ public:
+  Workspace() = default;
+  Workspace(const Workspace &) = delete;
+  Workspace &operator=(const Workspace &) = delete;
+  ~Workspace() { release(); }
+
+  /// \returns a free block of the given size, or null if there is none.
+  void *take(std::size_t size) {
+    auto entry = m_sizes.find(size);
+    if (entry == m_sizes.end() || entry->second.head == npos) return nullptr;
+    SizeClass &sizeClass = entry->second;
+    Block &block = m_blocks[sizeClass.head];
+    sizeClass.head = block.next;
+    sizeClass.lastUse = m_uses;
+    block.used = true;
+    ++m_used;
+    return block.ptr;
+  }
+
+  /// \brief Keeps the block just allocated with malloc once it is freed.
+  void adopt(void *ptr, std::size_t size) {
+    try {
+      SizeClass &sizeClass = m_sizes[size];
+      m_index.emplace(ptr, m_blocks.size());
+      m_blocks.push_back(Block{ptr, size, npos, true});
+      sizeClass.bytes += size;
+      sizeClass.lastUse = m_uses;
+      ++m_used;
+      m_bytes += size;
+    } catch (const std::bad_alloc &) {
+      // The block is left to malloc.
+      m_index.erase(ptr);
+    }
+  }
+
+  /// \returns whether the block belongs to the workspace, and its size.
+  bool owns(void *ptr, std::size_t &size) const {
+    auto entry = m_index.find(ptr);
+    if (entry == m_index.end()) return false;
+    size = m_blocks[entry->second].size;
+    return true;
+  }
+
+  /// \brief Puts the block back in the workspace.
+  /// \returns false if the block does not belong to the workspace.
+  bool give(void *ptr) {
+    auto entry = m_index.find(ptr);
+    if (entry == m_index.end()) return false;
+    Block &block = m_blocks[entry->second];
+    std::size_t &head = m_sizes.find(block.size)->second.head;
+    block.next = head;
+    block.used = false;
+    head = entry->second;
+    --m_used;
+    return true;
+  }
+
+  /// \brief Gives up the blocks still in use, then frees the blocks of the
+  /// sizes least recently used until the workspace keeps at most \a limit
+  /// bytes. It does not allocate, so that uninstalling the workspace cannot
+  /// fail.
+  void close(std::size_t limit) {
+    ++m_uses;
+    if (m_used == 0 && m_bytes <= limit) return;
+    for (const Block &block : m_blocks) {
+      if (!block.used) continue;
+      m_sizes.find(block.size)->second.bytes -= block.size;
+      m_bytes -= block.size;
+    }
+    while (m_bytes > limit) {
+      // Evicts the size least recently used, among those with free blocks.
+      SizeClass *oldest = nullptr;
+      for (auto &entry : m_sizes)
+        if (entry.second.bytes > 0 &&
+            (oldest == nullptr || entry.second.lastUse < oldest->lastUse))
+          oldest = &entry.second;
+      m_bytes -= oldest->bytes;
+      oldest->bytes = 0;
+    }
+    for (auto &entry : m_sizes) entry.second.head = npos;
+    std::size_t kept = 0;
+    for (std::size_t k = 0; k < m_blocks.size(); ++k) {
+      Block block = m_blocks[k];
+      SizeClass &sizeClass = m_sizes.find(block.size)->second;
+      if (block.used || sizeClass.bytes == 0) {
+        m_index.erase(block.ptr);
+        if (!block.used) __real_free(block.ptr);
+        continue;
+      }
+      block.next = sizeClass.head;
+      sizeClass.head = kept;
+      m_index.find(block.ptr)->second = kept;
+      m_blocks[kept++] = block;
+    }
+    m_blocks.resize(kept);
+    for (auto entry = m_sizes.begin(); entry != m_sizes.end();) {
+      if (entry->second.bytes == 0)
+        entry = m_sizes.erase(entry);
+      else
+        ++entry;
+    }
+    m_used = 0;
+  }
+
+  /// \brief Frees the blocks of the workspace, which must not be installed.
+  void release() { close(0); }
+
+  /// \returns the size of the blocks kept by the workspace, in bytes.
+  std::size_t bytes() const { return m_bytes; }
+
+ private:
+  static constexpr std::size_t npos = std::size_t(-1);
+
+  struct Block {
+    void *ptr;
+    std::size_t size;
+    /// Next free block of the same size.
+    std::size_t next;
+    bool used;
+  };
+
+  /// \brief Blocks of the same size.
+  struct SizeClass {
+    /// First free block.
+    std::size_t head = npos;
+    /// Size of the blocks kept, in bytes.
+    std::size_t bytes = 0;
+    /// Value of m_uses when a block was last taken or adopted.
+    std::size_t lastUse = 0;
+  };
+
+  std::vector<Block, detail::RealAllocator<Block>> m_blocks;
+  std::unordered_map<
+      void *, std::size_t, std::hash<void *>, std::equal_to<void *>,
+      detail::RealAllocator<std::pair<void *const, std::size_t>>>
+      m_index;
+  std::unordered_map<
+      std::size_t, SizeClass, std::hash<std::size_t>,
+      std::equal_to<std::size_t>,
+      detail::RealAllocator<std::pair<const std::size_t, SizeClass>>>
+      m_sizes;
+  std::size_t m_used = 0;
+  std::size_t m_bytes = 0;
+  /// Number of times the workspace was uninstalled.
+  std::size_t m_uses = 0;
+};
+
+/// \returns the workspace installed on this thread, or null.
+inline Workspace *&currentWorkspace() {
+  static thread_local Workspace *workspace = nullptr;
+  return workspace;
+}
+
+/// \returns the workspace of this thread.
+inline Workspace &threadWorkspace() {
+  static thread_local Workspace workspace;
+  return workspace;
+}
+
+#endif  // NANOEIGENPY_WITH_WORKSPACES
+
+inline std::atomic<bool> &workspacesFlag() {
+  static std::atomic<bool> flag{false};
+  return flag;
+}
+
+inline bool workspacesEnabled() {
+  return workspacesFlag().load(std::memory_order_relaxed);
+}
+
+/// \returns the maximum size in bytes of the blocks kept by the workspace of
+/// each thread, 64 MiB by default.
+inline std::atomic<std::size_t> &workspaceLimit() {
+  static std::atomic<std::size_t> limit{std::size_t(64) << 20};
+  return limit;
+}
+
+/// \brief Installs the workspace of the thread for the lifetime of the scope,
+/// when the workspaces are enabled.
+///
+/// The bindings of the decompositions whose compute() allocates temporaries
+/// create a scope around the Eigen call. Nested scopes have no effect.
+class WorkspaceScope {
+ public:
+#ifdef NANOEIGENPY_WITH_WORKSPACES
+  WorkspaceScope() {
+    if (!workspacesEnabled() || currentWorkspace() != nullptr) return;
+    m_workspace = &threadWorkspace();
+    currentWorkspace() = m_workspace;
+  }
+
+  ~WorkspaceScope() {
+    if (m_workspace == nullptr) return;
+    currentWorkspace() = nullptr;
+    m_workspace->close(workspaceLimit().load(std::memory_order_relaxed));
+  }
+#else
+  WorkspaceScope() {}
+#endif
+
+  WorkspaceScope(const WorkspaceScope &) = delete;
+  WorkspaceScope &operator=(const WorkspaceScope &) = delete;
+
+#ifdef NANOEIGENPY_WITH_WORKSPACES
+ private:
+  Workspace *m_workspace = nullptr;
+#endif
+};
+
+inline void exposeWorkspaces(nb::module_ m) {
+  using namespace nb::literals;
+
+  m.def(
+      "setWorkspacesEnabled",
+      [](bool enabled) {
+        if (enabled && !workspacesAvailable())
+          throw std::runtime_error(
+              "nanoeigenpy was built without workspaces "
+              "(BUILD_WITH_WORKSPACES).");
+        workspacesFlag() = enabled;
+      },
+      "enabled"_a,
+      "Enables or disables the workspaces. When enabled, the temporaries of "
+      "the compute() methods of BDCSVD, ColPivHouseholderQR and RealSchur "
+      "are kept in a workspace of the calling thread and reused by the next "
+      "calls, so that repeated computations of the same size do not allocate "
+      "memory. They are disabled by default.");
+  m.def("workspacesAvailable", &workspacesAvailable,
+        "Returns whether the module was built with the workspaces.");
+  m.def("workspacesEnabled", &workspacesEnabled,
+        "Returns whether the workspaces are enabled.");
+  m.def(
+      "workspaceBytes",
+      []() -> std::size_t {
+#ifdef NANOEIGENPY_WITH_WORKSPACES
+        return threadWorkspace().bytes();
+#else
+        return 0;
+#endif
+      },
+      "Returns the size in bytes of the memory kept by the workspace of the "
+      "calling thread.");
+  m.def(
+      "setWorkspaceLimit", [](std::size_t bytes) { workspaceLimit() = bytes; },
+      "bytes"_a,
+      "Sets the maximum size in bytes of the memory kept by the workspace of "
+      "each thread, 64 MiB by default. At the end of a computation, the "
+      "memory of the sizes of temporaries least recently used is freed until "
+      "the workspace is within the limit.");
+  m.def(
+      "workspaceLimit", []() -> std::size_t { return workspaceLimit(); },
+      "Returns the maximum size in bytes of the memory kept by the workspace "
+      "of each thread.");
+  m.def(
+      "releaseWorkspace",
+      []() {
+#ifdef NANOEIGENPY_WITH_WORKSPACES
+        threadWorkspace().release();
+#endif
+      },
+      "Frees the memory kept by the workspace of the calling thread.");
+}
+
+}  // namespace nanoeigenpy
@@ -0,0 +1,182 @@
+/// Copyright 2025 INRIA
+///
+/// Allocation functions of the module, counting the heap allocations of the
+/// instrumented kernels (see instrumentation::KernelScope) and serving the
+/// temporaries of the decompositions from the workspaces (see Workspace).
+///
+/// With the BUILD_WITH_ALLOCATION_TRACKING or BUILD_WITH_WORKSPACES CMake
+/// options, the module is linked with --wrap for the C allocation functions
+/// and the global operator new/delete, so that the calls made by the code of
+/// the module, including Eigen's aligned allocator, go through these
+/// functions. The allocations of the other libraries, e.g. of Python, are not
+/// affected. The sizes are the usable sizes reported by glibc, which also
+/// accounts for the memory freed.
+
+#if defined(NANOEIGENPY_WITH_ALLOCATION_TRACKING) || \
+    defined(NANOEIGENPY_WITH_WORKSPACES)
+
+#include "nanoeigenpy/utils/instrumentation.hpp"
+#include "nanoeigenpy/utils/workspace.hpp"
+
+#include <malloc.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+
+using nanoeigenpy::instrumentation::AllocationCounters;
+using nanoeigenpy::instrumentation::currentAllocations;
+
+extern "C" {
+
+void *__real_malloc(std::size_t size);
+void *__real_calloc(std::size_t count, std::size_t size);
+void *__real_realloc(void *ptr, std::size_t size);
+void __real_free(void *ptr);
+int __real_posix_memalign(void **ptr, std::size_t alignment, std::size_t size);
+void *__real_aligned_alloc(std::size_t alignment, std::size_t size);
+// operator new(std::size_t), operator new[](std::size_t)
+void *__real__Znwm(std::size_t size);
+void *__real__Znam(std::size_t size);
+// operator delete(void*), operator delete[](void*), and their sized variants
+void __real__ZdlPv(void *ptr);
+void __real__ZdaPv(void *ptr);
+void __real__ZdlPvm(void *ptr, std::size_t size);
+void __real__ZdaPvm(void *ptr, std::size_t size);
+
+}  // extern "C"
+
+namespace {
+
+inline void *counted(void *ptr) {
+  if (ptr != nullptr)
+    if (AllocationCounters *counters = currentAllocations())
+      counters->allocate(malloc_usable_size(ptr));
+  return ptr;
+}
+
+inline void uncount(void *ptr) {
+  if (ptr != nullptr)
+    if (AllocationCounters *counters = currentAllocations())
+      counters->deallocate(malloc_usable_size(ptr));
+}
+
+#ifdef NANOEIGENPY_WITH_WORKSPACES
+using nanoeigenpy::currentWorkspace;
+using nanoeigenpy::Workspace;
+
+/// malloc, from the installed workspace.
+void *allocate(Workspace &workspace, std::size_t size) {
+  if (void *ptr = workspace.take(size)) return ptr;
+  void *ptr = counted(__real_malloc(size));
+  if (ptr != nullptr) workspace.adopt(ptr, size);
+  return ptr;
+}
+#endif
+
+}  // namespace
+
+extern "C" {
+
+void *__wrap_malloc(std::size_t size) {
+#ifdef NANOEIGENPY_WITH_WORKSPACES
+  if (Workspace *workspace = currentWorkspace())
+    return allocate(*workspace, size);
+#endif
+  return counted(__real_malloc(size));
+}
+
+void *__wrap_calloc(std::size_t count, std::size_t size) {
+#ifdef NANOEIGENPY_WITH_WORKSPACES
+  if (Workspace *workspace = currentWorkspace()) {
+    if (size != 0 && count > std::size_t(-1) / size) {
+      errno = ENOMEM;
+      return nullptr;
+    }
+    void *ptr = allocate(*workspace, count * size);
+    if (ptr != nullptr) std::memset(ptr, 0, count * size);
+    return ptr;
+  }
+#endif
+  return counted(__real_calloc(count, size));
+}
+
+void *__wrap_realloc(void *ptr, std::size_t size) {
+#ifdef NANOEIGENPY_WITH_WORKSPACES
+  if (Workspace *workspace = currentWorkspace()) {
+    std::size_t previous;
+    if (ptr == nullptr) return allocate(*workspace, size);
+    if (workspace->owns(ptr, previous)) {
+      if (size == 0) {
+        workspace->give(ptr);
+        return nullptr;
+      }
+      void *result = allocate(*workspace, size);
+      if (result == nullptr) return nullptr;
+      std::memcpy(result, ptr, std::min(previous, size));
+      workspace->give(ptr);
+      return result;
+    }
+  }
+#endif
+  AllocationCounters *counters = currentAllocations();
+  const std::size_t previous =
+      counters != nullptr && ptr != nullptr ? malloc_usable_size(ptr) : 0;
+  void *result = __real_realloc(ptr, size);
+  // On failure, ptr is still allocated.
+  if (counters != nullptr && (result != nullptr || size == 0)) {
+    counters->deallocate(previous);
+    if (result != nullptr) counters->allocate(malloc_usable_size(result));
+  }
+  return result;
+}
+
+void __wrap_free(void *ptr) {
+#ifdef NANOEIGENPY_WITH_WORKSPACES
+  if (ptr != nullptr)
+    if (Workspace *workspace = currentWorkspace())
+      if (workspace->give(ptr)) return;
+#endif
+  uncount(ptr);
+  __real_free(ptr);
+}
+
+int __wrap_posix_memalign(void **ptr, std::size_t alignment,
+                          std::size_t size) {
+  const int result = __real_posix_memalign(ptr, alignment, size);
+  if (result == 0) counted(*ptr);
+  return result;
+}
+
+void *__wrap_aligned_alloc(std::size_t alignment, std::size_t size) {
+  return counted(__real_aligned_alloc(alignment, size));
+}
+
+void *__wrap__Znwm(std::size_t size) { return counted(__real__Znwm(size)); }
+
+void *__wrap__Znam(std::size_t size) { return counted(__real__Znam(size)); }
+
+void __wrap__ZdlPv(void *ptr) {
+  uncount(ptr);
+  __real__ZdlPv(ptr);
+}
+
+void __wrap__ZdaPv(void *ptr) {
+  uncount(ptr);
+  __real__ZdaPv(ptr);
+}
+
+void __wrap__ZdlPvm(void *ptr, std::size_t size) {
+  uncount(ptr);
+  __real__ZdlPvm(ptr, size);
+}
+
+void __wrap__ZdaPvm(void *ptr, std::size_t size) {
+  uncount(ptr);
+  __real__ZdaPvm(ptr, size);
+}
+
+}  // extern "C"
+
+#endif  // NANOEIGENPY_WITH_ALLOCATION_TRACKING || NANOEIGENPY_WITH_WORKSPACES
@@ -0,0 +1,139 @@
+/// Copyright 2025 INRIA
+
+#include "nanoeigenpy/decompositions/llt.hpp"
+#include "nanoeigenpy/decompositions/ldlt.hpp"
+#include "nanoeigenpy/decompositions/householder-qr.hpp"
+#include "nanoeigenpy/decompositions/full-piv-householder-qr.hpp"
+#include "nanoeigenpy/decompositions/col-piv-householder-qr.hpp"
+#include "nanoeigenpy/decompositions/complete-orthogonal-decomposition.hpp"
+#include "nanoeigenpy/decompositions/eigen-solver.hpp"
+#include "nanoeigenpy/decompositions/self-adjoint-eigen-solver.hpp"
+#include "nanoeigenpy/decompositions/generalized-self-adjoint-eigen-solver.hpp"
+#include "nanoeigenpy/decompositions/complex-eigen-solver.hpp"
+#include "nanoeigenpy/decompositions/complex-schur.hpp"
+#include "nanoeigenpy/decompositions/generalized-eigen-solver.hpp"
+#include "nanoeigenpy/decompositions/hessenberg-decomposition.hpp"
+#include "nanoeigenpy/decompositions/real-qz.hpp"
+#include "nanoeigenpy/decompositions/real-schur.hpp"
+#include "nanoeigenpy/decompositions/tridiagonalization.hpp"
+#include "nanoeigenpy/decompositions/permutation-matrix.hpp"
+#include "nanoeigenpy/decompositions/full-piv-lu.hpp"
+#include "nanoeigenpy/decompositions/partial-piv-lu.hpp"
+#include "nanoeigenpy/decompositions/mixed-precision.hpp"
+#include "nanoeigenpy/decompositions/bdcsvd.hpp"
+#include "nanoeigenpy/decompositions/jacobi-svd.hpp"
+#include "nanoeigenpy/decompositions/randomized-svd.hpp"
+
+#include "./internal.h"
+
+using namespace nanoeigenpy;
+
+using Eigen::ColPivHouseholderQRPreconditioner;
+using Eigen::FullPivHouseholderQRPreconditioner;
+using Eigen::HouseholderQRPreconditioner;
+using Eigen::JacobiSVD;
+using Eigen::NoQRPreconditioner;
+
+using ColPivHhJacobiSVD = JacobiSVD<Matrix, ColPivHouseholderQRPreconditioner>;
+using FullPivHhJacobiSVD =
+    JacobiSVD<Matrix, FullPivHouseholderQRPreconditioner>;
+using HhJacobiSVD = JacobiSVD<Matrix, HouseholderQRPreconditioner>;
+using NoPrecondJacobiSVD = JacobiSVD<Matrix, NoQRPreconditioner>;
+
+NB_MAKE_OPAQUE(ColPivHhJacobiSVD)
+NB_MAKE_OPAQUE(FullPivHhJacobiSVD)
+NB_MAKE_OPAQUE(HhJacobiSVD)
+NB_MAKE_OPAQUE(NoPrecondJacobiSVD)
+
+NB_MAKE_OPAQUE(Eigen::LLT<Eigen::MatrixXd>)
+NB_MAKE_OPAQUE(Eigen::LDLT<Eigen::MatrixXd>)
+NB_MAKE_OPAQUE(Eigen::FullPivLU<Eigen::MatrixXd>)
+NB_MAKE_OPAQUE(Eigen::PartialPivLU<Eigen::MatrixXd>)
+NB_MAKE_OPAQUE(Eigen::ColPivHouseholderQR<Eigen::MatrixXd>)
+NB_MAKE_OPAQUE(Eigen::CompleteOrthogonalDecomposition<Eigen::MatrixXd>)
+NB_MAKE_OPAQUE(Eigen::FullPivHouseholderQR<Eigen::MatrixXd>)
+NB_MAKE_OPAQUE(Eigen::HouseholderQR<Eigen::MatrixXd>)
+NB_MAKE_OPAQUE(Eigen::BDCSVD<Eigen::MatrixXd>)
+NB_MAKE_OPAQUE(Eigen::ComplexEigenSolver<Eigen::MatrixXd>)
+NB_MAKE_OPAQUE(Eigen::ComplexSchur<Eigen::MatrixXd>)
+NB_MAKE_OPAQUE(Eigen::EigenSolver<Eigen::MatrixXd>)
+NB_MAKE_OPAQUE(Eigen::GeneralizedEigenSolver<Eigen::MatrixXd>)
+NB_MAKE_OPAQUE(Eigen::GeneralizedSelfAdjointEigenSolver<Eigen::MatrixXd>)
+NB_MAKE_OPAQUE(Eigen::HessenbergDecomposition<Eigen::MatrixXd>)
+NB_MAKE_OPAQUE(Eigen::RealQZ<Eigen::MatrixXd>)
+NB_MAKE_OPAQUE(Eigen::RealSchur<Eigen::MatrixXd>)
+NB_MAKE_OPAQUE(Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd>)
+NB_MAKE_OPAQUE(Eigen::Tridiagonalization<Eigen::MatrixXd>)
+
+namespace {
+
+void exposeDense(nb::module_ m) {
+  // <Eigen/Cholesky>
+  exposeLDLT<Matrix>(m, "LDLT");
+  exposeLLT<Matrix>(m, "LLT");
+  // <Eigen/LU>
+  exposeFullPivLU<Matrix>(m, "FullPivLU");
+  exposePartialPivLU<Matrix>(m, "PartialPivLU");
+  // Mixed precision
+  exposeMixedPrecisionLLT<Matrix>(m, "MixedPrecisionLLT");
+  exposeMixedPrecisionPartialPivLU<Matrix>(m, "MixedPrecisionPartialPivLU");
+  // <Eigen/QR>
+  exposeColPivHouseholderQR<Matrix>(m, "ColPivHouseholderQR");
+  exposeCompleteOrthogonalDecomposition<Matrix>(
+      m, "CompleteOrthogonalDecomposition");
+  exposeFullPivHouseholderQR<Matrix>(m, "FullPivHouseholderQR");
+  exposeHouseholderQR<Matrix>(m, "HouseholderQR");
+  // <Eigen/SVD>
+  exposeBDCSVD<Matrix>(m, "BDCSVD");
+  exposeJacobiSVD<ColPivHhJacobiSVD>(m, "ColPivHhJacobiSVD");
+  exposeJacobiSVD<FullPivHhJacobiSVD>(m, "FullPivHhJacobiSVD");
+  exposeJacobiSVD<HhJacobiSVD>(m, "HhJacobiSVD");
+  exposeJacobiSVD<NoPrecondJacobiSVD>(m, "NoPrecondJacobiSVD");
+  exposeRandomizedSVD<Matrix>(m, "RandomizedSVD");
+  // <Eigen/Eigenvalues>
+  exposeComplexEigenSolver<Matrix>(m, "ComplexEigenSolver");
+  exposeComplexSchur<Matrix>(m, "ComplexSchur");
+  exposeEigenSolver<Matrix>(m, "EigenSolver");
+  exposeGeneralizedEigenSolver<Matrix>(m, "GeneralizedEigenSolver");
+  exposeGeneralizedSelfAdjointEigenSolver<Matrix>(
+      m, "GeneralizedSelfAdjointEigenSolver");
+  exposeHessenbergDecomposition<Matrix>(m, "HessenbergDecomposition");
+  exposeRealQZ<Matrix>(m, "RealQZ");
+  exposeRealSchur<Matrix>(m, "RealSchur");
+  exposeSelfAdjointEigenSolver<Matrix>(m, "SelfAdjointEigenSolver");
+  exposeTridiagonalization<Matrix>(m, "Tridiagonalization");
+}
+
+}  // namespace
+
+LazyBindings denseBindings() {
+  return {exposeDense,
+          {
+              "LDLT",
+              "LLT",
+              "FullPivLU",
+              "PartialPivLU",
+              "MixedPrecisionLLT",
+              "MixedPrecisionPartialPivLU",
+              "ColPivHouseholderQR",
+              "CompleteOrthogonalDecomposition",
+              "FullPivHouseholderQR",
+              "HouseholderQR",
+              "BDCSVD",
+              "ColPivHhJacobiSVD",
+              "FullPivHhJacobiSVD",
+              "HhJacobiSVD",
+              "NoPrecondJacobiSVD",
+              "RandomizedSVD",
+              "ComplexEigenSolver",
+              "ComplexSchur",
+              "EigenSolver",
+              "GeneralizedEigenSolver",
+              "GeneralizedSelfAdjointEigenSolver",
+              "HessenbergDecomposition",
+              "RealQZ",
+              "RealSchur",
+              "SelfAdjointEigenSolver",
+              "Tridiagonalization",
+          }};
+}
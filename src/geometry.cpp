@@ -0,0 +1,48 @@
+/// Copyright 2025 INRIA
+
+#include "nanoeigenpy/geometry.hpp"
+
+#include "./internal.h"
+
+using namespace nanoeigenpy;
+
+namespace {
+
+void exposeGeometry(nb::module_ m) {
+  // <Eigen/Geometry>
+  exposeQuaternion<Scalar>(m, "Quaternion");
+  exposeAngleAxis<Scalar>(m, "AngleAxis");
+  exposeHyperplane<Scalar>(m, "Hyperplane");
+  exposeParametrizedLine<Scalar>(m, "ParametrizedLine");
+  exposeRotation2D<Scalar>(m, "Rotation2D");
+  exposeUniformScaling<Scalar>(m, "UniformScaling");
+  exposeTranslation<Scalar>(m, "Translation");
+  exposeRotationConversions<Scalar>(m);
+
+  // <Eigen/Jacobi>
+  exposeJacobiRotation<Scalar>(m, "JacobiRotation");
+}
+
+}  // namespace
+
+LazyBindings geometryBindings() {
+  return {exposeGeometry,
+          {
+              "Quaternion",
+              "AngleAxis",
+              "Hyperplane",
+              "ParametrizedLine",
+              "Rotation2D",
+              "UniformScaling",
+              "Translation",
+              "matricesToQuaternions",
+              "quaternionsToMatrices",
+              "matricesToAngleAxis",
+              "angleAxisToMatrices",
+              "quaternionsToAngleAxis",
+              "angleAxisToQuaternions",
+              "matricesToEulerAngles",
+              "eulerAnglesToMatrices",
+              "JacobiRotation",
+          }};
+}
@@ -1,5 +1,10 @@
+#pragma once
+
 #include <nanobind/nanobind.h>
 #include <Eigen/Core>
+#include <Eigen/SparseCore>
+
+#include <vector>
 
 namespace nb = nanobind;
 
@@ -7,3 +12,22 @@ using Scalar = double;
 static constexpr int Options = Eigen::ColMajor;
 using Matrix = Eigen::Matrix<Scalar, -1, -1, Options>;
 using Vector = Eigen::Matrix<Scalar, -1, 1>;
+using SparseMatrix = Eigen::SparseMatrix<Scalar, Options>;
+
+/// \brief Group of bindings, compiled in its own translation unit, which is
+/// only registered in the module on the first access to one of its names.
+struct LazyBindings {
+  /// Registers the bindings in \a m.
+  void (*expose)(nb::module_ m);
+  /// Names of the attributes added to \a m by expose.
+  std::vector<const char *> names;
+};
+
+// Decompositions of dense matrices (src/dense.cpp)
+LazyBindings denseBindings();
+// Sparse direct solvers and eigensolvers (src/sparse.cpp)
+LazyBindings sparseBindings();
+// <Eigen/Geometry> and <Eigen/Jacobi> (src/geometry.cpp)
+LazyBindings geometryBindings();
+// Iterative solvers of the solvers submodule (src/solvers.cpp)
+LazyBindings solversBindings();
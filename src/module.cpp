@@ -2,72 +2,28 @@
 
 #include <nanobind/stl/string.h>
 
-#include "nanoeigenpy/decompositions.hpp"
-#include "nanoeigenpy/geometry.hpp"
-#include "nanoeigenpy/solvers.hpp"
+#include "nanoeigenpy/decompositions/permutation-matrix.hpp"
 #include "nanoeigenpy/constants.hpp"
 #include "nanoeigenpy/utils/is-approx.hpp"
+#include "nanoeigenpy/utils/sparse-matrix-handle.hpp"
+#include "nanoeigenpy/utils/sparse-products.hpp"
+#include "nanoeigenpy/utils/async.hpp"
+#include "nanoeigenpy/utils/instrumentation.hpp"
+#include "nanoeigenpy/utils/workspace.hpp"
+#include "nanoeigenpy/utils/isa-level.hpp"
 
 #include "./internal.h"
 
-using namespace nanoeigenpy;
+#include <algorithm>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <thread>
 
-// Matrix types
-using SparseMatrix = Eigen::SparseMatrix<Scalar, Options>;
-
-using Eigen::ColPivHouseholderQRPreconditioner;
-using Eigen::FullPivHouseholderQRPreconditioner;
-using Eigen::HouseholderQRPreconditioner;
-using Eigen::JacobiSVD;
-using Eigen::NoQRPreconditioner;
-
-using ColPivHhJacobiSVD = JacobiSVD<Matrix, ColPivHouseholderQRPreconditioner>;
-using FullPivHhJacobiSVD =
-    JacobiSVD<Matrix, FullPivHouseholderQRPreconditioner>;
-using HhJacobiSVD = JacobiSVD<Matrix, HouseholderQRPreconditioner>;
-using NoPrecondJacobiSVD = JacobiSVD<Matrix, NoQRPreconditioner>;
-
-using SparseQR = Eigen::SparseQR<SparseMatrix, Eigen::COLAMDOrdering<int>>;
-using SparseLU = Eigen::SparseLU<SparseMatrix>;
-using SCMatrix = typename SparseLU::SCMatrix;
-using StorageIndex = typename Matrix::StorageIndex;
-#if EIGEN_VERSION_AT_LEAST(5, 0, 0)
-using MappedSparseMatrix =
-    Eigen::Map<Eigen::SparseMatrix<Scalar, Options, StorageIndex>>;
-#else
-using MappedSparseMatrix =
-    Eigen::MappedSparseMatrix<Scalar, Options, StorageIndex>;
-#endif
-
-NB_MAKE_OPAQUE(ColPivHhJacobiSVD)
-NB_MAKE_OPAQUE(FullPivHhJacobiSVD)
-NB_MAKE_OPAQUE(HhJacobiSVD)
-NB_MAKE_OPAQUE(NoPrecondJacobiSVD)
-
-NB_MAKE_OPAQUE(Eigen::SparseQRMatrixQReturnType<SparseQR>)
-NB_MAKE_OPAQUE(Eigen::SparseQRMatrixQTransposeReturnType<SparseQR>)
-NB_MAKE_OPAQUE(Eigen::SparseLUMatrixLReturnType<SCMatrix>)
-NB_MAKE_OPAQUE(Eigen::SparseLUMatrixUReturnType<SCMatrix, MappedSparseMatrix>)
-
-NB_MAKE_OPAQUE(Eigen::LLT<Eigen::MatrixXd>)
-NB_MAKE_OPAQUE(Eigen::LDLT<Eigen::MatrixXd>)
-NB_MAKE_OPAQUE(Eigen::FullPivLU<Eigen::MatrixXd>)
-NB_MAKE_OPAQUE(Eigen::PartialPivLU<Eigen::MatrixXd>)
-NB_MAKE_OPAQUE(Eigen::ColPivHouseholderQR<Eigen::MatrixXd>)
-NB_MAKE_OPAQUE(Eigen::CompleteOrthogonalDecomposition<Eigen::MatrixXd>)
-NB_MAKE_OPAQUE(Eigen::FullPivHouseholderQR<Eigen::MatrixXd>)
-NB_MAKE_OPAQUE(Eigen::HouseholderQR<Eigen::MatrixXd>)
-NB_MAKE_OPAQUE(Eigen::BDCSVD<Eigen::MatrixXd>)
-NB_MAKE_OPAQUE(Eigen::ComplexEigenSolver<Eigen::MatrixXd>)
-NB_MAKE_OPAQUE(Eigen::ComplexSchur<Eigen::MatrixXd>)
-NB_MAKE_OPAQUE(Eigen::EigenSolver<Eigen::MatrixXd>)
-NB_MAKE_OPAQUE(Eigen::GeneralizedEigenSolver<Eigen::MatrixXd>)
-NB_MAKE_OPAQUE(Eigen::GeneralizedSelfAdjointEigenSolver<Eigen::MatrixXd>)
-NB_MAKE_OPAQUE(Eigen::HessenbergDecomposition<Eigen::MatrixXd>)
-NB_MAKE_OPAQUE(Eigen::RealQZ<Eigen::MatrixXd>)
-NB_MAKE_OPAQUE(Eigen::RealSchur<Eigen::MatrixXd>)
-NB_MAKE_OPAQUE(Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd>)
-NB_MAKE_OPAQUE(Eigen::Tridiagonalization<Eigen::MatrixXd>)
+using namespace nanoeigenpy;
 
 // Utils
 std::string printEigenVersion(const char* delim = ".") {
@@ -77,129 +33,253 @@ std::string printEigenVersion(const char* delim = ".") {
   return oss.str();
 }
 
-// Module
-NB_MODULE(nanoeigenpy, m) {
-  // <Eigen/Core>
-  exposeConstants(m);
-  exposePermutationMatrix<Eigen::Dynamic>(m, "PermutationMatrix");
+std::string printEigenBackend() {
+#if defined(EIGEN_USE_MKL_ALL)
+  return "MKL";
+#elif defined(EIGEN_USE_BLAS) && defined(EIGEN_USE_LAPACKE)
+  return "BLAS/LAPACKE";
+#elif defined(EIGEN_USE_BLAS)
+  return "BLAS";
+#elif defined(EIGEN_USE_LAPACKE)
+  return "LAPACKE";
+#else
+  return "Eigen";
+#endif
+}
+
+/// \brief nanoeigenpy.Future, whose creation imports concurrent.futures.
+LazyBindings asyncBindings() {
+  return {[](nb::module_ m) { exposeAsync(m); }, {"Future"}};
+}
+
+/// \returns false if the NANOEIGENPY_LAZY_BINDINGS environment variable is
+/// "0", to register all the bindings when the module is imported.
+bool lazyBindingsEnabled() {
+  const char* value = std::getenv("NANOEIGENPY_LAZY_BINDINGS");
+  return value == nullptr || std::strcmp(value, "0") != 0;
+}
+
+namespace {
+
+/// \brief Registration state of the groups of bindings of a module.
+///
+/// The groups are registered without holding the mutex, since a
+/// registration can access the module, and thus its __getattr__, again. The
+/// mutex is never held while waiting for the GIL.
+struct LazyModule {
+  enum class Status { Pending, Loading, Loaded };
+
+  std::vector<LazyBindings> groups;
+  std::vector<Status> status;
+  /// Thread registering each group while it is Loading.
+  std::vector<std::thread::id> loaders;
+  std::mutex mutex;
+  std::condition_variable loaded;
 
-  // <Eigen/Cholesky>
-  exposeLDLT<Matrix>(m, "LDLT");
-  exposeLLT<Matrix>(m, "LLT");
-  // <Eigen/LU>
-  exposeFullPivLU<Matrix>(m, "FullPivLU");
-  exposePartialPivLU<Matrix>(m, "PartialPivLU");
-  // <Eigen/QR>
-  exposeColPivHouseholderQR<Matrix>(m, "ColPivHouseholderQR");
-  exposeCompleteOrthogonalDecomposition<Matrix>(
-      m, "CompleteOrthogonalDecomposition");
-  exposeFullPivHouseholderQR<Matrix>(m, "FullPivHouseholderQR");
-  exposeHouseholderQR<Matrix>(m, "HouseholderQR");
-  // <Eigen/SVD>
-  exposeBDCSVD<Matrix>(m, "BDCSVD");
-  exposeJacobiSVD<ColPivHhJacobiSVD>(m, "ColPivHhJacobiSVD");
-  exposeJacobiSVD<FullPivHhJacobiSVD>(m, "FullPivHhJacobiSVD");
-  exposeJacobiSVD<HhJacobiSVD>(m, "HhJacobiSVD");
-  exposeJacobiSVD<NoPrecondJacobiSVD>(m, "NoPrecondJacobiSVD");
-  // <Eigen/Eigenvalues>
-  exposeComplexEigenSolver<Matrix>(m, "ComplexEigenSolver");
-  exposeComplexSchur<Matrix>(m, "ComplexSchur");
-  exposeEigenSolver<Matrix>(m, "EigenSolver");
-  exposeGeneralizedEigenSolver<Matrix>(m, "GeneralizedEigenSolver");
-  exposeGeneralizedSelfAdjointEigenSolver<Matrix>(
-      m, "GeneralizedSelfAdjointEigenSolver");
-  exposeHessenbergDecomposition<Matrix>(m, "HessenbergDecomposition");
-  exposeRealQZ<Matrix>(m, "RealQZ");
-  exposeRealSchur<Matrix>(m, "RealSchur");
-  exposeSelfAdjointEigenSolver<Matrix>(m, "SelfAdjointEigenSolver");
-  exposeTridiagonalization<Matrix>(m, "Tridiagonalization");
-
-  // <Eigen/SparseCholesky>
-  exposeSimplicialLDLT<SparseMatrix>(m, "SimplicialLDLT");
-  exposeSimplicialLLT<SparseMatrix>(m, "SimplicialLLT");
-  // <Eigen/SparseLU>
-  exposeSparseLU<SparseMatrix>(m, "SparseLU");
-  // <Eigen/SparseQR>
-  exposeSparseQR<SparseMatrix>(m, "SparseQR");
-#ifdef NANOEIGENPY_HAS_CHOLMOD
-  // <Eigen/CholmodSupport>
-  exposeCholmodSimplicialLLT<SparseMatrix>(m, "CholmodSimplicialLLT");
-  exposeCholmodSimplicialLDLT<SparseMatrix>(m, "CholmodSimplicialLDLT");
-  exposeCholmodSupernodalLLT<SparseMatrix>(m, "CholmodSupernodalLLT");
+  /// Registers the group \a k in \a m, unless it is already registered.
+  /// Waits, without holding the GIL, if another thread is registering it,
+  /// and returns at once if the current thread is.
+  void load(std::size_t k, nb::module_ m) {
+    const std::thread::id self = std::this_thread::get_id();
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      if (status[k] == Status::Loaded) return;
+      if (status[k] == Status::Loading) {
+        if (loaders[k] == self) return;
+        lock.unlock();
+        nb::gil_scoped_release release;
+        std::unique_lock<std::mutex> wait(mutex);
+        loaded.wait(wait, [&] { return status[k] == Status::Loaded; });
+        return;
+      }
+      status[k] = Status::Loading;
+      loaders[k] = self;
+    }
+    // A group which failed to register is not registered again.
+    auto finish = [&] {
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        status[k] = Status::Loaded;
+      }
+      loaded.notify_all();
+    };
+    try {
+      groups[k].expose(m);
+    } catch (...) {
+      finish();
+      throw;
+    }
+    finish();
+  }
+
+  /// \returns the names of the groups which are not registered yet.
+  std::vector<const char*> pendingNames() {
+    std::vector<const char*> names;
+    std::lock_guard<std::mutex> lock(mutex);
+    for (std::size_t k = 0; k < groups.size(); ++k)
+      if (status[k] != Status::Loaded)
+        names.insert(names.end(), groups[k].names.begin(),
+                     groups[k].names.end());
+    return names;
+  }
+};
+
+}  // namespace
+
+/// Registers the \a groups of bindings in \a m on the first access to one of
+/// their names, through the module __getattr__ (PEP 562). dir(m) lists the
+/// names of the groups which are not registered yet, and the other names
+/// raise AttributeError without registering anything.
+void exposeLazily(nb::module_ m, std::vector<LazyBindings> groups) {
+  if (!lazyBindingsEnabled()) {
+    for (const LazyBindings& group : groups) group.expose(m);
+    return;
+  }
+
+  auto state = std::make_shared<LazyModule>();
+  state->groups = std::move(groups);
+  state->status.assign(state->groups.size(), LazyModule::Status::Pending);
+  state->loaders.resize(state->groups.size());
+  // Borrowed: the functions holding it are attributes of the module.
+  PyObject* self = m.ptr();
+
+  m.def(
+      "__getattr__",
+      [state, self](const std::string& name) -> nb::object {
+        for (std::size_t k = 0; k < state->groups.size(); ++k) {
+          const std::vector<const char*>& names = state->groups[k].names;
+          if (std::any_of(names.begin(), names.end(),
+                          [&](const char* n) { return name == n; }))
+            state->load(k, nb::borrow<nb::module_>(self));
+        }
+        nb::dict dict = nb::borrow<nb::dict>(PyModule_GetDict(self));
+        if (PyObject* value = PyDict_GetItemString(dict.ptr(), name.c_str()))
+          return nb::borrow(value);
+        const std::string module_name =
+            nb::cast<std::string>(dict["__name__"]);
+        throw nb::attribute_error(
+            ("module '" + module_name + "' has no attribute '" + name + "'")
+                .c_str());
+      },
+      "name"_a);
+  m.def("__dir__", [state, self]() {
+    nb::list names;
+    for (auto [key, value] : nb::borrow<nb::dict>(PyModule_GetDict(self)))
+      names.append(key);
+    for (const char* name : state->pendingNames()) names.append(name);
+    return names;
+  });
+}
+
+// The x86-64 variants of the module are the same sources built under
+// another module name, e.g. _nanoeigenpy_x86_64_v3.
+#ifndef NANOEIGENPY_MODULE_NAME
+#define NANOEIGENPY_MODULE_NAME nanoeigenpy
 #endif
-#ifdef NANOEIGENPY_HAS_ACCELERATE
-  // <Eigen/AccelerateSupport>
-  exposeAccelerate(m);
+// Expands NANOEIGENPY_MODULE_NAME before NB_MODULE pastes it.
+#define NANOEIGENPY_MODULE(name, variable) NB_MODULE(name, variable)
+
+#ifdef NANOEIGENPY_WITH_ISA_VARIANTS
+/// Imports the installed variant of the module for the highest x86-64 level
+/// supported by the CPU, if it is higher than the level of this build. The
+/// NANOEIGENPY_ISA_LEVEL environment variable caps the level, e.g. "x86-64"
+/// forces this build.
+nb::object importIsaVariant() {
+  int level = static_cast<int>(cpuIsaLevel());
+  if (const char* cap = std::getenv("NANOEIGENPY_ISA_LEVEL")) {
+    int capped = static_cast<int>(IsaLevel::Unknown);
+    for (int l = static_cast<int>(IsaLevel::X86_64);
+         l <= static_cast<int>(IsaLevel::V4); ++l)
+      if (std::strcmp(cap, isaLevelName(static_cast<IsaLevel>(l))) == 0)
+        capped = l;
+    level = std::min(level, capped);
+  }
+  for (; level > static_cast<int>(compiledIsaLevel()); --level) {
+    std::string name = std::string("_nanoeigenpy_") +
+                       isaLevelName(static_cast<IsaLevel>(level));
+    std::replace(name.begin(), name.end(), '-', '_');
+    try {
+      return nb::module_::import_(name.c_str());
+    } catch (nb::python_error& e) {
+      // This variant was not installed.
+      if (!e.matches(PyExc_ImportError)) throw;
+    }
+  }
+  return nb::object();
+}
+
+/// Makes the contents of \a variant, and its submodules, available from
+/// \a m.
+void reexportModule(nb::module_ m, nb::handle variant) {
+  nb::dict modules =
+      nb::borrow<nb::dict>(nb::module_::import_("sys").attr("modules"));
+  const std::string module_name = nb::cast<std::string>(m.attr("__name__"));
+  for (auto [key, value] : nb::borrow<nb::dict>(variant.attr("__dict__"))) {
+    const std::string name = nb::cast<std::string>(key);
+    if (name.rfind("__", 0) == 0 && name != "__version__" &&
+        name.rfind("__eigen", 0) != 0 && name != "__getattr__" &&
+        name != "__dir__")
+      continue;
+    m.attr(key) = value;
+    if (PyModule_Check(value.ptr()))
+      modules[(module_name + "." + name).c_str()] = value;
+  }
+}
 #endif
 
-  // <Eigen/Geometry>
-  exposeQuaternion<Scalar>(m, "Quaternion");
-  exposeAngleAxis<Scalar>(m, "AngleAxis");
-  exposeHyperplane<Scalar>(m, "Hyperplane");
-  exposeParametrizedLine<Scalar>(m, "ParametrizedLine");
-  exposeRotation2D<Scalar>(m, "Rotation2D");
-  exposeUniformScaling<Scalar>(m, "UniformScaling");
-  exposeTranslation<Scalar>(m, "Translation");
+// Module
+NANOEIGENPY_MODULE(NANOEIGENPY_MODULE_NAME, m) {
+#ifdef NANOEIGENPY_WITH_ISA_VARIANTS
+  if (nb::object variant = importIsaVariant(); variant.is_valid()) {
+    reexportModule(m, variant);
+    return;
+  }
+#endif
 
-  // <Eigen/Jacobi>
-  exposeJacobiRotation<Scalar>(m, "JacobiRotation");
+  // <Eigen/Core>
+  exposeConstants(m);
+  exposePermutationMatrix<Eigen::Dynamic>(m, "PermutationMatrix");
+  // <Eigen/SparseCore>
+  exposeSparseMatrixHandle<SparseMatrix>(m, "SparseMatrix");
 
-  // <Eigen/IterativeLinearSolvers>
+  // Bindings registered on first use, see exposeLazily
+  exposeLazily(m, {denseBindings(), sparseBindings(), geometryBindings(),
+                   asyncBindings()});
   nb::module_ solvers =
       m.def_submodule("solvers", "Iterative linear solvers in Eigen.");
-  exposeIdentityPreconditioner<Scalar>(solvers, "IdentityPreconditioner");
-  exposeDiagonalPreconditioner<Scalar>(solvers, "DiagonalPreconditioner");
-#if EIGEN_VERSION_AT_LEAST(3, 3, 5)
-  exposeLeastSquareDiagonalPreconditioner<Scalar>(
-      solvers, "LeastSquareDiagonalPreconditioner");
-#endif
-
-  using Eigen::Lower;
-
-  using Eigen::BiCGSTAB;
-  using Eigen::ConjugateGradient;
-  using Eigen::DiagonalPreconditioner;
-  using Eigen::IdentityPreconditioner;
-  using Eigen::LeastSquareDiagonalPreconditioner;
-  using Eigen::LeastSquaresConjugateGradient;
-  using Eigen::MINRES;
-
-  using IdentityConjugateGradient =
-      ConjugateGradient<Matrix, Lower, IdentityPreconditioner>;
-  using IdentityLeastSquaresConjugateGradient =
-      LeastSquaresConjugateGradient<Matrix, IdentityPreconditioner>;
-  using DiagonalLeastSquaresConjugateGradient =
-      LeastSquaresConjugateGradient<Matrix, DiagonalPreconditioner<Scalar>>;
-  using IdentityBiCGSTAB = BiCGSTAB<Matrix, IdentityPreconditioner>;
-  using DiagonalMINRES = MINRES<Matrix, Lower, DiagonalPreconditioner<Scalar>>;
-
-  exposeConjugateGradient<ConjugateGradient<Matrix, Lower>>(
-      solvers, "ConjugateGradient");
-  exposeConjugateGradient<IdentityConjugateGradient>(
-      solvers, "IdentityConjugateGradient");
-  exposeLeastSquaresConjugateGradient<LeastSquaresConjugateGradient<Matrix>>(
-      solvers, "LeastSquaresConjugateGradient");
-  exposeLeastSquaresConjugateGradient<IdentityLeastSquaresConjugateGradient>(
-      solvers, "IdentityLeastSquaresConjugateGradient");
-  exposeLeastSquaresConjugateGradient<DiagonalLeastSquaresConjugateGradient>(
-      solvers, "DiagonalLeastSquaresConjugateGradient");
-  exposeMINRES<MINRES<Matrix, Lower>>(solvers, "MINRES");
-  exposeMINRES<DiagonalMINRES>(solvers, "DiagonalMINRES");
-  exposeBiCGSTAB<BiCGSTAB<Matrix>>(solvers, "BiCGSTAB");
-  exposeBiCGSTAB<IdentityBiCGSTAB>(solvers, "IdentityBiCGSTAB");
-
-  exposeIncompleteLUT<SparseMatrix>(solvers, "IncompleteLUT");
-  exposeIncompleteCholesky<SparseMatrix>(solvers, "IncompleteCholesky");
+  exposeLazily(solvers, {solversBindings()});
 
   // Utils
   exposeIsApprox<double>(m);
   exposeIsApprox<std::complex<double>>(m);
+  exposeSparseProducts<Scalar>(m);
+  exposeInstrumentation(m);
+  exposeWorkspaces(m);
 
   m.attr("__version__") = NANOEIGENPY_VERSION;
   m.attr("__eigen_version__") = printEigenVersion();
+  m.attr("__eigen_backend__") = printEigenBackend();
   m.attr("__eigen_max_align_bytes__") = EIGEN_MAX_ALIGN_BYTES;
 
   m.def("SimdInstructionSetsInUse", &Eigen::SimdInstructionSetsInUse,
         "Get the set of SIMD instructions used in Eigen when this module was "
         "compiled.");
+  m.def(
+      "InstructionSetLevelInUse",
+      []() { return std::string(isaLevelName(compiledIsaLevel())); },
+      "Get the x86-64 microarchitecture level (e.g. x86-64-v3) for which the "
+      "loaded build of this module was compiled, or an empty string on other "
+      "architectures.");
+  m.def(
+      "CpuInstructionSetLevel",
+      []() { return std::string(isaLevelName(cpuIsaLevel())); },
+      "Get the highest x86-64 microarchitecture level supported by the CPU, "
+      "or an empty string on other architectures.");
+  m.def("setNbThreads", &Eigen::setNbThreads, "n"_a,
+        "Sets the max number of threads reserved for Eigen's parallelized "
+        "products (0 means the OpenMP default). Only effective when the module "
+        "was compiled with OpenMP support.");
+  m.def("nbThreads", &Eigen::nbThreads,
+        "Returns the max number of threads reserved for Eigen's parallelized "
+        "products.");
 }
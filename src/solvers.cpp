@@ -0,0 +1,80 @@
+/// Copyright 2025 INRIA
+
+#include "nanoeigenpy/solvers.hpp"
+
+#include "./internal.h"
+
+using namespace nanoeigenpy;
+
+namespace {
+
+void exposeSolvers(nb::module_ solvers) {
+  // <Eigen/IterativeLinearSolvers>
+  exposeIdentityPreconditioner<Scalar>(solvers, "IdentityPreconditioner");
+  exposeDiagonalPreconditioner<Scalar>(solvers, "DiagonalPreconditioner");
+#if EIGEN_VERSION_AT_LEAST(3, 3, 5)
+  exposeLeastSquareDiagonalPreconditioner<Scalar>(
+      solvers, "LeastSquareDiagonalPreconditioner");
+#endif
+
+  using Eigen::Lower;
+
+  using Eigen::BiCGSTAB;
+  using Eigen::ConjugateGradient;
+  using Eigen::DiagonalPreconditioner;
+  using Eigen::IdentityPreconditioner;
+  using Eigen::LeastSquareDiagonalPreconditioner;
+  using Eigen::LeastSquaresConjugateGradient;
+  using Eigen::MINRES;
+
+  using IdentityConjugateGradient =
+      ConjugateGradient<Matrix, Lower, IdentityPreconditioner>;
+  using IdentityLeastSquaresConjugateGradient =
+      LeastSquaresConjugateGradient<Matrix, IdentityPreconditioner>;
+  using DiagonalLeastSquaresConjugateGradient =
+      LeastSquaresConjugateGradient<Matrix, DiagonalPreconditioner<Scalar>>;
+  using IdentityBiCGSTAB = BiCGSTAB<Matrix, IdentityPreconditioner>;
+  using DiagonalMINRES = MINRES<Matrix, Lower, DiagonalPreconditioner<Scalar>>;
+
+  exposeConjugateGradient<ConjugateGradient<Matrix, Lower>>(
+      solvers, "ConjugateGradient");
+  exposeConjugateGradient<IdentityConjugateGradient>(
+      solvers, "IdentityConjugateGradient");
+  exposeLeastSquaresConjugateGradient<LeastSquaresConjugateGradient<Matrix>>(
+      solvers, "LeastSquaresConjugateGradient");
+  exposeLeastSquaresConjugateGradient<IdentityLeastSquaresConjugateGradient>(
+      solvers, "IdentityLeastSquaresConjugateGradient");
+  exposeLeastSquaresConjugateGradient<DiagonalLeastSquaresConjugateGradient>(
+      solvers, "DiagonalLeastSquaresConjugateGradient");
+  exposeMINRES<MINRES<Matrix, Lower>>(solvers, "MINRES");
+  exposeMINRES<DiagonalMINRES>(solvers, "DiagonalMINRES");
+  exposeBiCGSTAB<BiCGSTAB<Matrix>>(solvers, "BiCGSTAB");
+  exposeBiCGSTAB<IdentityBiCGSTAB>(solvers, "IdentityBiCGSTAB");
+
+  exposeIncompleteLUT<SparseMatrix>(solvers, "IncompleteLUT");
+  exposeIncompleteCholesky<SparseMatrix>(solvers, "IncompleteCholesky");
+}
+
+}  // namespace
+
+LazyBindings solversBindings() {
+  return {exposeSolvers,
+          {
+              "IdentityPreconditioner",
+              "DiagonalPreconditioner",
+#if EIGEN_VERSION_AT_LEAST(3, 3, 5)
+              "LeastSquareDiagonalPreconditioner",
+#endif
+              "ConjugateGradient",
+              "IdentityConjugateGradient",
+              "LeastSquaresConjugateGradient",
+              "IdentityLeastSquaresConjugateGradient",
+              "DiagonalLeastSquaresConjugateGradient",
+              "MINRES",
+              "DiagonalMINRES",
+              "BiCGSTAB",
+              "IdentityBiCGSTAB",
+              "IncompleteLUT",
+              "IncompleteCholesky",
+          }};
+}
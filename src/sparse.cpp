@@ -0,0 +1,109 @@
+/// Copyright 2025 INRIA
+
+#include "nanoeigenpy/decompositions/sparse/orderings.hpp"
+#include "nanoeigenpy/decompositions/sparse/symbolic-cholesky.hpp"
+#include "nanoeigenpy/decompositions/sparse/simplicial-llt.hpp"
+#include "nanoeigenpy/decompositions/sparse/simplicial-ldlt.hpp"
+#include "nanoeigenpy/decompositions/sparse/supernodal-llt.hpp"
+#include "nanoeigenpy/decompositions/sparse/cholesky-factor-store.hpp"
+#include "nanoeigenpy/decompositions/sparse/sparse-lu.hpp"
+#include "nanoeigenpy/decompositions/sparse/sparse-qr.hpp"
+#include "nanoeigenpy/decompositions/sparse/lanczos-eigen-solver.hpp"
+
+#ifdef NANOEIGENPY_HAS_CHOLMOD
+#include "nanoeigenpy/decompositions/sparse/cholmod/cholmod-simplicial-llt.hpp"
+#include "nanoeigenpy/decompositions/sparse/cholmod/cholmod-simplicial-ldlt.hpp"
+#include "nanoeigenpy/decompositions/sparse/cholmod/cholmod-supernodal-llt.hpp"
+#endif
+#ifdef NANOEIGENPY_HAS_ACCELERATE
+#include "nanoeigenpy/decompositions/sparse/accelerate/accelerate.hpp"
+#endif
+
+#include "./internal.h"
+
+using namespace nanoeigenpy;
+
+using SparseIndex = typename SparseMatrix::StorageIndex;
+using SparseQR = Eigen::SparseQR<
+    SparseMatrix, RuntimeOrdering<SparseIndex, OrderingMethod::COLAMD>>;
+using SparseLU = Eigen::SparseLU<
+    SparseMatrix, RuntimeOrdering<SparseIndex, OrderingMethod::COLAMD>>;
+using SCMatrix = typename SparseLU::SCMatrix;
+using StorageIndex = typename Matrix::StorageIndex;
+#if EIGEN_VERSION_AT_LEAST(5, 0, 0)
+using MappedSparseMatrix =
+    Eigen::Map<Eigen::SparseMatrix<Scalar, Options, StorageIndex>>;
+#else
+using MappedSparseMatrix =
+    Eigen::MappedSparseMatrix<Scalar, Options, StorageIndex>;
+#endif
+
+NB_MAKE_OPAQUE(Eigen::SparseQRMatrixQReturnType<SparseQR>)
+NB_MAKE_OPAQUE(Eigen::SparseQRMatrixQTransposeReturnType<SparseQR>)
+NB_MAKE_OPAQUE(Eigen::SparseLUMatrixLReturnType<SCMatrix>)
+NB_MAKE_OPAQUE(Eigen::SparseLUMatrixUReturnType<SCMatrix, MappedSparseMatrix>)
+
+namespace {
+
+void exposeSparse(nb::module_ m) {
+  // <Eigen/SparseCholesky>
+  exposeSimplicialLDLT<SparseMatrix>(m, "SimplicialLDLT");
+  exposeSimplicialLLT<SparseMatrix>(m, "SimplicialLLT");
+  exposeSupernodalLLT<SparseMatrix>(m, "SupernodalLLT");
+  exposeMappedCholeskyFactor<SparseMatrix>(m, "MappedCholeskyFactor");
+  // <Eigen/SparseLU>
+  exposeSparseLU<SparseMatrix>(m, "SparseLU");
+  // <Eigen/SparseQR>
+  exposeSparseQR<SparseMatrix>(m, "SparseQR");
+  // Fill-reducing orderings
+  exposeCholeskyFillStatistics<SparseMatrix>(m);
+  // Sparse selfadjoint eigenvalue problems
+  exposeLanczosEigenSolver<SparseMatrix>(m, "LanczosEigenSolver");
+#ifdef NANOEIGENPY_HAS_CHOLMOD
+  // <Eigen/CholmodSupport>
+  exposeCholmodSimplicialLLT<SparseMatrix>(m, "CholmodSimplicialLLT");
+  exposeCholmodSimplicialLDLT<SparseMatrix>(m, "CholmodSimplicialLDLT");
+  exposeCholmodSupernodalLLT<SparseMatrix>(m, "CholmodSupernodalLLT");
+#endif
+#ifdef NANOEIGENPY_HAS_ACCELERATE
+  // <Eigen/AccelerateSupport>
+  exposeAccelerate(m);
+#endif
+}
+
+}  // namespace
+
+LazyBindings sparseBindings() {
+  return {exposeSparse,
+          {
+              "SimplicialLDLT",
+              "SimplicialLLT",
+              "SupernodalLLT",
+              "MappedCholeskyFactor",
+              "SparseLU",
+              "SparseLUMatrixLReturnType",
+              "SparseLUMatrixUReturnType",
+              "SparseQR",
+              "SparseQRMatrixQReturnType",
+              "SparseQRMatrixQTransposeReturnType",
+              "OrderingMethod",
+              "CholeskyFillStatistics",
+              "choleskyFillStatistics",
+              "LanczosSelection",
+              "LanczosEigenSolver",
+#ifdef NANOEIGENPY_HAS_CHOLMOD
+              "CholmodSimplicialLLT",
+              "CholmodSimplicialLDLT",
+              "CholmodSupernodalLLT",
+#endif
+#ifdef NANOEIGENPY_HAS_ACCELERATE
+              "AccelerateLLT",
+              "AccelerateLDLT",
+              "AccelerateLDLTUnpivoted",
+              "AccelerateLDLTSBK",
+              "AccelerateLDLTTPP",
+              "AccelerateQR",
+              "AccelerateCholeskyAtA",
+#endif
+          }};
+}
@@ -0,0 +1,86 @@
+import nanoeigenpy
+import numpy as np
+import scipy.sparse as spa
+import asyncio
+import concurrent.futures
+import time
+
+dim = 100
+rng = np.random.default_rng()
+
+A = rng.random((dim, dim))
+A = (A + A.T) * 0.5 + np.diag(10.0 + rng.random(dim))
+A_fac = spa.random(dim, dim, density=0.05, random_state=rng)
+A_sparse = (A_fac.T @ A_fac + spa.diags(5.0 + rng.random(dim))).tocsc()
+
+X = rng.random((dim, 5))
+B = A @ X
+B_sparse = A_sparse @ X
+
+# concurrent.futures interface
+options = (
+    nanoeigenpy.DecompositionOptions.ComputeThinU.value
+    | nanoeigenpy.DecompositionOptions.ComputeThinV.value
+)
+svd = nanoeigenpy.BDCSVD(dim, dim, options)
+future = svd.computeAsync(A)
+assert isinstance(future, concurrent.futures.Future)
+assert isinstance(future, nanoeigenpy.Future)
+assert future.result() is svd
+assert svd.info() == nanoeigenpy.ComputationInfo.Success
+assert nanoeigenpy.is_approx(svd.solveAsync(B).result(), X)
+assert nanoeigenpy.is_approx(svd.solveAsync(B[:, 0]).result(), X[:, 0])
+
+# Several computations run concurrently
+llts = [nanoeigenpy.LLT() for _ in range(4)]
+futures = [llt.computeAsync(A + k * np.eye(dim)) for k, llt in enumerate(llts)]
+for k, (llt, future) in enumerate(zip(llts, futures)):
+    assert future.result() is llt
+    assert nanoeigenpy.is_approx(llt.reconstructedMatrix(), A + k * np.eye(dim))
+
+
+# The tasks take the lock of the decomposition, so that it can be used while
+# they run
+llt = nanoeigenpy.LLT()
+futures = [llt.computeAsync(A + k * np.eye(dim)) for k in range(8)]
+llt.compute(A)
+solutions = [llt.solveAsync(B) for _ in range(8)]
+for future in futures:
+    assert future.result() is llt
+for future in solutions:
+    X_est = future.result()
+    assert any(
+        nanoeigenpy.is_approx((A + k * np.eye(dim)) @ X_est, B) for k in range(8)
+    )
+
+
+# asyncio interface
+async def factorize_and_solve():
+    splu = nanoeigenpy.SparseLU()
+    await splu.computeAsync(A_sparse)
+    assert splu.info() == nanoeigenpy.ComputationInfo.Success
+    return await splu.solveAsync(B_sparse)
+
+
+assert nanoeigenpy.is_approx(asyncio.run(factorize_and_solve()), X)
+
+# Iterative solves
+cg = nanoeigenpy.solvers.ConjugateGradient(A)
+x = cg.solveAsync(B[:, 0], check_interval=5).result()
+assert nanoeigenpy.is_approx(A @ x, B[:, 0], 1e-6)
+assert cg.info() == nanoeigenpy.ComputationInfo.Success
+
+# A running iterative solve is interrupted by cancel()
+cg.setTolerance(0.0)
+cg.setMaxIterations(10**9)
+future = cg.solveAsync(B[:, 0], check_interval=10)
+while not future.running():
+    time.sleep(1e-3)
+assert future.cancel()
+assert future.cancelled()
+try:
+    future.result()
+    assert False
+except concurrent.futures.CancelledError:
+    pass
+assert cg.maxIterations() == 10**9
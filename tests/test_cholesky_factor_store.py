@@ -0,0 +1,121 @@
+import os
+import tempfile
+
+import nanoeigenpy
+import numpy as np
+import scipy.sparse as spa
+
+dim = 100
+rng = np.random.default_rng()
+
+A_fac = spa.random(dim, dim, density=0.25, random_state=rng)
+A = A_fac.T @ A_fac
+A += spa.diags(10.0 * rng.standard_normal(dim) ** 2)
+A = A.tocsc(True)
+A.check_format()
+
+X = rng.random((dim, 20))
+B = A.dot(X)
+
+with tempfile.TemporaryDirectory() as tmpdir:
+    for solver_type in (nanoeigenpy.SimplicialLDLT, nanoeigenpy.SimplicialLLT):
+        solver = solver_type(A)
+        assert solver.info() == nanoeigenpy.ComputationInfo.Success
+
+        path = os.path.join(tmpdir, "factor.bin")
+        solver.save(path)
+
+        factor = nanoeigenpy.MappedCholeskyFactor(path)
+        assert factor.info() == nanoeigenpy.ComputationInfo.Success
+        assert factor.rows() == dim
+        assert factor.cols() == dim
+        assert factor.isLDLT() == (solver_type is nanoeigenpy.SimplicialLDLT)
+
+        X_est = factor.solve(B)
+        assert isinstance(X_est, np.ndarray)
+        assert nanoeigenpy.is_approx(X, X_est)
+        assert nanoeigenpy.is_approx(X_est, solver.solve(B))
+
+        x = rng.random(dim)
+        b = A.dot(x)
+        assert nanoeigenpy.is_approx(x, factor.solve(b))
+
+        X_sparse = spa.random(dim, 10, random_state=rng)
+        B_sparse = A.dot(X_sparse).tocsc(True)
+        B_sparse.sort_indices()
+        X_est = factor.solve(B_sparse)
+        assert isinstance(X_est, spa.csc_matrix)
+        assert nanoeigenpy.is_approx(X_est.toarray(), X_sparse.toarray())
+
+        L = factor.matrixL()
+        assert L.nnz == factor.nonZeros()
+        assert np.array_equal(
+            factor.permutationP().indices(), solver.permutationP().indices()
+        )
+
+        del factor
+
+    path = os.path.join(tmpdir, "not-a-factor.bin")
+    with open(path, "wb") as f:
+        f.write(b"\0" * 4096)
+    try:
+        nanoeigenpy.MappedCholeskyFactor(path)
+        assert False, "Loading an invalid file should raise."
+    except ValueError:
+        pass
+
+    # Corrupted headers and index arrays are detected on loading
+    solver = nanoeigenpy.SimplicialLDLT(A)
+    path = os.path.join(tmpdir, "factor.bin")
+    solver.save(path)
+    with open(path, "rb") as f:
+        content = bytearray(f.read())
+    header = np.dtype(
+        [
+            ("magic", "S8"),
+            ("version", "<u4"),
+            ("byte_order", "<u4"),
+            ("scalar_size", "<u4"),
+            ("scalar_is_complex", "<u4"),
+            ("index_size", "<u4"),
+            ("unit_diagonal", "<u4"),
+            ("size", "<i8"),
+            ("non_zeros", "<i8"),
+            ("outer_offset", "<u8"),
+            ("inner_offset", "<u8"),
+            ("values_offset", "<u8"),
+            ("diagonal_offset", "<u8"),
+            ("permutation_offset", "<u8"),
+            ("file_size", "<u8"),
+        ]
+    )
+    fields = np.frombuffer(content, dtype=header, count=1)[0]
+
+    def corrupt(offset, dtype, value):
+        corrupted = bytearray(content)
+        corrupted[offset : offset + np.dtype(dtype).itemsize] = np.array(
+            value, dtype=dtype
+        ).tobytes()
+        with open(path, "wb") as f:
+            f.write(corrupted)
+        try:
+            nanoeigenpy.MappedCholeskyFactor(path)
+            assert False, "Loading a corrupted file should raise."
+        except ValueError:
+            pass
+
+    def field_offset(name):
+        return header.fields[name][1]
+
+    corrupt(field_offset("size"), "<i8", 1 << 40)
+    corrupt(field_offset("non_zeros"), "<i8", fields["non_zeros"] + 1)
+    corrupt(field_offset("inner_offset"), "<u8", fields["file_size"])
+    corrupt(field_offset("values_offset"), "<u8", (1 << 64) - 8)
+    corrupt(field_offset("permutation_offset"), "<u8", 2)
+    corrupt(int(fields["inner_offset"]), "<i4", dim)
+    corrupt(int(fields["outer_offset"]) + 4, "<i4", -1)
+    # A repeated index of the permutation
+    permutation = np.frombuffer(
+        content, "<i4", count=dim, offset=int(fields["permutation_offset"])
+    )
+    corrupt(int(fields["permutation_offset"]), "<i4", permutation[1])
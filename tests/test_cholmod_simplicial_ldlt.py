@@ -22,3 +22,44 @@ assert nanoeigenpy.is_approx(A.dot(X_est), B)
 
 llt.analyzePattern(A)
 llt.factorize(A)
+
+W = rng.random((dim, 8))
+sigmas = np.array([1.0, -0.5, 2.0, -0.1, 1.0, 0.3, -0.2, 1.5])
+llt.rankUpdate(W, sigmas)
+assert llt.info() == nanoeigenpy.ComputationInfo.Success
+A_updated = A.toarray() + W @ np.diag(sigmas) @ W.T
+X_est = llt.solve(A_updated @ X)
+assert nanoeigenpy.is_approx(X, X_est)
+llt.compute(A)
+
+# Active-set style modifications of the factorization
+k = 7
+A_dense = A.toarray()
+ldlt = nanoeigenpy.CholmodSimplicialLDLT(A)
+ldlt.rowDelete(k)
+assert ldlt.info() == nanoeigenpy.ComputationInfo.Success
+A_deleted = A_dense.copy()
+A_deleted[k, :] = 0.0
+A_deleted[:, k] = 0.0
+A_deleted[k, k] = 1.0
+X_est = ldlt.solve(A_deleted @ X)
+assert nanoeigenpy.is_approx(X, X_est)
+
+ldlt.rowAdd(k, csc_matrix(A_dense[:, [k]]))
+assert ldlt.info() == nanoeigenpy.ComputationInfo.Success
+X_est = ldlt.solve(B)
+assert nanoeigenpy.is_approx(X, X_est)
+
+C = csc_matrix(rng.random((dim, 3)))
+ldlt.updown(C)
+X_est = ldlt.solve((A_dense + C @ C.T) @ X)
+assert nanoeigenpy.is_approx(X, X_est)
+ldlt.updown(C, False)
+X_est = ldlt.solve(B)
+assert nanoeigenpy.is_approx(X, X_est)
+
+ldlt = nanoeigenpy.CholmodSimplicialLDLT(A)
+A_inv = np.linalg.inv(A.toarray())
+assert nanoeigenpy.is_approx(ldlt.inverseDiagonal(), np.diag(A_inv))
+Z = ldlt.selectedInversion()
+assert nanoeigenpy.is_approx(Z.toarray(), A_inv)
@@ -23,3 +23,18 @@ assert nanoeigenpy.is_approx(A.dot(X_est), B)
 
 llt.analyzePattern(A)
 llt.factorize(A)
+
+W = rng.random((dim, 8))
+sigmas = np.array([1.0, -0.5, 2.0, -0.1, 1.0, 0.3, -0.2, 1.5])
+llt.rankUpdate(W, sigmas)
+assert llt.info() == nanoeigenpy.ComputationInfo.Success
+A_updated = A.toarray() + W @ np.diag(sigmas) @ W.T
+X_est = llt.solve(A_updated @ X)
+assert nanoeigenpy.is_approx(X, X_est)
+llt.compute(A)
+
+# Cholmod's solves use its workspace, and their tasks take the lock of the
+# solver exclusively
+futures = [llt.solveAsync(B) for _ in range(4)]
+for future in futures:
+    assert nanoeigenpy.is_approx(future.result(), X)
@@ -1,3 +1,6 @@
+import os
+import tempfile
+
 import numpy as np
 from scipy.sparse import csc_matrix
 
@@ -23,3 +26,28 @@ assert nanoeigenpy.is_approx(A.dot(X_est), B)
 
 llt.analyzePattern(A)
 llt.factorize(A)
+
+W = rng.random((dim, 8))
+sigmas = np.array([1.0, -0.5, 2.0, -0.1, 1.0, 0.3, -0.2, 1.5])
+llt.rankUpdate(W, sigmas)
+assert llt.info() == nanoeigenpy.ComputationInfo.Success
+A_updated = A.toarray() + W @ np.diag(sigmas) @ W.T
+X_est = llt.solve(A_updated @ X)
+assert nanoeigenpy.is_approx(X, X_est)
+llt.compute(A)
+
+with tempfile.TemporaryDirectory() as tmpdir:
+    path = os.path.join(tmpdir, "factor.bin")
+    llt.save(path)
+    factor = nanoeigenpy.MappedCholeskyFactor(path)
+    assert not factor.isLDLT()
+    X_est = factor.solve(B)
+    assert nanoeigenpy.is_approx(X, X_est)
+    del factor
+
+A_inv = np.linalg.inv(A.toarray())
+assert nanoeigenpy.is_approx(llt.inverseDiagonal(), np.diag(A_inv))
+assert nanoeigenpy.is_approx(llt.selectedInversion().toarray(), A_inv)
+# The selected inversion works on a copy of the factor
+X_est = llt.solve(B)
+assert nanoeigenpy.is_approx(X, X_est)
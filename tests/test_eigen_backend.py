@@ -0,0 +1,54 @@
+import nanoeigenpy
+import numpy as np
+import os
+
+backend = nanoeigenpy.__eigen_backend__
+assert backend in ["Eigen", "BLAS", "LAPACKE", "BLAS/LAPACKE", "MKL"]
+
+# The build system sets the backend it configured
+expected_backend = os.environ.get("NANOEIGENPY_EXPECTED_EIGEN_BACKEND")
+if expected_backend is not None:
+    assert backend == expected_backend
+
+# The decompositions routed to LAPACK by Eigen give the same results with
+# both backends
+prec = 1e-8
+dim = 300
+rng = np.random.default_rng()
+
+A = rng.standard_normal((dim, dim))
+A_spd = A @ A.T + dim * np.eye(dim)
+X = rng.standard_normal((dim, 5))
+
+llt = nanoeigenpy.LLT(A_spd)
+assert llt.info() == nanoeigenpy.ComputationInfo.Success
+assert nanoeigenpy.is_approx(A_spd @ llt.solve(A_spd @ X), A_spd @ X, prec)
+assert nanoeigenpy.is_approx(llt.reconstructedMatrix(), A_spd, prec)
+
+lu = nanoeigenpy.PartialPivLU(A)
+assert nanoeigenpy.is_approx(A @ lu.solve(A @ X), A @ X, prec)
+assert nanoeigenpy.is_approx(lu.reconstructedMatrix(), A, prec)
+
+qr = nanoeigenpy.HouseholderQR(A)
+assert nanoeigenpy.is_approx(A @ qr.solve(A @ X), A @ X, prec)
+
+colpivqr = nanoeigenpy.ColPivHouseholderQR(A)
+assert colpivqr.rank() == dim
+assert nanoeigenpy.is_approx(A @ colpivqr.solve(A @ X), A @ X, prec)
+
+es = nanoeigenpy.SelfAdjointEigenSolver(A_spd)
+assert nanoeigenpy.is_approx(es.eigenvalues(), np.linalg.eigvalsh(A_spd), prec)
+V = es.eigenvectors()
+assert nanoeigenpy.is_approx(V @ np.diag(es.eigenvalues()) @ V.T, A_spd, prec)
+
+options = (
+    nanoeigenpy.DecompositionOptions.ComputeThinU.value
+    | nanoeigenpy.DecompositionOptions.ComputeThinV.value
+)
+singular_values = np.linalg.svd(A, compute_uv=False)
+for svd in [
+    nanoeigenpy.BDCSVD(A, options),
+    nanoeigenpy.ColPivHhJacobiSVD(A, options),
+]:
+    assert nanoeigenpy.is_approx(svd.singularValues(), singular_values, prec)
+    assert nanoeigenpy.is_approx(A @ svd.solve(A @ X), A @ X, prec)
@@ -0,0 +1,82 @@
+import nanoeigenpy
+import numpy as np
+import scipy.sparse as spa
+from concurrent.futures import ThreadPoolExecutor
+
+nthreads = 8
+dim = 100
+rng = np.random.default_rng()
+
+A = rng.random((dim, dim))
+A = (A + A.T) * 0.5 + np.diag(10.0 + rng.random(dim))
+A_fac = spa.random(dim, dim, density=0.05, random_state=rng)
+A_sparse = (A_fac.T @ A_fac + spa.diags(5.0 + rng.random(dim))).tocsc()
+
+B = [rng.random((dim, 4)) for _ in range(4 * nthreads)]
+
+
+def check_concurrent_solves(solver, matrix, prec=1e-12):
+    with ThreadPoolExecutor(nthreads) as pool:
+        X = list(pool.map(solver.solve, B))
+    for b, x in zip(B, X):
+        assert nanoeigenpy.is_approx(matrix @ x, b, prec)
+
+
+# Solves on a shared factorization run concurrently
+for solver in [
+    nanoeigenpy.LLT(A),
+    nanoeigenpy.LDLT(A),
+    nanoeigenpy.PartialPivLU(A),
+]:
+    check_concurrent_solves(solver, A)
+
+for solver in [
+    nanoeigenpy.SimplicialLDLT(A_sparse),
+    nanoeigenpy.SparseLU(A_sparse),
+]:
+    check_concurrent_solves(solver, A_sparse)
+
+# Iterative solvers record the statistics of their last solve, so that their
+# solves take the lock of the solver
+check_concurrent_solves(nanoeigenpy.solvers.ConjugateGradient(A), A, 1e-6)
+
+
+# Concurrent refactorizations of a shared solver are serialized
+ldlt = nanoeigenpy.LDLT(A)
+
+
+def refactorize(shift):
+    ldlt.compute(A + shift * np.eye(dim))
+    return ldlt.info()
+
+
+with ThreadPoolExecutor(nthreads) as pool:
+    infos = list(pool.map(refactorize, range(4 * nthreads)))
+assert all(info == nanoeigenpy.ComputationInfo.Success for info in infos)
+
+A_reconstructed = ldlt.reconstructedMatrix()
+shift = round(A_reconstructed[0, 0] - A[0, 0])
+assert nanoeigenpy.is_approx(A_reconstructed, A + shift * np.eye(dim))
+
+
+# Solves wait for a refactorization of the solver in progress, and see either
+# factorization
+llt = nanoeigenpy.LLT(A)
+b = B[0][:, 0]
+shifts = [0.0, 1.0]
+
+
+def solve_or_refactorize(k):
+    if k % 2:
+        llt.compute(A + shifts[k % 4 // 2] * np.eye(dim))
+        return None
+    return llt.solve(b)
+
+
+with ThreadPoolExecutor(nthreads) as pool:
+    X = list(pool.map(solve_or_refactorize, range(16 * nthreads)))
+for x in X[::2]:
+    assert any(
+        nanoeigenpy.is_approx((A + shift * np.eye(dim)) @ x, b, 1e-10)
+        for shift in shifts
+    )
@@ -0,0 +1,175 @@
+import nanoeigenpy
+import numpy as np
+import scipy.sparse as spa
+import json
+import os
+import tempfile
+
+dim = 100
+rng = np.random.default_rng()
+
+A_fac = spa.random(dim, dim, density=0.05, random_state=rng)
+A = (A_fac.T @ A_fac + spa.diags(5.0 + rng.random(dim))).tocsc()
+X = rng.random((dim, 3))
+B = A @ X
+
+# Disabled by default: nothing is recorded
+assert not nanoeigenpy.statsEnabled()
+nanoeigenpy.resetStats()
+nanoeigenpy.SparseLU(A).solve(B)
+assert nanoeigenpy.stats() == {}
+
+nanoeigenpy.setStatsEnabled(True)
+assert nanoeigenpy.statsEnabled()
+
+splu = nanoeigenpy.SparseLU()
+splu.analyzePattern(A)
+for _ in range(3):
+    splu.factorize(A)
+assert nanoeigenpy.is_approx(splu.solve(B), X)
+assert nanoeigenpy.is_approx(splu.solve(B[:, 0]), X[:, 0])
+
+stats = nanoeigenpy.stats()
+assert stats["SparseLU.analyzePattern"]["calls"] == 1
+assert stats["SparseLU.factorize"]["calls"] == 3
+# The overloads of a method share its statistics
+assert stats["SparseLU.solve"]["calls"] == 2
+for entry in stats.values():
+    assert set(entry) == {
+        "calls",
+        "conversion",
+        "kernel",
+        "result",
+        "total",
+        "allocations",
+        "allocated",
+        "peak",
+    }
+    assert entry["conversion"] >= 0.0
+    assert entry["kernel"] > 0.0
+    assert entry["result"] >= 0.0
+    assert np.isclose(
+        entry["total"], entry["conversion"] + entry["kernel"] + entry["result"]
+    )
+
+# The SparseMatrix overloads and the Cholesky solvers
+handle = nanoeigenpy.SparseMatrix(A)
+llt = nanoeigenpy.SimplicialLLT()
+llt.compute(handle)
+llt.compute(A)
+assert nanoeigenpy.is_approx(llt.solve(B), X)
+stats = nanoeigenpy.stats()
+assert stats["SimplicialLLT.compute"]["calls"] == 2
+assert stats["SimplicialLLT.solve"]["calls"] == 1
+
+# Iterative solvers
+cg = nanoeigenpy.solvers.ConjugateGradient()
+cg.compute(A)
+cg.solve(B[:, 0])
+cg.solveWithGuess(B[:, 0], np.zeros(dim))
+stats = nanoeigenpy.stats()
+assert stats["ConjugateGradient.compute"]["calls"] == 1
+assert stats["ConjugateGradient.solve"]["calls"] == 1
+assert stats["ConjugateGradient.solveWithGuess"]["calls"] == 1
+
+# Dense decompositions
+qr = nanoeigenpy.FullPivHouseholderQR()
+dense = rng.random((dim, dim))
+qr.compute(dense)
+qr.solve(dense @ X)
+qr.solve(dense @ X[:, 0])
+stats = nanoeigenpy.stats()
+assert stats["FullPivHouseholderQR.compute"]["calls"] == 1
+assert stats["FullPivHouseholderQR.compute"]["kernel"] > 0.0
+assert stats["FullPivHouseholderQR.solve"]["calls"] == 2
+
+# Heap allocations of the kernels
+if nanoeigenpy.allocationTrackingAvailable():
+    nanoeigenpy.resetStats()
+    nanoeigenpy.setStatsEnabled(True, track_allocations=True)
+    svd = nanoeigenpy.BDCSVD()
+    svd.compute(dense)
+    svd.compute(dense)
+    entry = nanoeigenpy.stats()["BDCSVD.compute"]
+    assert entry["calls"] == 2
+    assert entry["allocations"] > 0
+    # At least the singular values are allocated
+    assert entry["allocated"] >= dim * 8
+    assert 0 < entry["peak"] <= entry["allocated"]
+    nanoeigenpy.setStatsEnabled(True)
+    svd.compute(dense)
+    assert nanoeigenpy.stats()["BDCSVD.compute"]["allocations"] == (
+        entry["allocations"]
+    )
+else:
+    try:
+        nanoeigenpy.setStatsEnabled(True, track_allocations=True)
+        assert False, "allocation tracking should not be available"
+    except RuntimeError:
+        pass
+    assert nanoeigenpy.stats()["FullPivHouseholderQR.compute"]["allocations"] == 0
+
+# Asynchronous calls only time their kernel
+splu.solveAsync(B).result()
+entry = nanoeigenpy.stats()["SparseLU.solveAsync"]
+assert entry["calls"] == 1
+assert entry["conversion"] == 0.0 and entry["result"] == 0.0
+
+nanoeigenpy.resetStats()
+assert nanoeigenpy.stats() == {}
+
+nanoeigenpy.setStatsEnabled(False)
+splu.factorize(A)
+assert nanoeigenpy.stats() == {}
+
+# Tracing
+nanoeigenpy.startTracing(events_per_thread=8)
+splu.factorize(A)
+splu.solve(B)
+futures = [
+    nanoeigenpy.SparseLU().computeAsync(A + k * spa.eye(dim, format="csc"))
+    for k in range(4)
+]
+for future in futures:
+    future.result()
+nanoeigenpy.stopTracing()
+splu.solve(B)
+
+events = nanoeigenpy.traceEvents()
+names = [event["name"] for event in events]
+assert names.count("SparseLU.factorize") == 1
+assert names.count("SparseLU.solve") == 1
+assert names.count("SparseLU.computeAsync") == 4
+for event in events:
+    assert 0.0 <= event["begin"] <= event["end"]
+factorize = events[names.index("SparseLU.factorize")]
+assert (factorize["rows"], factorize["cols"]) == (dim, dim)
+assert factorize["nonZeros"] == A.nnz
+solve = events[names.index("SparseLU.solve")]
+assert (solve["rows"], solve["cols"]) == B.shape
+# The asynchronous computations run on other threads
+main_thread = factorize["thread"]
+assert all(
+    event["thread"] != main_thread
+    for event in events
+    if event["name"] == "SparseLU.computeAsync"
+)
+
+# Each thread keeps its last events
+nanoeigenpy.startTracing(events_per_thread=2)
+for _ in range(5):
+    splu.solve(B)
+nanoeigenpy.stopTracing()
+assert len(nanoeigenpy.traceEvents()) == 2
+
+with tempfile.TemporaryDirectory() as directory:
+    path = os.path.join(directory, "trace.json")
+    nanoeigenpy.dumpTrace(path)
+    with open(path) as file:
+        trace = json.load(file)
+assert len(trace["traceEvents"]) == 2
+for event in trace["traceEvents"]:
+    assert event["name"] == "SparseLU.solve"
+    assert event["ph"] == "X"
+    assert event["dur"] >= 0.0
+    assert event["args"]["rows"] == dim
@@ -0,0 +1,19 @@
+import nanoeigenpy
+
+levels = ["", "x86-64", "x86-64-v2", "x86-64-v3", "x86-64-v4"]
+
+cpu_level = nanoeigenpy.CpuInstructionSetLevel()
+level = nanoeigenpy.InstructionSetLevelInUse()
+print("CPU level:", cpu_level)
+print("Level in use:", level)
+print("SIMD instruction sets in use:", nanoeigenpy.SimdInstructionSetsInUse())
+
+assert cpu_level in levels
+assert level in levels
+# The loaded build never requires more than what the CPU supports
+assert levels.index(level) <= levels.index(cpu_level)
+
+# The submodules of the loaded variant are importable from nanoeigenpy
+from nanoeigenpy.solvers import ConjugateGradient  # noqa: E402
+
+assert ConjugateGradient is nanoeigenpy.solvers.ConjugateGradient
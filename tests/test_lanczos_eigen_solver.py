@@ -0,0 +1,113 @@
+import nanoeigenpy
+import numpy as np
+import scipy.sparse as spa
+
+dim = 400
+nev = 6
+rng = np.random.default_rng()
+
+# Sparse symmetric matrix with well separated eigenvalues
+A = spa.diags(np.arange(1.0, dim + 1.0)) + spa.diags(
+    [0.3 * np.ones(dim - 7), 0.3 * np.ones(dim - 7)], [-7, 7]
+)
+A = A.tocsc(True)
+A.check_format()
+eigenvalues_ref = np.linalg.eigvalsh(A.toarray())
+
+
+def check_eigenpairs(solver, expected):
+    assert solver.info() == nanoeigenpy.ComputationInfo.Success
+    eigenvalues = solver.eigenvalues()
+    eigenvectors = solver.eigenvectors()
+    assert eigenvalues.shape == (len(expected),)
+    assert eigenvectors.shape == (dim, len(expected))
+    assert np.allclose(eigenvalues, expected)
+    assert np.linalg.norm(A @ eigenvectors - eigenvectors * eigenvalues) < 1e-6
+    assert nanoeigenpy.is_approx(eigenvectors.T @ eigenvectors, np.eye(len(expected)))
+
+
+lanczos = nanoeigenpy.LanczosEigenSolver()
+
+lanczos.compute(A, nev, nanoeigenpy.LanczosSelection.LargestAlgebraic)
+check_eigenpairs(lanczos, eigenvalues_ref[-nev:])
+assert lanczos.operations() > 0
+
+lanczos.compute(A, nev, nanoeigenpy.LanczosSelection.SmallestAlgebraic)
+check_eigenpairs(lanczos, eigenvalues_ref[:nev])
+
+lanczos.compute(A, nev)
+check_eigenpairs(lanczos, eigenvalues_ref[-nev:])
+
+# Shift-invert mode, factorizing A - sigma I internally
+sigma = 100.5
+closest = np.sort(eigenvalues_ref[np.argsort(np.abs(eigenvalues_ref - sigma))[:nev]])
+lanczos.computeShiftInvert(A, nev, sigma)
+check_eigenpairs(lanczos, closest)
+
+# Shift-invert mode, reusing an existing factorization of A - sigma I
+A_shifted = (A - sigma * spa.identity(dim)).tocsc(True)
+ldlt = nanoeigenpy.SimplicialLDLT(A_shifted)
+lanczos.computeShiftInvert(ldlt, nev, sigma)
+check_eigenpairs(lanczos, closest)
+
+splu = nanoeigenpy.SparseLU(A_shifted)
+lanczos.computeShiftInvert(splu, nev, sigma)
+check_eigenpairs(lanczos, closest)
+
+# Smallest modes of a stiffness matrix through a zero shift
+L = spa.diags(
+    [-np.ones(dim - 1), 2.0 * np.ones(dim), -np.ones(dim - 1)], [-1, 0, 1]
+).tocsc(True)
+lanczos.computeShiftInvert(L, nev, 0.0)
+assert lanczos.info() == nanoeigenpy.ComputationInfo.Success
+k = np.arange(1, nev + 1)
+assert np.allclose(lanczos.eigenvalues(), 2.0 - 2.0 * np.cos(np.pi * k / (dim + 1)))
+
+# Parameters
+lanczos.setMaxIterations(1).setTolerance(1e-12).setSubspaceSize(30).setSeed(3)
+assert lanczos.maxIterations() == 1
+assert lanczos.tolerance() == 1e-12
+assert lanczos.subspaceSize() == 30
+assert lanczos.seed() == 3
+lanczos.compute(L, nev, nanoeigenpy.LanczosSelection.LargestAlgebraic)
+assert lanczos.info() == nanoeigenpy.ComputationInfo.NoConvergence
+assert lanczos.iterations() == 1
+
+# Invalid numbers of eigenpairs
+for bad_nev in [0, -1, dim + 1]:
+    for compute in [
+        lambda: lanczos.compute(A, bad_nev),
+        lambda: lanczos.computeShiftInvert(A, bad_nev, sigma),
+        lambda: lanczos.computeShiftInvert(ldlt, bad_nev, sigma),
+    ]:
+        try:
+            compute()
+            assert False, "nev must be in [1, n]"
+        except ValueError:
+            pass
+try:
+    lanczos.compute(spa.random(dim, dim + 1, format="csc"), nev)
+    assert False, "the matrix must be square"
+except ValueError:
+    pass
+try:
+    lanczos.setSubspaceSize(-1)
+    assert False, "the subspace size must be nonnegative"
+except ValueError:
+    pass
+assert lanczos.subspaceSize() == 30
+
+# All the eigenpairs, with a subspace of the whole space
+small = spa.diags(np.arange(1.0, 6.0)).tocsc()
+lanczos.setSubspaceSize(0).setMaxIterations(1000)
+lanczos.compute(small, 5)
+assert lanczos.info() == nanoeigenpy.ComputationInfo.Success
+assert np.allclose(lanczos.eigenvalues(), np.arange(1.0, 6.0))
+
+decomp1 = nanoeigenpy.LanczosEigenSolver()
+decomp2 = nanoeigenpy.LanczosEigenSolver()
+id1 = decomp1.id()
+id2 = decomp2.id()
+assert id1 != id2
+assert id1 == decomp1.id()
+assert id2 == decomp2.id()
@@ -0,0 +1,82 @@
+import nanoeigenpy
+import os
+import subprocess
+import sys
+
+
+def run(code, **env):
+    """Runs code in a new interpreter, in which no binding is registered yet."""
+    subprocess.run(
+        [sys.executable, "-c", code], check=True, env={**os.environ, **env}
+    )
+
+
+# The bindings are only registered on first use
+run(
+    """
+import nanoeigenpy
+assert "LLT" not in vars(nanoeigenpy)
+assert "Quaternion" not in vars(nanoeigenpy)
+assert "LLT" in dir(nanoeigenpy)
+q = nanoeigenpy.Quaternion()
+assert "SparseLU" not in vars(nanoeigenpy)
+"""
+)
+run(
+    """
+from nanoeigenpy.solvers import ConjugateGradient
+from nanoeigenpy import SparseLU
+"""
+)
+# An unknown name does not register the groups
+run(
+    """
+import nanoeigenpy
+assert not hasattr(nanoeigenpy, "NotABinding")
+assert "LLT" not in vars(nanoeigenpy)
+assert "Quaternion" not in vars(nanoeigenpy)
+"""
+)
+# Concurrent first accesses wait for the registration of their group
+run(
+    """
+import nanoeigenpy
+import threading
+
+names = ["LLT", "SparseLU", "Quaternion", "Future", "OrderingMethod"] * 4
+found = {}
+threads = [
+    threading.Thread(target=lambda n=n: found.setdefault(n, getattr(nanoeigenpy, n)))
+    for n in names
+]
+for thread in threads:
+    thread.start()
+for thread in threads:
+    thread.join()
+assert sorted(found) == sorted(set(names))
+"""
+)
+# They can all be registered on import
+run(
+    """
+import nanoeigenpy
+assert "LLT" in vars(nanoeigenpy)
+assert "ConjugateGradient" in vars(nanoeigenpy.solvers)
+""",
+    NANOEIGENPY_LAZY_BINDINGS="0",
+)
+
+# dir() lists every binding before it is registered
+for module in [nanoeigenpy, nanoeigenpy.solvers]:
+    names = {name for name in dir(module) if not name.startswith("_")}
+    for name in names:
+        getattr(module, name)
+    registered = {name for name in vars(module) if not name.startswith("_")}
+    assert registered <= names, registered - names
+
+assert not hasattr(nanoeigenpy, "NotABinding")
+try:
+    nanoeigenpy.NotABinding
+    assert False
+except AttributeError as e:
+    assert "NotABinding" in str(e)
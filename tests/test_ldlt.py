@@ -20,13 +20,37 @@ A = (A + A.T) * 0.5 + np.diag(10.0 + rng.random(dim))
 ldlt = nanoeigenpy.LDLT(A)
 assert ldlt.info() == nanoeigenpy.ComputationInfo.Success
 
-L = ldlt.matrixL()
-D = ldlt.vectorD()
+L = ldlt.matrixL(copy=True)
+D = ldlt.vectorD(copy=True)
 P = ldlt.transpositionsP()
 assert nanoeigenpy.is_approx(
     np.transpose(P).dot(L.dot(np.diag(D).dot(np.transpose(L).dot(P)))), A
 )
 
+# The factors are read-only views of the factorization, unless copy=True
+assert not np.shares_memory(D, ldlt.matrixLDLT())
+D_view = ldlt.vectorD()
+assert not D_view.flags.writeable
+assert np.shares_memory(D_view, ldlt.matrixLDLT())
+assert np.array_equal(D_view, np.diag(ldlt.matrixLDLT()))
+L_view = ldlt.matrixL()
+U_view = ldlt.matrixU()
+assert not L_view.flags.writeable and not U_view.flags.writeable
+assert np.array_equal(np.tril(L_view, -1), np.tril(L, -1))
+assert np.array_equal(np.diag(L_view), D)
+assert np.array_equal(np.triu(U_view, 1), np.triu(ldlt.matrixU(copy=True), 1))
+
+# The views keep their factor when a compute resizes the factorization
+ldlt_resized = nanoeigenpy.LDLT(A)
+D_view = ldlt_resized.vectorD()
+L_view = ldlt_resized.matrixL()
+ldlt_resized.compute(np.eye(dim // 2))
+assert ldlt_resized.vectorD().shape == (dim // 2,)
+assert not np.shares_memory(L_view, ldlt_resized.matrixLDLT())
+assert np.array_equal(D_view, D)
+assert np.array_equal(np.tril(L_view, -1), np.tril(L, -1))
+del D_view, L_view, U_view
+
 X = rng.random((dim, 20))
 B = A.dot(X)
 X_est = ldlt.solve(B)
@@ -67,12 +91,29 @@ assert nanoeigenpy.is_approx(LDLT_diag, D)
 sigma = 3
 w = np.ones(dim)
 ldlt.rankUpdate(w, sigma)
-L = ldlt.matrixL()
+L = ldlt.matrixL(copy=True)
 D = ldlt.vectorD()
 P = ldlt.transpositionsP()
 A_updated = np.transpose(P).dot(L.dot(np.diag(D).dot(np.transpose(L).dot(P))))
 assert nanoeigenpy.is_approx(A_updated, A + sigma * w * np.transpose(w))
 
+W = rng.random((dim, 8))
+sigmas = np.array([1.0, -0.5, 2.0, -0.1, 1.0, 0.3, -0.2, 1.5])
+ldlt.rankUpdate(W, sigmas)
+L = ldlt.matrixL(copy=True)
+D = ldlt.vectorD()
+P = ldlt.transpositionsP()
+assert nanoeigenpy.is_approx(
+    P.T @ L @ np.diag(D) @ L.T @ P, A_updated + W @ np.diag(sigmas) @ W.T
+)
+
+# The first update initializes a preallocated decomposition
+ldlt_init = nanoeigenpy.LDLT(dim)
+ldlt_init.rankUpdate(W, np.abs(sigmas))
+assert nanoeigenpy.is_approx(
+    ldlt_init.reconstructedMatrix(), W @ np.diag(np.abs(sigmas)) @ W.T
+)
+
 ldlt1 = nanoeigenpy.LDLT()
 ldlt2 = nanoeigenpy.LDLT()
 
@@ -11,13 +11,23 @@ llt = nanoeigenpy.LLT(A)
 
 assert llt.info() == nanoeigenpy.ComputationInfo.Success
 
-L = llt.matrixL()
+L = llt.matrixL(copy=True)
 assert nanoeigenpy.is_approx(L.dot(np.transpose(L)), A)
 
-U = llt.matrixU()
+U = llt.matrixU(copy=True)
 LU = L @ U
 assert nanoeigenpy.is_approx(LU, A)
 
+# The factors are read-only views of the factorization, unless copy=True
+L_view = llt.matrixL()
+U_view = llt.matrixU()
+assert not L_view.flags.writeable and not U_view.flags.writeable
+assert L.flags.writeable
+assert np.shares_memory(L_view, llt.matrixLLT())
+assert np.shares_memory(U_view, L_view)
+assert np.array_equal(np.tril(L_view), L)
+assert np.array_equal(np.triu(U_view), U)
+
 X = rng.random((dim, 20))
 B = A.dot(X)
 X_est = llt.solve(B)
@@ -52,11 +62,32 @@ assert abs(estimated_r_cond_num - 1) <= 1e-9
 sigma = 3
 w = np.ones(dim)
 llt.rankUpdate(w, sigma)
-L = llt.matrixL()
-U = llt.matrixU()
+L = llt.matrixL(copy=True)
+U = llt.matrixU(copy=True)
 LU = L @ U
 assert nanoeigenpy.is_approx(LU, A + sigma * w * np.transpose(w))
 
+A_updated = LU
+W = rng.random((dim, 8))
+sigmas = np.array([1.0, -0.5, 2.0, -0.1, 1.0, 0.3, -0.2, 1.5])
+llt.rankUpdate(W, sigmas)
+assert llt.info() == nanoeigenpy.ComputationInfo.Success
+L = llt.matrixL(copy=True)
+assert nanoeigenpy.is_approx(L @ L.T, A_updated + W @ np.diag(sigmas) @ W.T)
+
+# The views keep their factor when a compute resizes the factorization
+L_view = llt.matrixL()
+L_before = L_view.copy()
+llt.compute(np.eye(dim // 2))
+assert llt.matrixL().shape == (dim // 2, dim // 2)
+assert not np.shares_memory(L_view, llt.matrixLLT())
+assert np.array_equal(L_view, L_before)
+del L_view, U_view
+
+llt.compute(np.eye(dim))
+llt.rankUpdate(np.ones((dim, 1)), np.array([-1.0]))
+assert llt.info() == nanoeigenpy.ComputationInfo.NumericalIssue
+
 llt1 = nanoeigenpy.LLT()
 llt2 = nanoeigenpy.LLT()
 
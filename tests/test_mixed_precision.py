@@ -0,0 +1,104 @@
+import nanoeigenpy
+import numpy as np
+
+dim = 100
+rng = np.random.default_rng()
+A = rng.random((dim, dim)) + np.diag(dim + rng.random(dim))
+
+# Partial pivoting LU
+solver = nanoeigenpy.MixedPrecisionPartialPivLU(A)
+assert solver.rows() == dim
+assert solver.cols() == dim
+
+x = rng.random(dim)
+b = A.dot(x)
+x_est = solver.solve(b)
+assert solver.info() == nanoeigenpy.ComputationInfo.Success
+assert not solver.usedFallback()
+assert solver.iterations() > 0
+assert solver.error() < 1e-14
+assert nanoeigenpy.is_approx(x, x_est)
+assert nanoeigenpy.is_approx(A.dot(x_est), b)
+
+X = rng.random((dim, 20))
+B = A.dot(X)
+X_est = solver.solve(B)
+assert solver.info() == nanoeigenpy.ComputationInfo.Success
+assert nanoeigenpy.is_approx(X, X_est)
+
+# Every column is refined, even when a column of much larger scale dominates
+X[:, 1] *= 1e-10
+B = A.dot(X)
+X_est = solver.solve(B)
+assert solver.info() == nanoeigenpy.ComputationInfo.Success
+assert solver.error() < 1e-14
+assert np.linalg.norm(X_est[:, 1] - X[:, 1]) <= 1e-13 * np.linalg.norm(X[:, 1])
+
+# The single precision solve alone does not reach double accuracy
+x_low = np.linalg.solve(A.astype(np.float32), b.astype(np.float32))
+assert np.linalg.norm(A.dot(x_low) - b) > np.linalg.norm(A.dot(x_est) - b)
+
+# Ill-conditioned matrices fall back to a double precision factorization
+U, _, Vt = np.linalg.svd(rng.random((dim, dim)))
+A_ill = U @ np.diag(np.logspace(0, -12, dim)) @ Vt
+solver.compute(A_ill)
+b = A_ill.dot(x)
+x_est = solver.solve(b)
+assert solver.usedFallback()
+assert solver.info() == nanoeigenpy.ComputationInfo.Success
+assert np.linalg.norm(A_ill.dot(x_est) - b) <= 1e-10 * np.linalg.norm(b)
+
+# Entries overflowing single precision
+solver.compute(A * 1e40)
+x_est = solver.solve(A.dot(x) * 1e40)
+assert solver.usedFallback()
+assert nanoeigenpy.is_approx(x, x_est)
+
+solver.setMaxIterations(0)
+assert solver.maxIterations() == 0
+solver.setTolerance(1e-10)
+assert solver.tolerance() == 1e-10
+solver.compute(A)
+x_est = solver.solve(A.dot(x))
+assert solver.usedFallback()
+assert nanoeigenpy.is_approx(x, x_est)
+
+# Cholesky
+A_spd = A.dot(A.T)
+llt = nanoeigenpy.MixedPrecisionLLT(A_spd)
+b = A_spd.dot(x)
+x_est = llt.solve(b)
+assert llt.info() == nanoeigenpy.ComputationInfo.Success
+assert not llt.usedFallback()
+assert nanoeigenpy.is_approx(A_spd.dot(x_est), b)
+
+# A non positive definite matrix is reported by the fallback factorization
+llt.compute(-A_spd)
+llt.solve(b)
+assert llt.usedFallback()
+assert llt.info() == nanoeigenpy.ComputationInfo.NumericalIssue
+
+# A zero matrix has a zero solution, which solves the zero right hand sides
+# only
+for zero_solver in [
+    nanoeigenpy.MixedPrecisionPartialPivLU(np.zeros((dim, dim))),
+    nanoeigenpy.MixedPrecisionLLT(np.zeros((dim, dim))),
+]:
+    x_est = zero_solver.solve(np.zeros(dim))
+    assert zero_solver.info() == nanoeigenpy.ComputationInfo.Success
+    assert not zero_solver.usedFallback()
+    assert np.array_equal(x_est, np.zeros(dim))
+    assert zero_solver.error() == 0.0
+    x_est = zero_solver.solve(b)
+    assert zero_solver.info() == nanoeigenpy.ComputationInfo.NumericalIssue
+    assert not zero_solver.usedFallback()
+    assert np.array_equal(x_est, np.zeros(dim))
+    assert zero_solver.error() == np.max(np.abs(b))
+
+decomp1 = nanoeigenpy.MixedPrecisionPartialPivLU()
+decomp2 = nanoeigenpy.MixedPrecisionPartialPivLU()
+id1 = decomp1.id()
+id2 = decomp2.id()
+assert id1 != id2
+assert id1 == decomp1.id()
+assert id2 == decomp2.id()
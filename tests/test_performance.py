@@ -0,0 +1,155 @@
+"""Performance regression tests.
+
+Each metric is a time relative to a reference operation of numpy or scipy
+measured on the same machine. The test fails when a metric exceeds its
+baseline times the tolerance of performance_metrics.json.
+
+The baselines are not checked in: they are the values of the metrics measured
+on the machine running the test, with a reference build of the module, and
+are read from the JSON file named by NANOEIGENPY_PERFORMANCE_BASELINES. Set
+NANOEIGENPY_UPDATE_PERFORMANCE_BASELINES=1 to record the measured values in
+that file instead of checking them. The CI records them with the base
+revision of the change, then checks the change on the same runner.
+"""
+
+import nanoeigenpy
+import numpy as np
+import scipy.linalg
+import scipy.sparse as spa
+import json
+import os
+import subprocess
+import sys
+import timeit
+
+METRICS_FILE = os.path.join(
+    os.path.dirname(os.path.abspath(__file__)), "performance_metrics.json"
+)
+BASELINES_FILE = os.environ.get("NANOEIGENPY_PERFORMANCE_BASELINES")
+UPDATE = os.environ.get("NANOEIGENPY_UPDATE_PERFORMANCE_BASELINES") == "1"
+if not BASELINES_FILE:
+    raise RuntimeError(
+        "Set NANOEIGENPY_PERFORMANCE_BASELINES to the file of the baselines, "
+        "and record them with NANOEIGENPY_UPDATE_PERFORMANCE_BASELINES=1 and a "
+        "reference build of the module."
+    )
+
+
+def time_call(f, number=1000, repeat=7):
+    """Returns the best time of a call to f over several runs."""
+    return min(timeit.repeat(f, number=number, repeat=repeat)) / number
+
+
+def import_time(module, repeat=7):
+    """Returns the best time to import module in a new interpreter."""
+    code = (
+        "import time\n"
+        "start = time.perf_counter()\n"
+        f"import {module}\n"
+        "print(time.perf_counter() - start)"
+    )
+    times = []
+    for _ in range(repeat):
+        output = subprocess.run(
+            [sys.executable, "-c", code],
+            check=True,
+            capture_output=True,
+            text=True,
+        ).stdout
+        times.append(float(output))
+    return min(times)
+
+
+rng = np.random.default_rng(0)
+
+A3 = rng.random((3, 3))
+A3 = A3 @ A3.T + 3.0 * np.eye(3)
+b3 = rng.random(3)
+reference_call = time_call(lambda: np.dot(A3, b3), number=10000)
+
+
+def measure_import_time():
+    return import_time("nanoeigenpy") / import_time("numpy")
+
+
+def measure_llt_solve_overhead():
+    llt = nanoeigenpy.LLT(A3)
+    return time_call(lambda: llt.solve(b3), number=10000) / reference_call
+
+
+def measure_quaternion_mul_overhead():
+    q1 = nanoeigenpy.Quaternion(rng.random(4))
+    q2 = nanoeigenpy.Quaternion(rng.random(4))
+    return time_call(lambda: q1 * q2, number=10000) / reference_call
+
+
+def measure_llt_batched_solve():
+    dim = 50
+    A = rng.random((dim, dim))
+    A = A @ A.T + dim * np.eye(dim)
+    B = np.asfortranarray(rng.random((dim, 2000)))
+    llt = nanoeigenpy.LLT(A)
+    cho = scipy.linalg.cho_factor(A, lower=True)
+    return time_call(lambda: llt.solve(B), number=20) / time_call(
+        lambda: scipy.linalg.cho_solve(cho, B, check_finite=False), number=20
+    )
+
+
+def measure_spmm_throughput():
+    dim = 2000
+    A = spa.random(dim, dim, density=0.005, random_state=rng, format="csr")
+    X = rng.random((dim, 32))
+    out = np.empty((dim, 32))
+    return time_call(lambda: nanoeigenpy.spmm(A, X, out=out), number=20) / (
+        time_call(lambda: A @ X, number=20)
+    )
+
+
+metrics = {
+    "import_time": measure_import_time,
+    "llt_solve_overhead": measure_llt_solve_overhead,
+    "quaternion_mul_overhead": measure_quaternion_mul_overhead,
+    "llt_batched_solve": measure_llt_batched_solve,
+    "spmm_throughput": measure_spmm_throughput,
+}
+
+with open(METRICS_FILE) as f:
+    tolerances = json.load(f)
+assert set(tolerances) == set(metrics)
+
+if UPDATE:
+    baselines = {}
+    for name, measure in metrics.items():
+        try:
+            baselines[name] = round(measure(), 3)
+        except AttributeError as e:
+            # The reference build predates the API of a new metric.
+            print(f"{name}: not recorded ({e})")
+            continue
+        print(f"{name:<28}{baselines[name]:>10.3f}")
+    with open(BASELINES_FILE, "w") as f:
+        json.dump(baselines, f, indent=2)
+        f.write("\n")
+    print(f"Recorded the baselines in {BASELINES_FILE}")
+    sys.exit(0)
+
+with open(BASELINES_FILE) as f:
+    baselines = json.load(f)
+
+regressions = []
+print(f"{'metric':<28}{'value':>10}{'baseline':>10}{'limit':>10}")
+for name, measure in metrics.items():
+    value = measure()
+    if name not in baselines:
+        print(f"{name:<28}{value:>10.3f}{'-':>10}{'-':>10}")
+        continue
+    limit = baselines[name] * tolerances[name]["tolerance"]
+    print(f"{name:<28}{value:>10.3f}{baselines[name]:>10.3f}{limit:>10.3f}")
+    if value > limit:
+        regressions.append(
+            f"{name}: {value:.3f} > {limit:.3f} "
+            f"({tolerances[name]['description']})"
+        )
+
+if regressions:
+    raise AssertionError("Performance regressions:\n  " + "\n  ".join(regressions))
@@ -11,6 +11,26 @@ householder_qr = nanoeigenpy.HouseholderQR()
 householder_qr = nanoeigenpy.HouseholderQR(rows, cols)
 householder_qr = nanoeigenpy.HouseholderQR(A)
 
+# The factors are read-only views of the decomposition, unless copy=True
+QR = householder_qr.matrixQR(copy=True)
+assert QR.shape == (rows, cols)
+assert QR.flags.writeable
+QR_view = householder_qr.matrixQR()
+assert not QR_view.flags.writeable
+assert np.shares_memory(QR_view, householder_qr.matrixQR())
+assert not np.shares_memory(QR, QR_view)
+assert np.array_equal(QR, QR_view)
+
+# The views keep their factor when a compute resizes the decomposition,
+# which stores the new factor elsewhere
+householder_qr.compute(rng.random((2 * rows, cols + 1)))
+assert householder_qr.matrixQR().shape == (2 * rows, cols + 1)
+assert not np.shares_memory(QR_view, householder_qr.matrixQR())
+assert np.array_equal(QR_view, QR)
+householder_qr.compute(A)
+assert np.array_equal(householder_qr.matrixQR(), QR)
+del QR_view
+
 householder_qr_eye = nanoeigenpy.HouseholderQR(np.eye(rows, rows))
 X = rng.random((rows, 20))
 assert householder_qr_eye.absDeterminant() == 1.0
@@ -55,6 +75,10 @@ assert fullpiv_householder_qr.dimensionOfKernel() == 0
 
 colpiv_householder_qr = nanoeigenpy.ColPivHouseholderQR(A)
 assert colpiv_householder_qr.info() == nanoeigenpy.ComputationInfo.Success
+R = colpiv_householder_qr.matrixR()
+assert not R.flags.writeable
+assert np.shares_memory(R, colpiv_householder_qr.matrixQR())
+assert not np.shares_memory(R, colpiv_householder_qr.matrixQR(copy=True))
 
 colpiv_householder_qr = nanoeigenpy.ColPivHouseholderQR(np.eye(rows, rows))
 X = rng.random((rows, 20))
@@ -0,0 +1,66 @@
+import nanoeigenpy
+import numpy as np
+
+rows = 300
+cols = 120
+rank = 10
+rng = np.random.default_rng()
+
+# Matrix with a fast decaying spectrum
+U, _ = np.linalg.qr(rng.standard_normal((rows, cols)))
+V, _ = np.linalg.qr(rng.standard_normal((cols, cols)))
+S = np.logspace(0, -10, cols)
+A = U @ np.diag(S) @ V.T
+
+rsvd = nanoeigenpy.RandomizedSVD(A, rank)
+assert rsvd.info() == nanoeigenpy.ComputationInfo.Success
+assert rsvd.rows() == rows
+assert rsvd.cols() == cols
+assert rsvd.computedRank() == rank
+
+singular_values = rsvd.singularValues()
+matrixU = rsvd.matrixU()
+matrixV = rsvd.matrixV()
+assert singular_values.shape == (rank,)
+assert matrixU.shape == (rows, rank)
+assert matrixV.shape == (cols, rank)
+assert all(singular_values[i] >= singular_values[i + 1] for i in range(rank - 1))
+assert np.allclose(singular_values, S[:rank], rtol=1e-6)
+assert nanoeigenpy.is_approx(matrixU.T @ matrixU, np.eye(rank))
+assert nanoeigenpy.is_approx(matrixV.T @ matrixV, np.eye(rank))
+
+# The truncation error is close to the optimal one, given by S[rank]
+A_k = matrixU @ np.diag(singular_values) @ matrixV.T
+assert np.linalg.norm(A - A_k, 2) <= 10 * S[rank]
+
+# Parameters
+rsvd = nanoeigenpy.RandomizedSVD()
+rsvd.setOversampling(5).setPowerIterations(3).setSeed(42)
+assert rsvd.oversampling() == 5
+assert rsvd.powerIterations() == 3
+assert rsvd.seed() == 42
+rsvd.compute(A, rank)
+first = rsvd.singularValues().copy()
+rsvd.compute(A, rank)
+assert np.array_equal(first, rsvd.singularValues())
+
+rsvd = nanoeigenpy.RandomizedSVD(A.T, rank, oversampling=20, powerIterations=0, seed=1)
+assert rsvd.matrixU().shape == (cols, rank)
+assert np.allclose(rsvd.singularValues(), S[:rank], rtol=1e-3)
+
+# The rank is clamped to the dimensions of the matrix
+rsvd.compute(A, 2 * cols)
+assert rsvd.computedRank() == cols
+assert np.allclose(rsvd.singularValues(), S, rtol=1e-6, atol=1e-12)
+
+nanoeigenpy.setNbThreads(2)
+assert nanoeigenpy.nbThreads() >= 1
+nanoeigenpy.setNbThreads(0)
+
+decomp1 = nanoeigenpy.RandomizedSVD()
+decomp2 = nanoeigenpy.RandomizedSVD()
+id1 = decomp1.id()
+id2 = decomp2.id()
+assert id1 != id2
+assert id1 == decomp1.id()
+assert id2 == decomp2.id()
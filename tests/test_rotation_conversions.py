@@ -0,0 +1,81 @@
+import nanoeigenpy
+import numpy as np
+
+rng = np.random.default_rng()
+n = 10000
+
+q = rng.standard_normal((n, 4))
+q /= np.linalg.norm(q, axis=1)[:, None]
+# Rotations of angle close to pi, for which w is close to zero
+q[:100, 3] = 1e-12
+q /= np.linalg.norm(q, axis=1)[:, None]
+q[q[:, 3] < 0] *= -1
+
+# Quaternions <-> matrices
+R = nanoeigenpy.quaternionsToMatrices(q)
+assert R.shape == (n, 3, 3)
+for k in range(0, n, 97):
+    assert nanoeigenpy.is_approx(R[k], nanoeigenpy.Quaternion(q[k]).matrix())
+assert np.allclose(R @ R.transpose(0, 2, 1), np.eye(3))
+assert np.allclose(np.linalg.det(R), 1.0)
+
+q2 = nanoeigenpy.matricesToQuaternions(R)
+assert q2.shape == (n, 4)
+assert np.all(q2[:, 3] >= 0)
+# Up to the sign of the rotations of angle pi
+assert np.allclose(np.abs(np.sum(q * q2, axis=1)), 1.0)
+assert np.allclose(q2[100:], q[100:])
+
+# Quaternions are normalized
+assert np.allclose(nanoeigenpy.quaternionsToMatrices(3.0 * q), R)
+
+# Angle-axis
+v = nanoeigenpy.matricesToAngleAxis(R)
+assert v.shape == (n, 3)
+angles = np.linalg.norm(v, axis=1)
+assert np.all(angles <= np.pi + 1e-12)
+for k in range(0, n, 97):
+    aa = nanoeigenpy.AngleAxis(nanoeigenpy.Quaternion(q[k]))
+    assert np.isclose(angles[k], aa.angle)
+    assert nanoeigenpy.is_approx(v[k], aa.angle * aa.axis)
+assert np.allclose(nanoeigenpy.angleAxisToMatrices(v), R)
+assert np.allclose(nanoeigenpy.quaternionsToAngleAxis(q), v)
+q3 = nanoeigenpy.angleAxisToQuaternions(v)
+assert np.allclose(np.abs(np.sum(q * q3, axis=1)), 1.0)
+
+# The identity
+zero = np.zeros((1, 3))
+assert np.allclose(nanoeigenpy.angleAxisToMatrices(zero), np.eye(3))
+assert np.allclose(nanoeigenpy.angleAxisToQuaternions(zero), [[0, 0, 0, 1]])
+assert np.allclose(nanoeigenpy.matricesToAngleAxis(np.eye(3)[None]), zero)
+
+# Euler angles
+for axes in [(2, 1, 0), (0, 1, 2), (2, 0, 2)]:
+    e = nanoeigenpy.matricesToEulerAngles(R, *axes)
+    assert e.shape == (n, 3)
+    assert np.all((e[:, 0] >= 0) & (e[:, 0] <= np.pi))
+    assert np.allclose(nanoeigenpy.eulerAnglesToMatrices(e, *axes), R)
+yaw, pitch, roll = 0.3, -0.2, 0.1
+e = np.array([[yaw, pitch, roll]])
+Rz = nanoeigenpy.AngleAxis(yaw, np.array([0.0, 0.0, 1.0])).matrix()
+Ry = nanoeigenpy.AngleAxis(pitch, np.array([0.0, 1.0, 0.0])).matrix()
+Rx = nanoeigenpy.AngleAxis(roll, np.array([1.0, 0.0, 0.0])).matrix()
+assert np.allclose(nanoeigenpy.eulerAnglesToMatrices(e)[0], Rz @ Ry @ Rx)
+assert np.allclose(nanoeigenpy.matricesToEulerAngles(Rz @ Ry @ Rx), e)
+try:
+    nanoeigenpy.eulerAnglesToMatrices(e, 0, 0, 1)
+    assert False, "the axes a0 and a1 must differ"
+except ValueError:
+    pass
+
+# Non-contiguous inputs and empty batches
+assert np.allclose(
+    nanoeigenpy.quaternionsToMatrices(np.asfortranarray(q[::2])), R[::2]
+)
+assert nanoeigenpy.matricesToQuaternions(np.zeros((0, 3, 3))).shape == (0, 4)
+
+# Large batches use the same kernels on several threads
+big = np.tile(q, (20, 1))
+assert np.array_equal(
+    nanoeigenpy.quaternionsToMatrices(big), np.tile(R, (20, 1, 1))
+)
@@ -0,0 +1,34 @@
+import nanoeigenpy
+import numpy as np
+import scipy.sparse as spa
+
+rng = np.random.default_rng()
+
+dim = 150
+A_fac = spa.random(dim, dim, density=0.02, random_state=rng)
+A = (A_fac.T @ A_fac + spa.diags(5.0 + rng.random(dim))).tocsc()
+A.sort_indices()
+A_inv = np.linalg.inv(A.toarray())
+
+for cls in [
+    nanoeigenpy.SimplicialLLT,
+    nanoeigenpy.SimplicialLDLT,
+    nanoeigenpy.NaturalSimplicialLDLT,
+]:
+    solver = cls(A)
+    assert solver.info() == nanoeigenpy.ComputationInfo.Success
+
+    d = solver.inverseDiagonal()
+    assert nanoeigenpy.is_approx(d, np.diag(A_inv))
+
+    Z = solver.selectedInversion()
+    assert isinstance(Z, spa.csc_matrix)
+    assert Z.has_sorted_indices
+    assert (Z != Z.T).nnz == 0
+    Z_coo = Z.tocoo()
+    assert np.allclose(Z_coo.data, A_inv[Z_coo.row, Z_coo.col])
+
+    # The pattern of the factor includes the one of A
+    pattern = set(zip(Z_coo.row, Z_coo.col))
+    A_coo = A.tocoo()
+    assert all((i, j) in pattern for i, j in zip(A_coo.row, A_coo.col))
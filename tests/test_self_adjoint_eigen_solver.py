@@ -18,3 +18,17 @@ AdotV = A @ V
 VdotD = V @ np.diag(D)
 
 assert nanoeigenpy.is_approx(AdotV, VdotD, 1e-6)
+
+# The eigenpairs are read-only views of the solver, unless copy=True
+assert not V.flags.writeable and not D.flags.writeable
+assert np.shares_memory(V, es.eigenvectors())
+V_copy = es.eigenvectors(copy=True)
+assert V_copy.flags.writeable
+assert not np.shares_memory(V, V_copy)
+
+# The views keep their eigenpairs when a compute resizes the solver
+es.compute(np.eye(dim // 2))
+assert es.eigenvectors().shape == (dim // 2, dim // 2)
+assert not np.shares_memory(V, es.eigenvectors())
+assert np.array_equal(V, V_copy)
+assert nanoeigenpy.is_approx(A @ V, V @ np.diag(D), 1e-6)
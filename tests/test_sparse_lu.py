@@ -61,3 +61,17 @@ x_reconstructed = np.zeros(dim)
 x_reconstructed[P_cols_indices] = y
 
 assert nanoeigenpy.is_approx(x_reconstructed, x_true, 1e-6)
+
+L_sparse = L.toSparse()
+U_sparse = U.toSparse()
+assert isinstance(L_sparse, spa.csc_matrix)
+assert isinstance(U_sparse, spa.csc_matrix)
+assert L_sparse.has_sorted_indices
+assert U_sparse.has_sorted_indices
+assert L_sparse.nnz == splu.nnzL()
+assert U_sparse.nnz == splu.nnzU()
+assert spa.triu(L_sparse, 1).nnz == 0
+assert np.all(L_sparse.diagonal() == 1.0)
+assert spa.tril(U_sparse, -1).nnz == 0
+assert nanoeigenpy.is_approx(L_sparse @ z, b_permuted)
+assert nanoeigenpy.is_approx(U_sparse @ y, z)
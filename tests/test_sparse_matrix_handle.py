@@ -0,0 +1,113 @@
+import nanoeigenpy
+import numpy as np
+import scipy.sparse as spa
+
+rng = np.random.default_rng()
+
+dim = 100
+B = spa.random(dim, dim, density=0.05, format="csc", random_state=rng)
+A = (B @ B.T + dim * spa.identity(dim)).tocsc()
+A.sort_indices()
+
+handle = nanoeigenpy.SparseMatrix(A.data, A.indices, A.indptr, A.shape)
+assert handle.shape == A.shape
+assert handle.rows() == dim
+assert handle.cols() == dim
+assert handle.nonZeros() == A.nnz
+assert np.array_equal(handle.indices, A.indices)
+assert np.array_equal(handle.indptr, A.indptr)
+assert np.allclose(handle.values, A.data)
+assert abs(handle.toScipy() - A).max() == 0.0
+
+handle_copy = nanoeigenpy.SparseMatrix(A)
+assert np.array_equal(handle_copy.values, handle.values)
+
+x = rng.random(dim)
+assert nanoeigenpy.is_approx(handle @ x, A @ x)
+X = rng.random((dim, 5))
+assert nanoeigenpy.is_approx(handle @ X, A @ X)
+
+b = rng.random(dim)
+llt = nanoeigenpy.SimplicialLLT(handle)
+assert llt.info() == nanoeigenpy.ComputationInfo.Success
+assert nanoeigenpy.is_approx(A @ llt.solve(b), b)
+
+lu = nanoeigenpy.SparseLU()
+lu.compute(handle)
+assert nanoeigenpy.is_approx(A @ lu.solve(b), b)
+
+Id = nanoeigenpy.SparseMatrix(spa.identity(dim, format="csc"))
+X_sparse = llt.solve(Id)
+assert abs(A @ X_sparse - spa.identity(dim)).max() < 1e-10
+
+# The values are updated in place and refactorized with the same pattern
+ldlt = nanoeigenpy.SimplicialLDLT()
+ldlt.analyzePattern(handle)
+ldlt.factorize(handle)
+handle.values[:] *= 2.0
+ldlt.factorize(handle)
+assert nanoeigenpy.is_approx(2.0 * A @ ldlt.solve(b), b)
+assert nanoeigenpy.is_approx(handle @ x, 2.0 * A @ x)
+
+try:
+    handle.indices[0] = 1
+    assert False
+except ValueError:
+    pass
+
+try:
+    handle @ rng.random(dim + 1)
+    assert False
+except ValueError:
+    pass
+
+try:
+    nanoeigenpy.SparseMatrix(A.data, A.indices, A.indptr[:-1], A.shape)
+    assert False
+except ValueError:
+    pass
+
+try:
+    nanoeigenpy.SparseMatrix(A.data, A.indices, A.indptr, (dim - 1, dim))
+    assert False
+except ValueError:
+    pass
+
+# Unsorted, repeated or out of range row indices are rejected
+col = np.argmax(np.diff(A.indptr))
+k = A.indptr[col]
+assert A.indptr[col + 1] - k >= 2
+unsorted = A.indices.copy()
+unsorted[k], unsorted[k + 1] = unsorted[k + 1], unsorted[k]
+repeated = A.indices.copy()
+repeated[k + 1] = repeated[k]
+out_of_range = A.indices.copy()
+out_of_range[-1] = dim
+for indices in [unsorted, repeated, out_of_range]:
+    try:
+        nanoeigenpy.SparseMatrix(A.data, indices, A.indptr, A.shape)
+        assert False
+    except ValueError:
+        pass
+
+# The other sparse APIs accept a SparseMatrix without converting it
+X = rng.random((dim, 3))
+assert nanoeigenpy.is_approx(nanoeigenpy.spmv(handle, x), 2.0 * A @ x)
+assert nanoeigenpy.is_approx(nanoeigenpy.spmm(handle, X, 0.5), A @ X)
+Y = np.zeros((dim, 3))
+nanoeigenpy.spmm(handle, X, out=Y)
+assert nanoeigenpy.is_approx(Y, 2.0 * A @ X)
+
+ordering = nanoeigenpy.OrderingMethod.NestedDissection
+stats = nanoeigenpy.choleskyFillStatistics(handle, ordering)
+assert stats.nonZerosL == nanoeigenpy.choleskyFillStatistics(A, ordering).nonZerosL
+llt = nanoeigenpy.SimplicialLLT(handle, ordering=ordering)
+assert llt.matrixL().nnz == stats.nonZerosL
+llt.compute(handle, ordering=nanoeigenpy.OrderingMethod.Natural)
+assert nanoeigenpy.is_approx(2.0 * A @ llt.solve(b), b)
+
+D = nanoeigenpy.SparseMatrix(spa.diags(np.arange(1.0, dim + 1.0), format="csc"))
+eig = nanoeigenpy.LanczosEigenSolver()
+eig.computeShiftInvert(D, 2, 0.0)
+assert eig.info() == nanoeigenpy.ComputationInfo.Success
+assert np.allclose(eig.eigenvalues(), [1.0, 2.0])
@@ -0,0 +1,91 @@
+import nanoeigenpy
+import numpy as np
+import scipy.sparse as spa
+
+rng = np.random.default_rng()
+
+# 3D Laplacian on a n x n x n grid
+n = 10
+lap = spa.diags([-1.0, 2.0, -1.0], [-1, 0, 1], shape=(n, n))
+eye = spa.identity(n)
+A = (
+    spa.kron(spa.kron(lap, eye), eye)
+    + spa.kron(spa.kron(eye, lap), eye)
+    + spa.kron(spa.kron(eye, eye), lap)
+).tocsc()
+dim = A.shape[0]
+
+stats = {
+    ordering: nanoeigenpy.choleskyFillStatistics(A, ordering)
+    for ordering in [
+        nanoeigenpy.OrderingMethod.Natural,
+        nanoeigenpy.OrderingMethod.AMD,
+        nanoeigenpy.OrderingMethod.COLAMD,
+        nanoeigenpy.OrderingMethod.NestedDissection,
+    ]
+}
+natural = stats[nanoeigenpy.OrderingMethod.Natural]
+amd = stats[nanoeigenpy.OrderingMethod.AMD]
+nested_dissection = stats[nanoeigenpy.OrderingMethod.NestedDissection]
+assert natural.treeHeight == dim
+assert amd.nonZerosL < natural.nonZerosL
+assert nested_dissection.nonZerosL < natural.nonZerosL
+assert nested_dissection.flops < amd.flops
+
+# The predicted fill matches the factorizations
+llt = nanoeigenpy.SimplicialLLT(A)
+assert llt.matrixL().nnz == amd.nonZerosL
+llt = nanoeigenpy.SimplicialLLT(
+    A, ordering=nanoeigenpy.OrderingMethod.NestedDissection
+)
+assert llt.matrixL().nnz == nested_dissection.nonZerosL
+llt = nanoeigenpy.SupernodalLLT(A, ordering=nanoeigenpy.OrderingMethod.Natural)
+assert llt.nonZerosL() == natural.nonZerosL
+
+# The ordering applies to the analysis, which factorize() reuses
+llt = nanoeigenpy.SimplicialLLT()
+llt.analyzePattern(A, ordering=nanoeigenpy.OrderingMethod.NestedDissection)
+llt.factorize(A)
+assert llt.matrixL().nnz == nested_dissection.nonZerosL
+llt.compute(A)
+assert llt.matrixL().nnz == amd.nonZerosL
+
+# The asynchronous factorizations use the ordering on the thread pool
+llt = nanoeigenpy.SimplicialLLT()
+llt.computeAsync(A, ordering=nanoeigenpy.OrderingMethod.NestedDissection).result()
+assert llt.matrixL().nnz == nested_dissection.nonZerosL
+llt.computeAsync(A).result()
+assert llt.matrixL().nnz == amd.nonZerosL
+llt = nanoeigenpy.SupernodalLLT()
+llt.computeAsync(A, ordering=nanoeigenpy.OrderingMethod.Natural).result()
+assert llt.nonZerosL() == natural.nonZerosL
+
+X = rng.random((dim, 5))
+B = A @ X
+for solver in [
+    nanoeigenpy.SimplicialLDLT,
+    nanoeigenpy.SimplicialLLT,
+    nanoeigenpy.SupernodalLLT,
+    nanoeigenpy.SparseLU,
+    nanoeigenpy.SparseQR,
+]:
+    for ordering in stats:
+        dec = solver(A, ordering=ordering)
+        assert dec.info() == nanoeigenpy.ComputationInfo.Success
+        assert nanoeigenpy.is_approx(X, dec.solve(B))
+        dec = solver()
+        dec.compute(A, ordering)
+        assert nanoeigenpy.is_approx(X, dec.solve(B))
+
+# Least squares with a rectangular matrix
+C = spa.random(3 * dim, dim, density=0.01, random_state=rng) + spa.eye(3 * dim, dim)
+C = C.tocsc()
+qr = nanoeigenpy.SparseQR(C, ordering=nanoeigenpy.OrderingMethod.NestedDissection)
+assert qr.info() == nanoeigenpy.ComputationInfo.Success
+x = rng.random(dim)
+assert nanoeigenpy.is_approx(x, qr.solve(C @ x))
+try:
+    nanoeigenpy.SparseQR(C, ordering=nanoeigenpy.OrderingMethod.AMD)
+    assert False, "AMD requires a square matrix"
+except ValueError:
+    pass
@@ -0,0 +1,40 @@
+import nanoeigenpy
+import numpy as np
+import scipy.sparse as spa
+
+rng = np.random.default_rng()
+
+rows, cols = 300, 200
+A = spa.random(rows, cols, density=0.05, format="csr", random_state=rng)
+
+x = rng.random(cols)
+assert nanoeigenpy.is_approx(nanoeigenpy.spmv(A, x), A @ x)
+assert nanoeigenpy.is_approx(nanoeigenpy.spmv(A, x, 2.0), 2.0 * A @ x)
+
+y = rng.random(rows)
+y_ref = 2.0 * A @ x + 0.5 * y
+ret = nanoeigenpy.spmv(A, x, 2.0, 0.5, out=y)
+assert ret is None
+assert nanoeigenpy.is_approx(y, y_ref)
+
+# beta = 0 does not read out
+y[:] = np.nan
+nanoeigenpy.spmv(A, x, out=y)
+assert nanoeigenpy.is_approx(y, A @ x)
+
+X = rng.random((cols, 8))
+assert nanoeigenpy.is_approx(nanoeigenpy.spmm(A, X), A @ X)
+
+Y = rng.random((rows, 8))
+Y_ref = -1.0 * A @ X + 2.0 * Y
+nanoeigenpy.spmm(A, X, alpha=-1.0, beta=2.0, out=Y)
+assert nanoeigenpy.is_approx(Y, Y_ref)
+
+# A CSC matrix is converted to CSR
+assert nanoeigenpy.is_approx(nanoeigenpy.spmv(A.tocsc(), x), A @ x)
+
+try:
+    nanoeigenpy.spmv(A, x, out=np.zeros(rows + 1))
+    assert False
+except ValueError:
+    pass
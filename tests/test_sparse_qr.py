@@ -71,3 +71,8 @@ A_permuted = A_dense[:, P_indices]
 QtAP = Qt @ A_permuted
 R_dense = spqr.matrixR().toarray()
 assert nanoeigenpy.is_approx(QtAP, R_dense)
+
+Q_sparse = Q.toSparse()
+assert isinstance(Q_sparse, spa.csc_matrix)
+assert nanoeigenpy.is_approx(Q_sparse.toarray(), Q @ np.eye(dim))
+assert nanoeigenpy.is_approx(Q_sparse @ R_dense, A_permuted)
@@ -0,0 +1,67 @@
+import nanoeigenpy
+import numpy as np
+import scipy.sparse as spa
+
+rng = np.random.default_rng()
+
+dim = 200
+A_fac = spa.random(dim, dim, density=0.02, random_state=rng)
+A = (A_fac.T @ A_fac + spa.diags(10.0 + rng.random(dim))).tocsc()
+A.sort_indices()
+
+# Block diagonal matrix: the solutions are sparse
+blocks = [A[:50, :50], A[50:120, 50:120], A[120:, 120:]]
+A_block = spa.block_diag(blocks, format="csc")
+A_block.sort_indices()
+
+B = spa.csc_matrix((np.ones(4), ([3, 60, 61, 150], [0, 1, 1, 3])), shape=(dim, 4))
+
+for cls in [nanoeigenpy.SimplicialLLT, nanoeigenpy.SimplicialLDLT]:
+    for mat in [A, A_block]:
+        solver = cls(mat)
+        assert solver.info() == nanoeigenpy.ComputationInfo.Success
+
+        X = solver.solve(B)
+        assert isinstance(X, spa.csc_matrix)
+        assert X.has_sorted_indices
+        assert nanoeigenpy.is_approx(mat @ X.toarray(), B.toarray())
+
+        # L^-1 P B gives B^T A^-1 B
+        Y = solver.solveLower(B)
+        assert isinstance(Y, spa.csc_matrix)
+        if cls is nanoeigenpy.SimplicialLLT:
+            S = (Y.T @ Y).toarray()
+        else:
+            S = (Y.T @ spa.diags(1.0 / solver.vectorD()) @ Y).toarray()
+        assert nanoeigenpy.is_approx(S, B.T @ X.toarray())
+
+    # Only the blocks of the nonzeros of B are touched
+    X = cls(A_block).solve(B)
+    assert X[:, 0].nnz <= 50
+    assert X[:50, 1].nnz == 0
+    assert X[:120, 3].nnz == 0
+    assert X[:, 2].nnz == 0
+
+for mat in [A, A_block]:
+    lu = nanoeigenpy.SparseLU(mat)
+    assert lu.info() == nanoeigenpy.ComputationInfo.Success
+
+    X = lu.solve(B)
+    assert isinstance(X, spa.csc_matrix)
+    assert X.has_sorted_indices
+    assert nanoeigenpy.is_approx(mat @ X.toarray(), B.toarray())
+
+    Y = lu.solveLower(B)
+    L = lu.matrixL().toSparse()
+    B_permuted = B.toarray()[lu.rowsPermutation().indices().argsort()]
+    assert nanoeigenpy.is_approx(L @ Y.toarray(), B_permuted)
+
+X = nanoeigenpy.SparseLU(A_block).solve(B)
+assert X[:50, 1].nnz == 0
+assert X[:120, 3].nnz == 0
+
+try:
+    nanoeigenpy.SimplicialLLT(A).solve(spa.identity(dim + 1, format="csc"))
+    assert False
+except ValueError:
+    pass
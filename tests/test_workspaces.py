@@ -0,0 +1,87 @@
+import nanoeigenpy
+import numpy as np
+
+dim = 60
+rng = np.random.default_rng()
+A = rng.random((dim, dim))
+options = (
+    nanoeigenpy.DecompositionOptions.ComputeThinU.value
+    | nanoeigenpy.DecompositionOptions.ComputeThinV.value
+)
+
+assert not nanoeigenpy.workspacesEnabled()
+
+if not nanoeigenpy.workspacesAvailable():
+    try:
+        nanoeigenpy.setWorkspacesEnabled(True)
+        assert False, "the workspaces should not be available"
+    except RuntimeError:
+        pass
+    assert not nanoeigenpy.workspacesEnabled()
+    assert nanoeigenpy.workspaceBytes() == 0
+else:
+    svd_ref = nanoeigenpy.BDCSVD(A, options)
+    qr_ref = nanoeigenpy.ColPivHouseholderQR(A)
+    schur_ref = nanoeigenpy.RealSchur(A)
+
+    nanoeigenpy.setWorkspacesEnabled(True)
+    assert nanoeigenpy.workspacesEnabled()
+
+    svd = nanoeigenpy.BDCSVD(dim, dim, options)
+    qr = nanoeigenpy.ColPivHouseholderQR()
+    schur = nanoeigenpy.RealSchur(dim)
+    for _ in range(3):
+        svd.compute(A)
+        qr.compute(A)
+        schur.compute(A)
+        # The results do not depend on the workspace
+        assert np.allclose(svd.singularValues(), svd_ref.singularValues())
+        assert np.allclose(svd.matrixU(), svd_ref.matrixU())
+        assert np.allclose(qr.matrixQR(), qr_ref.matrixQR())
+        assert np.allclose(schur.matrixT(), schur_ref.matrixT())
+        assert np.allclose(schur.matrixU(), schur_ref.matrixU())
+    assert nanoeigenpy.workspaceBytes() > 0
+
+    # Another size
+    B = rng.random((dim + 5, dim + 5))
+    svd.compute(B)
+    assert nanoeigenpy.is_approx(
+        svd.matrixU() @ np.diag(svd.singularValues()) @ svd.matrixV().T, B
+    )
+
+    # Repeated computations of the same size do not allocate
+    if nanoeigenpy.allocationTrackingAvailable():
+        nanoeigenpy.setStatsEnabled(True, track_allocations=True)
+        svd.compute(A)
+        qr.compute(A)
+        schur.compute(A)
+        nanoeigenpy.resetStats()
+        for _ in range(3):
+            svd.compute(A)
+            qr.compute(A)
+            schur.compute(A)
+        stats = nanoeigenpy.stats()
+        for name in ("BDCSVD", "ColPivHouseholderQR", "RealSchur"):
+            assert stats[name + ".compute"]["calls"] == 3
+            assert stats[name + ".compute"]["allocations"] == 0
+        nanoeigenpy.setStatsEnabled(False)
+
+    # The workspace keeps at most its limit, and frees the temporaries of the
+    # sizes least recently used first
+    limit = nanoeigenpy.workspaceLimit()
+    kept = nanoeigenpy.workspaceBytes()
+    nanoeigenpy.setWorkspaceLimit(kept)
+    for size in range(dim + 10, dim + 20):
+        svd.compute(rng.random((size, size)))
+        assert nanoeigenpy.workspaceBytes() <= kept
+    nanoeigenpy.setWorkspaceLimit(0)
+    svd.compute(A)
+    assert nanoeigenpy.workspaceBytes() == 0
+    nanoeigenpy.setWorkspaceLimit(limit)
+
+    nanoeigenpy.releaseWorkspace()
+    assert nanoeigenpy.workspaceBytes() == 0
+    nanoeigenpy.setWorkspacesEnabled(False)
+    assert not nanoeigenpy.workspacesEnabled()
+    svd.compute(A)
+    assert nanoeigenpy.workspaceBytes() == 0